@@ -3,14 +3,275 @@
 #include "lengthunit.hpp"
 
 #include <stdexcept>
+#include <cmath>
+#include <climits>
+#include <cstdlib>
 
 /*****************************************************************************/
 
-const long double LengthUnit::METERS_IN_INCH = 0.0254;
-const long double LengthUnit::METERS_IN_FOOT = 0.3048;
+constexpr long double LengthUnit::METERS_IN_INCH;
+constexpr long double LengthUnit::METERS_IN_FOOT;
+constexpr int LengthUnit::INCHES_IN_FOOT;
+constexpr int LengthUnit::MaxFeet;
+const int LengthUnit::MaxStringLength;
 
 /*****************************************************************************/
 
-// TODO ...
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+// Reads decimal digits, returning the first character after them.
+// Leading zeros are not significant; the value keeps the first 18 significant digits
+char const * readDigits ( char const * _p, long long & _value, int & _nSignificantDigits )
+{
+	while ( * _p >= '0' && * _p <= '9' )
+	{
+		if ( _nSignificantDigits || * _p != '0' )
+		{
+			if ( _nSignificantDigits < 18 )
+				_value = _value * 10 + ( * _p - '0' );
+
+			++ _nSignificantDigits;
+		}
+
+		++_p;
+	}
+
+	return _p;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+// Writes a non-negative number, returning the first character after it
+char * writeNumber ( long long _value, char * _p )
+{
+	char digits[ 20 ];
+	int nDigits = 0;
+	do
+	{
+		digits[ nDigits++ ] = static_cast< char >( '0' + _value % 10 );
+		_value /= 10;
+	}
+	while ( _value );
+
+	while ( nDigits )
+		* _p++ = digits[ -- nDigits ];
+
+	return _p;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+// Copies formatted text into a caller buffer, returning its length
+int copyText ( char const * _text, int _length, char * _buffer, int _bufferSize )
+{
+	if ( _length >= _bufferSize )
+		throw std::logic_error( "Buffer too small" );
+
+	for ( int i = 0; i < _length; ++i )
+		_buffer[ i ] = _text[ i ];
+
+	_buffer[ _length ] = '\0';
+	return _length;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+}
+
+/*****************************************************************************/
+
+
+LengthUnit::LengthUnit ( char const * _text )
+{
+	char const * p = _text;
+
+	const bool negative = ( * p == '-' );
+	if ( negative )
+		++p;
+
+	long long whole = 0;
+	int nWholeDigits = 0;
+	char const * wholeEnd = readDigits( p, whole, nWholeDigits );
+	if ( wholeEnd == p )
+		throw std::logic_error( "Bad format" );
+
+	p = wholeEnd;
+
+	if ( * p == '\'' )
+	{
+		long long inches = 0;
+		int nInchesDigits = 0;
+		char const * inchesEnd = readDigits( p + 1, inches, nInchesDigits );
+
+		if ( inchesEnd == p + 1 || * inchesEnd != '"' || * ( inchesEnd + 1 ) || nWholeDigits > 10 || whole > INT_MAX )
+			throw std::logic_error( "Bad format" );
+
+		if ( nInchesDigits > 2 || inches >= INCHES_IN_FOOT )
+			throw std::logic_error( "Inches out of range" );
+
+		if ( whole > MaxFeet )
+			throw std::logic_error( "Feet out of range" );
+
+		// The sign belongs to the feet, and "-0'5\"" would lose it
+		if ( negative && ! whole )
+			throw std::logic_error( "Bad format" );
+
+		const int feet = static_cast< int >( whole );
+		m_meters = englishToMeters( negative ? -feet : feet, static_cast< int >( inches ) );
+		return;
+	}
+
+	long long mantissa = whole;
+	int nDigits = nWholeDigits, nFractionDigits = 0;
+	if ( * p == '.' )
+	{
+		char const * fraction = p + 1;
+		p = readDigits( fraction, mantissa, nDigits );
+		nFractionDigits = static_cast< int >( p - fraction );
+	}
+
+	if ( * p != 'm' || * ( p + 1 ) )
+		throw std::logic_error( "Bad format" );
+
+	static const double s_powersOf10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+		1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	// With up to 15 significant digits and 22 fraction digits, both the mantissa and the power
+	// are exact doubles, and one division gives the nearest double. Longer numbers are left to strtod
+	if ( nDigits > 15 || nFractionDigits > 22 )
+	{
+		m_meters = std::strtod( _text, nullptr );
+		return;
+	}
+
+	m_meters = static_cast< double >( mantissa ) / s_powersOf10[ nFractionDigits ];
+	if ( negative )
+		m_meters = -m_meters;
+}
+
+
+/*****************************************************************************/
+
+
+int LengthUnit::formatMetric ( char * _buffer, int _bufferSize ) const
+{
+	const double cents = std::round( std::fabs( m_meters ) * 100.0 );
+	if ( cents >= 1e15 )
+		throw std::logic_error( "Length out of range" );
+
+	const long long wholeCents = static_cast< long long >( cents );
+
+	char text[ MaxStringLength + 1 ];
+	char * p = text;
+	if ( m_meters < 0.0 && wholeCents )
+		* p++ = '-';
+
+	p = writeNumber( wholeCents / 100, p );
+	* p++ = '.';
+	* p++ = static_cast< char >( '0' + wholeCents / 10 % 10 );
+	* p++ = static_cast< char >( '0' + wholeCents % 10 );
+	* p++ = 'm';
+
+	return copyText( text, static_cast< int >( p - text ), _buffer, _bufferSize );
+}
+
+
+/*****************************************************************************/
+
+
+int LengthUnit::formatEnglish ( char * _buffer, int _bufferSize ) const
+{
+	if ( std::fabs( m_meters ) / static_cast< double >( METERS_IN_INCH ) >= INT_MAX )
+		throw std::logic_error( "Length out of range" );
+
+	const int totalInches = getTotalInches();
+
+	char text[ MaxStringLength + 1 ];
+	char * p = text;
+	if ( m_meters < 0.0 && totalInches >= INCHES_IN_FOOT )
+		* p++ = '-';
+
+	p = writeNumber( totalInches / INCHES_IN_FOOT, p );
+	* p++ = '\'';
+	p = writeNumber( totalInches % INCHES_IN_FOOT, p );
+	* p++ = '"';
+
+	return copyText( text, static_cast< int >( p - text ), _buffer, _bufferSize );
+}
+
+
+/*****************************************************************************/
+
+
+char const * LengthUnit::toMetricString () const
+{
+	static thread_local char s_buffer[ MaxStringLength + 1 ];
+	formatMetric( s_buffer, sizeof( s_buffer ) );
+	return s_buffer;
+}
+
+
+/*****************************************************************************/
+
+
+char const * LengthUnit::toEnglishString () const
+{
+	static thread_local char s_buffer[ MaxStringLength + 1 ];
+	formatEnglish( s_buffer, sizeof( s_buffer ) );
+	return s_buffer;
+}
+
+
+/*****************************************************************************/
+
+
+void LengthUnit::convertToMeters ( int const * _pFeet, int const * _pInches, double * _pMeters, int _count )
+{
+	// Validation is a separate pass, so that the conversion loop has no exits and vectorizes
+	bool inchesValid = true, feetValid = true;
+	for ( int i = 0; i < _count; ++i )
+	{
+		inchesValid &= ( _pInches[ i ] >= 0 ) & ( _pInches[ i ] < INCHES_IN_FOOT );
+		feetValid &= ( _pFeet[ i ] >= -MaxFeet ) & ( _pFeet[ i ] <= MaxFeet );
+	}
+
+	if ( ! inchesValid )
+		throw std::logic_error( "Inches out of range" );
+
+	if ( ! feetValid )
+		throw std::logic_error( "Feet out of range" );
+
+	const double metersInInch = static_cast< double >( METERS_IN_INCH );
+	for ( int i = 0; i < _count; ++i )
+	{
+		const double feet = _pFeet[ i ];
+		const double meters = ( ( feet < 0 ? -feet : feet ) * INCHES_IN_FOOT + _pInches[ i ] ) * metersInInch;
+		_pMeters[ i ] = ( feet < 0 ) ? -meters : meters;
+	}
+}
+
+
+/*****************************************************************************/
+
+
+void LengthUnit::convertToEnglish ( double const * _pMeters, int * _pFeet, int * _pInches, int _count )
+{
+	for ( int i = 0; i < _count; ++i )
+	{
+		const double meters = _pMeters[ i ];
+		const int totalInches = LengthUnit( meters ).getTotalInches();
+		_pFeet[ i ] = ( meters < 0.0 ) ? - ( totalInches / INCHES_IN_FOOT ) : totalInches / INCHES_IN_FOOT;
+		_pInches[ i ] = totalInches % INCHES_IN_FOOT;
+	}
+}
+
 
 /*****************************************************************************/
@@ -5,6 +5,22 @@
 
 /*****************************************************************************/
 
+#include <stdexcept>
+#include <climits>
+
+/*****************************************************************************/
+
+/*
+	A length, kept in meters.
+
+	Construction from numbers, conversion and comparison are constexpr, so that
+	lengths built from literals are computed by the compiler. The functions are
+	written as single expressions, as C++11 constexpr rules require.
+
+	English lengths are whole feet and inches, truncated towards zero,
+	with the sign carried by the feet, so zero feet cannot be negative. Arithmetic is done in double, so that
+	the bulk conversions give the same results as the single ones.
+*/
 
 class LengthUnit
 {
@@ -13,20 +29,277 @@ class LengthUnit
 
 public:
 
-/*------------------------------------------------------------------*/S
+/*------------------------------------------------------------------*/
+
+	constexpr LengthUnit ();
+
+	explicit constexpr LengthUnit ( double _meters );
+
+	constexpr LengthUnit ( int _feet, int _inches );
+
+	explicit LengthUnit ( char const * _text );
+
+/*------------------------------------------------------------------*/
+
+	constexpr long double getAsMeters () const;
+
+	constexpr int getEnglishFeet () const;
+
+	constexpr int getEnglishInches () const;
+
+	void fetchAsEnglish ( int & _feet, int & _inches ) const;
+
+/*------------------------------------------------------------------*/
+
+	// Both return a per-thread buffer, overwritten by the next call
+	char const * toMetricString () const;
+
+	char const * toEnglishString () const;
+
+	// Same text in a caller buffer, null-terminated; return its length
+	int formatMetric ( char * _buffer, int _bufferSize ) const;
+
+	int formatEnglish ( char * _buffer, int _bufferSize ) const;
+
+/*------------------------------------------------------------------*/
+
+	constexpr bool operator == ( LengthUnit _u ) const;
+
+	constexpr bool operator != ( LengthUnit _u ) const;
+
+	constexpr bool operator < ( LengthUnit _u ) const;
+
+	constexpr bool operator <= ( LengthUnit _u ) const;
+
+	constexpr bool operator > ( LengthUnit _u ) const;
+
+	constexpr bool operator >= ( LengthUnit _u ) const;
+
+/*------------------------------------------------------------------*/
+
+	// Arrays of _count lengths; the sign of each English length is carried by its feet
+	static void convertToMeters ( int const * _pFeet, int const * _pInches, double * _pMeters, int _count );
+
+	static void convertToEnglish ( double const * _pMeters, int * _pFeet, int * _pInches, int _count );
+
+/*------------------------------------------------------------------*/
+
+	static constexpr long double METERS_IN_INCH = 0.0254L;
+	static constexpr long double METERS_IN_FOOT = 0.3048L;
+
+	static constexpr int INCHES_IN_FOOT = 12;
+
+	// So that the length in whole inches, up to 11 inches past the feet, fits an int
+	static constexpr int MaxFeet = ( INT_MAX - ( INCHES_IN_FOOT - 1 ) ) / INCHES_IN_FOOT;
+
+	// Longest text of either format, without the terminator
+	static const int MaxStringLength = 24;
+
+/*------------------------------------------------------------------*/
+
+private:
 
-	// TODO ...
-	
 /*------------------------------------------------------------------*/
 
-	static const long double METERS_IN_INCH;
-	static const long double METERS_IN_FOOT;
+	static constexpr double checkInches ( int _inches );
+
+	static constexpr double checkFeet ( int _feet );
+
+	static constexpr double englishToMeters ( int _feet, int _inches );
+
+	// Whole inches in the absolute length; the tolerance absorbs rounding of exact values
+	constexpr int getTotalInches () const;
+
+/*------------------------------------------------------------------*/
+
+	double m_meters;
 
 /*------------------------------------------------------------------*/
 
 };
 
 
+/*****************************************************************************/
+
+
+inline constexpr LengthUnit::LengthUnit ()
+	:	m_meters( 0.0 )
+{
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr LengthUnit::LengthUnit ( double _meters )
+	:	m_meters( _meters )
+{
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr LengthUnit::LengthUnit ( int _feet, int _inches )
+	:	m_meters( englishToMeters( _feet, _inches ) )
+{
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr double LengthUnit::checkInches ( int _inches )
+{
+	return ( _inches >= 0 && _inches < INCHES_IN_FOOT )
+		?	_inches
+		:	throw std::logic_error( "Inches out of range" );
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr double LengthUnit::checkFeet ( int _feet )
+{
+	return ( _feet >= -MaxFeet && _feet <= MaxFeet )
+		?	_feet
+		:	throw std::logic_error( "Feet out of range" );
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr double LengthUnit::englishToMeters ( int _feet, int _inches )
+{
+	return ( _feet < 0 )
+		?	- ( -checkFeet( _feet ) * INCHES_IN_FOOT + checkInches( _inches ) ) * static_cast< double >( METERS_IN_INCH )
+		:	( checkFeet( _feet ) * INCHES_IN_FOOT + checkInches( _inches ) ) * static_cast< double >( METERS_IN_INCH );
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr long double LengthUnit::getAsMeters () const
+{
+	return m_meters;
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr int LengthUnit::getTotalInches () const
+{
+	return static_cast< int >( ( m_meters < 0.0 ? -m_meters : m_meters ) / static_cast< double >( METERS_IN_INCH ) + 1e-6 );
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr int LengthUnit::getEnglishFeet () const
+{
+	return ( m_meters < 0.0 )
+		?	- ( getTotalInches() / INCHES_IN_FOOT )
+		:	getTotalInches() / INCHES_IN_FOOT;
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr int LengthUnit::getEnglishInches () const
+{
+	return getTotalInches() % INCHES_IN_FOOT;
+}
+
+
+/*****************************************************************************/
+
+
+inline void LengthUnit::fetchAsEnglish ( int & _feet, int & _inches ) const
+{
+	const int totalInches = getTotalInches();
+	_feet = ( m_meters < 0.0 ) ? - ( totalInches / INCHES_IN_FOOT ) : totalInches / INCHES_IN_FOOT;
+	_inches = totalInches % INCHES_IN_FOOT;
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr bool LengthUnit::operator == ( LengthUnit _u ) const
+{
+	return m_meters == _u.m_meters;
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr bool LengthUnit::operator != ( LengthUnit _u ) const
+{
+	return m_meters != _u.m_meters;
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr bool LengthUnit::operator < ( LengthUnit _u ) const
+{
+	return m_meters < _u.m_meters;
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr bool LengthUnit::operator <= ( LengthUnit _u ) const
+{
+	return m_meters <= _u.m_meters;
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr bool LengthUnit::operator > ( LengthUnit _u ) const
+{
+	return m_meters > _u.m_meters;
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr bool LengthUnit::operator >= ( LengthUnit _u ) const
+{
+	return m_meters >= _u.m_meters;
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr LengthUnit operator "" _m ( long double _meters )
+{
+	return LengthUnit( static_cast< double >( _meters ) );
+}
+
+
+/*****************************************************************************/
+
+
+inline constexpr LengthUnit operator "" _m ( unsigned long long _meters )
+{
+	return LengthUnit( static_cast< double >( _meters ) );
+}
+
+
 /*****************************************************************************/
 
 #endif //  _LENGTHUNIT_HPP_
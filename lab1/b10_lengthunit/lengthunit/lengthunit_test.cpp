@@ -8,6 +8,7 @@
 #include "lengthunit.hpp"
 
 #include <string>
+#include <vector>
 
 /*****************************************************************************/
 
@@ -164,6 +165,63 @@ DECLARE_OOP_TEST( lengthunit_test_constructor_incorrect_string )
 /*****************************************************************************/
 
 
+DECLARE_OOP_TEST( lengthunit_test_constructor_long_metric_string )
+{
+	// Parsing gives the double nearest to the decimal, however many digits it has
+	assert( LengthUnit( "0.123456789012345678m" ).getAsMeters() == 0.123456789012345678 );
+	assert( LengthUnit( "-123456789012345678901m" ).getAsMeters() == -123456789012345678901.0 );
+	assert( LengthUnit( "0.1m" ).getAsMeters() == 0.1 );
+	assert( LengthUnit( "000000000000000000002.5m" ).getAsMeters() == 2.5 );
+	assert( LengthUnit( "0.30000000000000004m" ).getAsMeters() == 0.30000000000000004 );
+
+	int feet, inches;
+	LengthUnit( "0000000000000000000003'000000000000000000007\"" ).fetchAsEnglish( feet, inches );
+	assert( feet == 3 );
+	assert( inches == 7 );
+
+	TEST_LENGTHUNIT_INCORRECT_FORMAT( "12345678901'0\"" );
+}
+
+
+/*****************************************************************************/
+
+
+#define TEST_LENGTHUNIT_FEET_OUT_OF_RANGE( code )		\
+	try													\
+	{													\
+		code;											\
+		assert( ! "Exception must have been thrown" );	\
+	}													\
+	catch ( std::exception & e )						\
+	{													\
+		assert( ! strcmp( e.what(), "Feet out of range" ) );	\
+	}
+
+
+DECLARE_OOP_TEST( lengthunit_test_feet_range_and_sign )
+{
+	// The sign of an English length is carried by its feet
+	TEST_LENGTHUNIT_INCORRECT_FORMAT( "-0'5\"" );
+	assert( LengthUnit( "-1'5\"" ).getEnglishFeet() == -1 );
+
+	assert( LengthUnit::MaxFeet == 178956969 );
+	assert( LengthUnit( "178956969'11\"" ).getEnglishFeet() == LengthUnit::MaxFeet );
+	assert( LengthUnit( -LengthUnit::MaxFeet, 11 ).getEnglishFeet() == -LengthUnit::MaxFeet );
+
+	TEST_LENGTHUNIT_FEET_OUT_OF_RANGE( LengthUnit( "178956970'0\"" ) );
+	TEST_LENGTHUNIT_FEET_OUT_OF_RANGE( LengthUnit( "-200000000'0\"" ) );
+	TEST_LENGTHUNIT_FEET_OUT_OF_RANGE( LengthUnit( INT_MIN, 0 ) );
+	TEST_LENGTHUNIT_FEET_OUT_OF_RANGE( LengthUnit( INT_MAX, 0 ) );
+
+	int feet[] = { 1, INT_MIN }, inches[] = { 0, 0 };
+	double meters[ 2 ];
+	TEST_LENGTHUNIT_FEET_OUT_OF_RANGE( LengthUnit::convertToMeters( feet, inches, meters, 2 ) );
+}
+
+
+/*****************************************************************************/
+
+
 
 DECLARE_OOP_TEST( lengthunit_test_conversion )
 {
@@ -279,4 +337,94 @@ DECLARE_OOP_TEST( lengthunit_test_user_defined_literals )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( lengthunit_test_compile_time )
+{
+	constexpr LengthUnit l1 = 2.5_m;
+	constexpr LengthUnit l2( 3, 5 );
+	constexpr LengthUnit l3( -3, 5 );
+
+	static_assert( l1 > 2.0_m && l1 != 2_m, "Literals must compare at compile time" );
+	static_assert( l2.getEnglishFeet() == 3 && l2.getEnglishInches() == 5, "English lengths must convert at compile time" );
+	static_assert( l3.getEnglishFeet() == -3 && l3.getEnglishInches() == 5, "Sign must be carried by feet" );
+	static_assert( LengthUnit( 1.0 ).getEnglishFeet() == 3 && LengthUnit( 1.0 ).getEnglishInches() == 3, "Conversion must truncate" );
+
+	assert( l1.getAsMeters() == 2.5 );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( lengthunit_test_bulk_conversion )
+{
+	const int count = 1000;
+	std::vector< int > feet( count ), inches( count );
+	for ( int i = 0; i < count; ++i )
+	{
+		feet[ i ] = i / 2 - 250;
+		inches[ i ] = i % 12;
+	}
+
+	std::vector< double > meters( count );
+	LengthUnit::convertToMeters( feet.data(), inches.data(), meters.data(), count );
+
+	std::vector< int > feetBack( count ), inchesBack( count );
+	LengthUnit::convertToEnglish( meters.data(), feetBack.data(), inchesBack.data(), count );
+
+	for ( int i = 0; i < count; ++i )
+	{
+		assert( meters[ i ] == LengthUnit( feet[ i ], inches[ i ] ).getAsMeters() );
+
+		// Zero feet carry no sign, so negative lengths below a foot come back positive
+		if ( feet[ i ] )
+			assert( feetBack[ i ] == feet[ i ] );
+		assert( inchesBack[ i ] == inches[ i ] );
+	}
+
+	inches[ 500 ] = 12;
+	try
+	{
+		LengthUnit::convertToMeters( feet.data(), inches.data(), meters.data(), count );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Inches out of range" ) );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( lengthunit_test_format_to_buffer )
+{
+	char buffer[ LengthUnit::MaxStringLength + 1 ];
+
+	assert( LengthUnit( 1234.567 ).formatMetric( buffer, sizeof( buffer ) ) == 8 );
+	assert( ! strcmp( buffer, "1234.57m" ) );
+
+	assert( LengthUnit( -0.001 ).formatMetric( buffer, sizeof( buffer ) ) == 5 );
+	assert( ! strcmp( buffer, "0.00m" ) );
+
+	assert( LengthUnit( -12, 11 ).formatEnglish( buffer, sizeof( buffer ) ) == 7 );
+	assert( ! strcmp( buffer, "-12'11\"" ) );
+
+	assert( ! strcmp( LengthUnit( LengthUnit( 7, 4 ).toMetricString() ).toEnglishString(), "7'4\"" ) );
+
+	try
+	{
+		LengthUnit( 3, 5 ).formatEnglish( buffer, 4 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Buffer too small" ) );
+	}
+}
+
+
 /*****************************************************************************/
@@ -0,0 +1,148 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "concurrent_watermachine.hpp"
+
+#include <stdexcept>
+#include <cmath>
+
+/*****************************************************************************/
+
+
+ConcurrentWaterMachine::ConcurrentWaterMachine (
+		double _maxVolume
+	,	int _maxPapers
+	,	int _maxCoins
+	,	double _pricePerLiter
+)
+	:	m_maxVolume( _maxVolume )
+	,	m_maxVolumeMilliliters( static_cast< int >( std::lround( std::fmin( _maxVolume * 1000.0, 1 << VolumeBits ) ) ) )
+	,	m_maxPapers( _maxPapers ), m_maxCoins( _maxCoins )
+	,	m_pricePerLiter( _pricePerLiter ), m_state( 0 )
+{
+	if ( _maxVolume <= 0.0 || _maxPapers <= 0 || _maxCoins <= 0 || _pricePerLiter <= 0.0 )
+		throw std::logic_error( "Non-positive parameter" );
+
+	if ( m_maxVolumeMilliliters >= ( 1 << VolumeBits ) || _maxPapers >= ( 1 << CounterBits ) || _maxCoins >= ( 1 << CounterBits ) )
+		throw std::logic_error( "Parameter too large" );
+}
+
+
+/*****************************************************************************/
+
+
+void ConcurrentWaterMachine::updatePricePerLiter ( double _pricePerLiter )
+{
+	if ( _pricePerLiter <= 0.0 )
+		throw std::logic_error( "Non-positive parameter" );
+
+	m_pricePerLiter.store( _pricePerLiter );
+}
+
+
+/*****************************************************************************/
+
+
+ConcurrentWaterMachine::operator bool () const
+{
+	return getVolumeForPrepayment( WaterMachine::getValueInCents( WaterMachine::Coin_TwentyFive ) )
+		<= getField( m_state.load(), VolumeShift, VolumeBits );
+}
+
+
+/*****************************************************************************/
+
+
+ConcurrentWaterMachine::Snapshot ConcurrentWaterMachine::getSnapshot () const
+{
+	const State state = m_state.load();
+
+	Snapshot result;
+	result.m_remainingVolume = getField( state, VolumeShift, VolumeBits ) / 1000.0;
+	result.m_prepaymentAmount = getField( state, PrepaymentShift, PrepaymentBits ) / 100.0;
+	result.m_papersInside = getField( state, PapersShift, CounterBits );
+	result.m_coinsInside = getField( state, CoinsShift, CounterBits );
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+bool ConcurrentWaterMachine::acceptPrepayment ( int _cents, int _countShift, int _maxCount )
+{
+	State state = m_state.load();
+	State newState;
+	do
+	{
+		const int count = getField( state, _countShift, CounterBits );
+		if ( count == _maxCount )
+			return false;
+
+		const int prepayment = getField( state, PrepaymentShift, PrepaymentBits ) + _cents;
+		if ( prepayment >= ( 1 << PrepaymentBits ) )
+			return false;
+
+		if ( getVolumeForPrepayment( prepayment ) > getField( state, VolumeShift, VolumeBits ) )
+			return false;
+
+		newState = setField( state, _countShift, CounterBits, count + 1 );
+		newState = setField( newState, PrepaymentShift, PrepaymentBits, prepayment );
+	}
+	while ( ! m_state.compare_exchange_weak( state, newState ) );
+
+	return true;
+}
+
+
+/*****************************************************************************/
+
+
+void ConcurrentWaterMachine::serve ()
+{
+	State state = m_state.load();
+	State newState;
+	do
+	{
+		const int prepayment = getField( state, PrepaymentShift, PrepaymentBits );
+		if ( ! prepayment )
+			throw std::logic_error( "Prepayment expected" );
+
+		const int volume = getField( state, VolumeShift, VolumeBits );
+		const long long due = std::llround( getVolumeForPrepayment( prepayment ) );
+		const int served = ( due < volume ) ? static_cast< int >( due ) : volume;
+
+		newState = setField( state, VolumeShift, VolumeBits, volume - served );
+		newState = setField( newState, PrepaymentShift, PrepaymentBits, 0 );
+	}
+	while ( ! m_state.compare_exchange_weak( state, newState ) );
+}
+
+
+/*****************************************************************************/
+
+
+void ConcurrentWaterMachine::fillWater ()
+{
+	State state = m_state.load();
+	while ( ! m_state.compare_exchange_weak( state, setField( state, VolumeShift, VolumeBits, m_maxVolumeMilliliters ) ) )
+		;
+}
+
+
+/*****************************************************************************/
+
+
+void ConcurrentWaterMachine::takeAwayMoney ()
+{
+	State state = m_state.load();
+	State newState;
+	do
+	{
+		newState = setField( state, PapersShift, CounterBits, 0 );
+		newState = setField( newState, CoinsShift, CounterBits, 0 );
+	}
+	while ( ! m_state.compare_exchange_weak( state, newState ) );
+}
+
+
+/*****************************************************************************/
@@ -0,0 +1,271 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _CONCURRENT_WATERMACHINE_HPP_
+#define _CONCURRENT_WATERMACHINE_HPP_
+
+/*****************************************************************************/
+
+#include "watermachine.hpp"
+
+#include <atomic>
+
+/*****************************************************************************/
+
+/*
+	A water machine that may be shared by several threads without locking. It
+	accepts the same parameters and behaves the same way as WaterMachine,
+	within the limits below.
+
+	Remaining volume (in milliliters), prepayment (in cents) and the numbers of
+	papers and coins inside are packed into a single 64-bit word, which every
+	supported platform changes with one lock-free compare-and-swap. Every
+	operation is one such transaction, so payments, serving and maintenance
+	never see each other half-done, and every getter, snapshot included, is
+	one load.
+
+	Packing bounds the machine to 33554 liters and 1023 papers or coins, which
+	the constructor checks, and the prepayment to 5242.87; a payment that would
+	go over it is refused like one the storage has no place for.
+*/
+
+class ConcurrentWaterMachine
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*------------------------------------------------------------------*/
+
+	struct Snapshot
+	{
+		double m_remainingVolume;
+		double m_prepaymentAmount;
+		int m_papersInside;
+		int m_coinsInside;
+	};
+
+/*------------------------------------------------------------------*/
+
+	ConcurrentWaterMachine ( double _maxVolume, int _maxPapers, int _maxCoins, double _pricePerLiter );
+
+	ConcurrentWaterMachine ( ConcurrentWaterMachine const & ) = delete;
+
+	ConcurrentWaterMachine & operator = ( ConcurrentWaterMachine const & ) = delete;
+
+/*------------------------------------------------------------------*/
+
+	double getMaxVolume () const;
+
+	int getMaxPapers () const;
+
+	int getMaxCoins () const;
+
+	double getPricePerLiter () const;
+
+	void updatePricePerLiter ( double _pricePerLiter );
+
+/*------------------------------------------------------------------*/
+
+	double getRemainingWaterVolume () const;
+
+	int getNumPapersInside () const;
+
+	int getNumCoinsInside () const;
+
+	double getCurrentPrepaymentAmount () const;
+
+	double getVolumeForCurrentPrepayment () const;
+
+	// Whether there is water for the smallest coin
+	operator bool () const;
+
+	Snapshot getSnapshot () const;
+
+/*------------------------------------------------------------------*/
+
+	// Payments are refused when the storage is full, there is no water for
+	// them or the prepayment would go over its limit
+	bool payWithCoins ( WaterMachine::CoinAmount _coin );
+
+	bool payWithPaperMoney ( WaterMachine::PaperMoneyAmount _paper );
+
+	void serve ();
+
+	void fillWater ();
+
+	void takeAwayMoney ();
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	typedef unsigned long long State;
+
+	static_assert( ATOMIC_LLONG_LOCK_FREE == 2, "The state must be a lock-free word" );
+
+	static const int VolumeShift = 0, VolumeBits = 25;
+	static const int PrepaymentShift = 25, PrepaymentBits = 19;
+	static const int PapersShift = 44, CoinsShift = 54, CounterBits = 10;
+
+	static int getField ( State _state, int _shift, int _bits );
+
+	static State setField ( State _state, int _shift, int _bits, int _value );
+
+	// In milliliters
+	double getVolumeForPrepayment ( int _cents ) const;
+
+	bool acceptPrepayment ( int _cents, int _countShift, int _maxCount );
+
+/*------------------------------------------------------------------*/
+
+	const double m_maxVolume;
+
+	// The same in milliliters
+	const int m_maxVolumeMilliliters;
+
+	const int m_maxPapers, m_maxCoins;
+
+	std::atomic< double > m_pricePerLiter;
+
+	std::atomic< State > m_state;
+
+/*------------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline double ConcurrentWaterMachine::getMaxVolume () const
+{
+	return m_maxVolume;
+}
+
+
+/*****************************************************************************/
+
+
+inline int ConcurrentWaterMachine::getMaxPapers () const
+{
+	return m_maxPapers;
+}
+
+
+/*****************************************************************************/
+
+
+inline int ConcurrentWaterMachine::getMaxCoins () const
+{
+	return m_maxCoins;
+}
+
+
+/*****************************************************************************/
+
+
+inline double ConcurrentWaterMachine::getPricePerLiter () const
+{
+	return m_pricePerLiter.load();
+}
+
+
+/*****************************************************************************/
+
+
+inline double ConcurrentWaterMachine::getRemainingWaterVolume () const
+{
+	return getField( m_state.load(), VolumeShift, VolumeBits ) / 1000.0;
+}
+
+
+/*****************************************************************************/
+
+
+inline int ConcurrentWaterMachine::getNumPapersInside () const
+{
+	return getField( m_state.load(), PapersShift, CounterBits );
+}
+
+
+/*****************************************************************************/
+
+
+inline int ConcurrentWaterMachine::getNumCoinsInside () const
+{
+	return getField( m_state.load(), CoinsShift, CounterBits );
+}
+
+
+/*****************************************************************************/
+
+
+inline double ConcurrentWaterMachine::getCurrentPrepaymentAmount () const
+{
+	return getField( m_state.load(), PrepaymentShift, PrepaymentBits ) / 100.0;
+}
+
+
+/*****************************************************************************/
+
+
+inline double ConcurrentWaterMachine::getVolumeForCurrentPrepayment () const
+{
+	return getVolumeForPrepayment( getField( m_state.load(), PrepaymentShift, PrepaymentBits ) ) / 1000.0;
+}
+
+
+/*****************************************************************************/
+
+
+inline double ConcurrentWaterMachine::getVolumeForPrepayment ( int _cents ) const
+{
+	// Cents over price per liter, scaled from liters to milliliters
+	return _cents * 10.0 / m_pricePerLiter.load();
+}
+
+
+/*****************************************************************************/
+
+
+inline int ConcurrentWaterMachine::getField ( State _state, int _shift, int _bits )
+{
+	return static_cast< int >( ( _state >> _shift ) & ( ( 1ull << _bits ) - 1 ) );
+}
+
+
+/*****************************************************************************/
+
+
+inline ConcurrentWaterMachine::State
+ConcurrentWaterMachine::setField ( State _state, int _shift, int _bits, int _value )
+{
+	const State mask = ( ( 1ull << _bits ) - 1 ) << _shift;
+	return ( _state & ~mask ) | ( static_cast< State >( _value ) << _shift );
+}
+
+
+/*****************************************************************************/
+
+
+inline bool ConcurrentWaterMachine::payWithCoins ( WaterMachine::CoinAmount _coin )
+{
+	return acceptPrepayment( WaterMachine::getValueInCents( _coin ), CoinsShift, m_maxCoins );
+}
+
+
+/*****************************************************************************/
+
+
+inline bool ConcurrentWaterMachine::payWithPaperMoney ( WaterMachine::PaperMoneyAmount _paper )
+{
+	return acceptPrepayment( WaterMachine::getValueInCents( _paper ), PapersShift, m_maxPapers );
+}
+
+
+/*****************************************************************************/
+
+#endif //  _CONCURRENT_WATERMACHINE_HPP_
@@ -6,6 +6,131 @@
 
 /*****************************************************************************/
 
-// TODO ...
+
+int WaterMachine::getValueInCents ( PaperMoneyAmount _paper )
+{
+	static const int s_values[] = { 100, 200, 500, 1000 };
+	return s_values[ _paper ];
+}
+
+
+/*****************************************************************************/
+
+
+int WaterMachine::getValueInCents ( CoinAmount _coin )
+{
+	static const int s_values[] = { 100, 50, 25 };
+	return s_values[ _coin ];
+}
+
+
+/*****************************************************************************/
+
+
+WaterMachine::WaterMachine ( double _maxVolume, int _maxPapers, int _maxCoins, double _pricePerLiter )
+	:	m_maxVolume( _maxVolume ), m_maxPapers( _maxPapers ), m_maxCoins( _maxCoins )
+	,	m_pricePerLiter( _pricePerLiter ), m_remainingVolume( 0.0 )
+	,	m_papersInside( 0 ), m_coinsInside( 0 ), m_prepaymentCents( 0 )
+{
+	if ( _maxVolume <= 0.0 || _maxPapers <= 0 || _maxCoins <= 0 || _pricePerLiter <= 0.0 )
+		throw std::logic_error( "Non-positive parameter" );
+}
+
+
+/*****************************************************************************/
+
+
+void WaterMachine::updatePricePerLiter ( double _pricePerLiter )
+{
+	if ( _pricePerLiter <= 0.0 )
+		throw std::logic_error( "Non-positive parameter" );
+
+	m_pricePerLiter = _pricePerLiter;
+}
+
+
+/*****************************************************************************/
+
+
+WaterMachine::operator bool () const
+{
+	return getValueInCents( Coin_TwentyFive ) / 100.0 / m_pricePerLiter <= m_remainingVolume;
+}
+
+
+/*****************************************************************************/
+
+
+bool WaterMachine::acceptPrepayment ( int _cents )
+{
+	int prepaymentCents = m_prepaymentCents + _cents;
+	if ( prepaymentCents / 100.0 / m_pricePerLiter > m_remainingVolume )
+		return false;
+
+	m_prepaymentCents = prepaymentCents;
+	return true;
+}
+
+
+/*****************************************************************************/
+
+
+bool WaterMachine::payWithCoins ( CoinAmount _coin )
+{
+	if ( m_coinsInside == m_maxCoins || ! acceptPrepayment( getValueInCents( _coin ) ) )
+		return false;
+
+	++ m_coinsInside;
+	return true;
+}
+
+
+/*****************************************************************************/
+
+
+bool WaterMachine::payWithPaperMoney ( PaperMoneyAmount _paper )
+{
+	if ( m_papersInside == m_maxPapers || ! acceptPrepayment( getValueInCents( _paper ) ) )
+		return false;
+
+	++ m_papersInside;
+	return true;
+}
+
+
+/*****************************************************************************/
+
+
+void WaterMachine::serve ()
+{
+	if ( ! m_prepaymentCents )
+		throw std::logic_error( "Prepayment expected" );
+
+	m_remainingVolume -= getVolumeForCurrentPrepayment();
+	if ( m_remainingVolume < 0.0 )
+		m_remainingVolume = 0.0;
+
+	m_prepaymentCents = 0;
+}
+
+
+/*****************************************************************************/
+
+
+void WaterMachine::fillWater ()
+{
+	m_remainingVolume = m_maxVolume;
+}
+
+
+/*****************************************************************************/
+
+
+void WaterMachine::takeAwayMoney ()
+{
+	m_papersInside = 0;
+	m_coinsInside = 0;
+}
+
 
 /*****************************************************************************/
@@ -30,15 +30,163 @@ public:
 		Coin_TwentyFive
 	};
 
+	static int getValueInCents ( PaperMoneyAmount _paper );
+
+	static int getValueInCents ( CoinAmount _coin );
+
+/*------------------------------------------------------------------*/
+
+	WaterMachine ( double _maxVolume, int _maxPapers, int _maxCoins, double _pricePerLiter );
+
+/*------------------------------------------------------------------*/
+
+	double getMaxVolume () const;
+
+	int getMaxPapers () const;
+
+	int getMaxCoins () const;
+
+	double getPricePerLiter () const;
+
+	void updatePricePerLiter ( double _pricePerLiter );
+
+/*------------------------------------------------------------------*/
+
+	double getRemainingWaterVolume () const;
+
+	int getNumPapersInside () const;
+
+	int getNumCoinsInside () const;
+
+	double getCurrentPrepaymentAmount () const;
+
+	double getVolumeForCurrentPrepayment () const;
+
+	// Whether there is water for the smallest coin
+	operator bool () const;
+
+/*------------------------------------------------------------------*/
+
+	// Payments are refused when the storage is full or there is no water for them
+	bool payWithCoins ( CoinAmount _coin );
+
+	bool payWithPaperMoney ( PaperMoneyAmount _paper );
+
+	void serve ();
+
+	void fillWater ();
+
+	void takeAwayMoney ();
+
+/*------------------------------------------------------------------*/
+
+private:
+
 /*------------------------------------------------------------------*/
 
-	// TODO ...
+	bool acceptPrepayment ( int _cents );
+
+/*------------------------------------------------------------------*/
+
+	const double m_maxVolume;
+
+	const int m_maxPapers, m_maxCoins;
+
+	double m_pricePerLiter;
+
+	double m_remainingVolume;
+
+	int m_papersInside, m_coinsInside;
+
+	// Money is counted in whole cents to stay exact
+	int m_prepaymentCents;
 
 /*------------------------------------------------------------------*/
 
 };
 
 
+/*****************************************************************************/
+
+
+inline double WaterMachine::getMaxVolume () const
+{
+	return m_maxVolume;
+}
+
+
+/*****************************************************************************/
+
+
+inline int WaterMachine::getMaxPapers () const
+{
+	return m_maxPapers;
+}
+
+
+/*****************************************************************************/
+
+
+inline int WaterMachine::getMaxCoins () const
+{
+	return m_maxCoins;
+}
+
+
+/*****************************************************************************/
+
+
+inline double WaterMachine::getPricePerLiter () const
+{
+	return m_pricePerLiter;
+}
+
+
+/*****************************************************************************/
+
+
+inline double WaterMachine::getRemainingWaterVolume () const
+{
+	return m_remainingVolume;
+}
+
+
+/*****************************************************************************/
+
+
+inline int WaterMachine::getNumPapersInside () const
+{
+	return m_papersInside;
+}
+
+
+/*****************************************************************************/
+
+
+inline int WaterMachine::getNumCoinsInside () const
+{
+	return m_coinsInside;
+}
+
+
+/*****************************************************************************/
+
+
+inline double WaterMachine::getCurrentPrepaymentAmount () const
+{
+	return m_prepaymentCents / 100.0;
+}
+
+
+/*****************************************************************************/
+
+
+inline double WaterMachine::getVolumeForCurrentPrepayment () const
+{
+	return getCurrentPrepaymentAmount() / m_pricePerLiter;
+}
+
+
 /*****************************************************************************/
 
 #endif //  _WATERMACHINE_HPP_
@@ -5,6 +5,10 @@
 #include "testslib.hpp"
 
 #include "watermachine.hpp"
+#include "concurrent_watermachine.hpp"
+
+#include <thread>
+#include <vector>
 
 /*****************************************************************************/
 
@@ -344,3 +348,177 @@ DECLARE_OOP_TEST( watermachine_test_operator_bool )
 
 /*****************************************************************************/
 
+
+
+DECLARE_OOP_TEST( watermachine_test_concurrent_constructor )
+{
+	ConcurrentWaterMachine m( 1000.0, 100, 100, 0.63 );
+	assert( m.getMaxVolume() == 1000.0 );
+	assert( m.getMaxPapers() == 100 );
+	assert( m.getMaxCoins() == 100 );
+	assert( m.getPricePerLiter() == 0.63 );
+
+	ConcurrentWaterMachine::Snapshot s = m.getSnapshot();
+	assert( s.m_remainingVolume == 0.0 );
+	assert( s.m_prepaymentAmount == 0.0 );
+	assert( s.m_papersInside == 0 );
+	assert( s.m_coinsInside == 0 );
+
+	assert( m.getRemainingWaterVolume() == 0.0 );
+	assert( ! m );
+
+	try
+	{
+		ConcurrentWaterMachine m3( 1000.0, 100, 0, 0.63 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Non-positive parameter" ) );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( watermachine_test_concurrent_pay_and_serve )
+{
+	ConcurrentWaterMachine m( 1.0, 1, 2, 0.5 );
+	assert( ! m.payWithCoins( WaterMachine::Coin_TwentyFive ) );
+
+	m.fillWater();
+	assert( m.payWithCoins( WaterMachine::Coin_TwentyFive ) );
+	assert( m.payWithCoins( WaterMachine::Coin_TwentyFive ) );
+	assert( ! m.payWithCoins( WaterMachine::Coin_TwentyFive ) );
+	assert( ! m.payWithPaperMoney( WaterMachine::Paper_One ) );
+
+	ConcurrentWaterMachine::Snapshot s = m.getSnapshot();
+	assert( s.m_prepaymentAmount == 0.5 );
+	assert( s.m_coinsInside == 2 );
+	assert( s.m_papersInside == 0 );
+
+	assert( m.getVolumeForCurrentPrepayment() == 1.0 );
+	m.serve();
+
+	s = m.getSnapshot();
+	assert( s.m_remainingVolume == 0.0 );
+	assert( s.m_prepaymentAmount == 0.0 );
+
+	try
+	{
+		m.serve();
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Prepayment expected" ) );
+	}
+
+	m.takeAwayMoney();
+	assert( m.getSnapshot().m_coinsInside == 0 );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( watermachine_test_concurrent_limits )
+{
+	ConcurrentWaterMachine m( 33554.0, 1023, 1023, 1.0 );
+	WaterMachine plain( 33554.0, 1023, 1023, 1.0 );
+	m.fillWater();
+	plain.fillWater();
+
+	for ( int i = 0; i < 524; ++i )
+	{
+		assert( m.payWithPaperMoney( WaterMachine::Paper_Ten ) );
+		assert( plain.payWithPaperMoney( WaterMachine::Paper_Ten ) );
+	}
+
+	// The prepayment stops at 5242.87
+	assert( ! m.payWithPaperMoney( WaterMachine::Paper_Ten ) );
+	assert( m.payWithPaperMoney( WaterMachine::Paper_Two ) );
+	assert( m.payWithCoins( WaterMachine::Coin_Fifty ) );
+	assert( m.payWithCoins( WaterMachine::Coin_TwentyFive ) );
+	assert( ! m.payWithCoins( WaterMachine::Coin_TwentyFive ) );
+	assert( plain.payWithPaperMoney( WaterMachine::Paper_Two ) );
+	assert( plain.payWithCoins( WaterMachine::Coin_Fifty ) );
+	assert( plain.payWithCoins( WaterMachine::Coin_TwentyFive ) );
+
+	assert( m.getNumPapersInside() == 525 );
+	assert( m.getNumCoinsInside() == 2 );
+	assert( m.getCurrentPrepaymentAmount() == 5242.75 );
+	assert( m.getVolumeForCurrentPrepayment() == plain.getVolumeForCurrentPrepayment() );
+
+	m.serve();
+	plain.serve();
+	assert( m.getRemainingWaterVolume() == plain.getRemainingWaterVolume() );
+	assert( m.getCurrentPrepaymentAmount() == 0.0 );
+	assert( m );
+
+	const double tooLarge[][ 3 ] = { { 33554.5, 1, 1 }, { 1.0, 1024, 1 }, { 1.0, 1, 1024 } };
+	for ( auto const & parameters : tooLarge )
+		try
+		{
+			ConcurrentWaterMachine m2(
+					parameters[ 0 ]
+				,	static_cast< int >( parameters[ 1 ] )
+				,	static_cast< int >( parameters[ 2 ] )
+				,	1.0
+			);
+			assert( ! "Exception must have been thrown" );
+		}
+		catch ( std::exception & e )
+		{
+			assert( ! strcmp( e.what(), "Parameter too large" ) );
+		}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( watermachine_test_concurrent_threads )
+{
+	ConcurrentWaterMachine m( 10000.0, 1000, 1000, 1.0 );
+	m.fillWater();
+
+	const int nThreads = 4, nRounds = 200;
+	std::atomic< int > paidCents( 0 );
+
+	std::vector< std::thread > threads;
+	for ( int t = 0; t < nThreads; ++t )
+		threads.emplace_back( [ & ]
+		{
+			for ( int i = 0; i < nRounds; ++i )
+			{
+				if ( m.payWithCoins( WaterMachine::Coin_Fifty ) )
+					paidCents += 50;
+
+				try
+				{
+					m.serve();
+				}
+				catch ( std::logic_error & )
+				{
+					// Another thread has served this prepayment already
+				}
+
+				// One load, so the prepayment and the coins come from the same moment
+				ConcurrentWaterMachine::Snapshot s = m.getSnapshot();
+				assert( s.m_prepaymentAmount * 100.0 <= s.m_coinsInside * 50.0 );
+			}
+		} );
+
+	for ( std::thread & t : threads )
+		t.join();
+
+	ConcurrentWaterMachine::Snapshot s = m.getSnapshot();
+	assert( s.m_prepaymentAmount == 0.0 );
+	assert( s.m_coinsInside * 50 == paidCents );
+	assert( s.m_remainingVolume == 10000.0 - paidCents / 100.0 );
+}
+
+
+/*****************************************************************************/
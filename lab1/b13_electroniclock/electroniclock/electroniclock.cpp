@@ -3,10 +3,259 @@
 #include "electroniclock.hpp"
 
 #include <stdexcept>
+#include <climits>
 
 /*****************************************************************************/
 
-    // TODO ...
+
+const int ElectronicLock::EmptySlot;
+
+
+/*****************************************************************************/
+
+
+ElectronicLock::ElectronicLock ( int _programmingCode )
+	:	m_codesCount( 0 ), m_hashShift( 32 )
+	,	m_programmingCode( _programmingCode ), m_programmingMode( true )
+{
+}
+
+
+/*****************************************************************************/
+
+
+ElectronicLock::ElectronicLock ( ElectronicLock && _lock )
+	:	m_slots( std::move( _lock.m_slots ) ), m_codesCount( _lock.m_codesCount ), m_hashShift( _lock.m_hashShift )
+	,	m_programmingCode( _lock.m_programmingCode ), m_programmingMode( _lock.m_programmingMode )
+{
+	_lock.m_slots.clear();
+	_lock.m_codesCount = 0;
+	_lock.m_hashShift = 32;
+}
+
+
+/*****************************************************************************/
+
+
+ElectronicLock & ElectronicLock::operator = ( ElectronicLock && _lock )
+{
+	if ( & _lock == this )
+		return * this;
+
+	m_slots = std::move( _lock.m_slots );
+	m_codesCount = _lock.m_codesCount;
+	m_hashShift = _lock.m_hashShift;
+	m_programmingCode = _lock.m_programmingCode;
+	m_programmingMode = _lock.m_programmingMode;
+
+	_lock.m_slots.clear();
+	_lock.m_codesCount = 0;
+	_lock.m_hashShift = 32;
+
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+void ElectronicLock::checkProgrammingMode () const
+{
+	if ( ! m_programmingMode )
+		throw std::logic_error( "Not in programming mode" );
+}
+
+
+/*****************************************************************************/
+
+
+void ElectronicLock::checkOperationalMode () const
+{
+	if ( m_programmingMode )
+		throw std::logic_error( "Not in operational mode" );
+}
+
+
+/*****************************************************************************/
+
+
+bool ElectronicLock::toggleProgrammingMode ( int _programmingCode )
+{
+	if ( _programmingCode != m_programmingCode )
+		return false;
+
+	m_programmingMode = ! m_programmingMode;
+	return true;
+}
+
+
+/*****************************************************************************/
+
+
+void ElectronicLock::changeProgrammingCode ( int _newProgrammingCode )
+{
+	checkProgrammingMode();
+
+	m_programmingCode = _newProgrammingCode;
+}
+
+
+/*****************************************************************************/
+
+
+void ElectronicLock::rehash ( int _slotsCount )
+{
+	std::vector< int > oldSlots( _slotsCount, EmptySlot );
+	oldSlots.swap( m_slots );
+
+	m_hashShift = 32;
+	for ( int count = _slotsCount; count > 1; count >>= 1 )
+		-- m_hashShift;
+
+	for ( int code : oldSlots )
+		if ( code != EmptySlot )
+			m_slots[ findSlot( code ) ] = code;
+}
+
+
+/*****************************************************************************/
+
+
+void ElectronicLock::registerCode ( int _code )
+{
+	checkProgrammingMode();
+
+	if ( _code < 0 )
+		throw std::logic_error( "Invalid code" );
+
+	// Keeping the table at most half full keeps probe runs short
+	const int slotsCount = static_cast< int >( m_slots.size() );
+	if ( 2 * ( m_codesCount + 1 ) > slotsCount )
+		rehash( slotsCount ? 2 * slotsCount : MinSlotsCount );
+
+	int slot = findSlot( _code );
+	if ( m_slots[ slot ] == EmptySlot )
+	{
+		m_slots[ slot ] = _code;
+		++ m_codesCount;
+	}
+}
+
+
+/*****************************************************************************/
+
+
+void ElectronicLock::unregisterCode ( int _code )
+{
+	checkProgrammingMode();
+
+	if ( ! contains( _code ) )
+		return;
+
+	const int mask = static_cast< int >( m_slots.size() ) - 1;
+
+	// Codes later in the run move into the gap unless the gap lies before their home slot
+	int gap = findSlot( _code );
+	for ( int slot = ( gap + 1 ) & mask; m_slots[ slot ] != EmptySlot; slot = ( slot + 1 ) & mask )
+	{
+		int home = getHomeSlot( m_slots[ slot ] );
+		if ( ( ( slot - home ) & mask ) >= ( ( slot - gap ) & mask ) )
+		{
+			m_slots[ gap ] = m_slots[ slot ];
+			gap = slot;
+		}
+	}
+
+	m_slots[ gap ] = EmptySlot;
+	-- m_codesCount;
+}
+
 
 /*****************************************************************************/
 
+
+bool ElectronicLock::tryUnlocking ( char const * _code ) const
+{
+	long long code = 0;
+	int nDigits = 0;
+
+	for ( char const * p = _code; * p; ++p, ++nDigits )
+	{
+		if ( * p < '0' || * p > '9' || code > INT_MAX / 10 )
+			throw std::logic_error( "Bad format" );
+
+		code = code * 10 + ( * p - '0' );
+	}
+
+	if ( ! nDigits || code > INT_MAX )
+		throw std::logic_error( "Bad format" );
+
+	return tryUnlocking( static_cast< int >( code ) );
+}
+
+
+/*****************************************************************************/
+
+
+int ElectronicLock::tryUnlockingMany ( int const * _pCodes, int _count, bool * _pResults ) const
+{
+	checkOperationalMode();
+
+	if ( ! m_codesCount )
+	{
+		for ( int i = 0; i < _count; ++i )
+			_pResults[ i ] = false;
+		return 0;
+	}
+
+	// Home slots of a group are read before any probing starts, so that
+	// the cache misses of independent lookups overlap
+	const int GroupSize = 16;
+	int homeCodes[ GroupSize ];
+
+	int nAccepted = 0;
+	for ( int first = 0; first < _count; first += GroupSize )
+	{
+		const int groupSize = ( _count - first < GroupSize ) ? _count - first : GroupSize;
+
+		for ( int i = 0; i < groupSize; ++i )
+			homeCodes[ i ] = m_slots[ getHomeSlot( _pCodes[ first + i ] ) ];
+
+		for ( int i = 0; i < groupSize; ++i )
+		{
+			const int code = _pCodes[ first + i ];
+
+			bool accepted;
+			if ( code < 0 || homeCodes[ i ] == EmptySlot )
+				accepted = false;
+			else if ( homeCodes[ i ] == code )
+				accepted = true;
+			else
+				accepted = m_slots[ findSlot( code ) ] == code;
+
+			_pResults[ first + i ] = accepted;
+			nAccepted += accepted;
+		}
+	}
+
+	return nAccepted;
+}
+
+
+/*****************************************************************************/
+
+
+bool ElectronicLock::operator == ( ElectronicLock const & _lock ) const
+{
+	if ( m_programmingCode != _lock.m_programmingCode || m_codesCount != _lock.m_codesCount )
+		return false;
+
+	for ( int code : m_slots )
+		if ( code != EmptySlot && ! _lock.contains( code ) )
+			return false;
+
+	return true;
+}
+
+
+/*****************************************************************************/
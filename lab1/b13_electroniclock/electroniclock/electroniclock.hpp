@@ -5,18 +5,182 @@
 
 /*****************************************************************************/
 
+#include <vector>
+
+/*****************************************************************************/
+
+/*
+	Registered codes live in an open-addressing hash table with linear probing,
+	kept at most half full. Checking a code hashes it and scans a short run of
+	adjacent slots, without allocating. Unregistering shifts the rest of the
+	run back, so the table never accumulates deleted markers.
+
+	Codes are non-negative numbers, as typed on the keypad.
+*/
+
 class ElectronicLock
 {
 
 /*-----------------------------------------------------------------*/
 
-    // TODO ...
+public:
+
+/*------------------------------------------------------------------*/
+
+	explicit ElectronicLock ( int _programmingCode );
+
+	ElectronicLock ( ElectronicLock const & _lock ) = default;
+
+	ElectronicLock ( ElectronicLock && _lock );
+
+	ElectronicLock & operator = ( ElectronicLock const & _lock ) = default;
+
+	ElectronicLock & operator = ( ElectronicLock && _lock );
+
+/*------------------------------------------------------------------*/
+
+	bool isInProgrammingMode () const;
+
+	bool toggleProgrammingMode ( int _programmingCode );
+
+	void changeProgrammingCode ( int _newProgrammingCode );
+
+	void registerCode ( int _code );
+
+	void unregisterCode ( int _code );
+
+	int getCodesCount () const;
+
+/*------------------------------------------------------------------*/
+
+	bool tryUnlocking ( int _code ) const;
+
+	bool tryUnlocking ( char const * _code ) const;
+
+	// Checks _count attempts, writing each outcome into _pResults; returns the number accepted
+	int tryUnlockingMany ( int const * _pCodes, int _count, bool * _pResults ) const;
+
+/*------------------------------------------------------------------*/
+
+	bool operator == ( ElectronicLock const & _lock ) const;
+
+	bool operator != ( ElectronicLock const & _lock ) const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	void checkProgrammingMode () const;
+
+	void checkOperationalMode () const;
+
+	int getHomeSlot ( int _code ) const;
+
+	// Slot holding _code, or the empty slot ending its probe run
+	int findSlot ( int _code ) const;
+
+	bool contains ( int _code ) const;
+
+	void rehash ( int _slotsCount );
+
+/*------------------------------------------------------------------*/
+
+	static const int EmptySlot = -1;
+
+	static const int MinSlotsCount = 16;
+
+	// Number of slots is a power of two, or zero before the first code
+	std::vector< int > m_slots;
+
+	int m_codesCount;
+
+	// 32 minus the binary logarithm of the slots count
+	int m_hashShift;
+
+	int m_programmingCode;
+
+	bool m_programmingMode;
 
 /*------------------------------------------------------------------*/
 
 };
 
 
+/*****************************************************************************/
+
+
+inline bool ElectronicLock::isInProgrammingMode () const
+{
+	return m_programmingMode;
+}
+
+
+/*****************************************************************************/
+
+
+inline int ElectronicLock::getCodesCount () const
+{
+	return m_codesCount;
+}
+
+
+/*****************************************************************************/
+
+
+inline int ElectronicLock::getHomeSlot ( int _code ) const
+{
+	// Fibonacci hashing: the top bits of the product select the slot
+	unsigned hash = static_cast< unsigned >( _code ) * 2654435769u;
+	return static_cast< int >( hash >> m_hashShift );
+}
+
+
+/*****************************************************************************/
+
+
+inline int ElectronicLock::findSlot ( int _code ) const
+{
+	const int mask = static_cast< int >( m_slots.size() ) - 1;
+
+	int slot = getHomeSlot( _code );
+	while ( m_slots[ slot ] != EmptySlot && m_slots[ slot ] != _code )
+		slot = ( slot + 1 ) & mask;
+
+	return slot;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool ElectronicLock::contains ( int _code ) const
+{
+	return _code >= 0 && m_codesCount && m_slots[ findSlot( _code ) ] == _code;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool ElectronicLock::tryUnlocking ( int _code ) const
+{
+	checkOperationalMode();
+
+	return contains( _code );
+}
+
+
+/*****************************************************************************/
+
+
+inline bool ElectronicLock::operator != ( ElectronicLock const & _lock ) const
+{
+	return !( * this == _lock );
+}
+
+
 /*****************************************************************************/
 
 #endif //  _ELECTRONICLOCK_HPP_
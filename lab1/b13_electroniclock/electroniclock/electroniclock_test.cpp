@@ -6,6 +6,10 @@
 
 #include "electroniclock.hpp"
 
+#include <set>
+#include <vector>
+#include <memory>
+
 /*****************************************************************************/
 
 
@@ -364,4 +368,93 @@ DECLARE_OOP_TEST( electroniclock_test_copying_moving )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( electroniclock_test_many_codes )
+{
+	ElectronicLock lock( 123 );
+	std::set< int > codes;
+
+	// Codes differing in high bits only, and frequent removals
+	for ( int i = 0; i < 20000; ++i )
+	{
+		int code = ( i % 1000 ) << 16 | ( i * 7919 ) % 100;
+		if ( i % 3 == 2 )
+		{
+			lock.unregisterCode( code );
+			codes.erase( code );
+		}
+		else
+		{
+			lock.registerCode( code );
+			codes.insert( code );
+		}
+	}
+
+	assert( lock.getCodesCount() == static_cast< int >( codes.size() ) );
+	lock.toggleProgrammingMode( 123 );
+
+	std::vector< int > attempts;
+	for ( int i = 0; i < 30000; ++i )
+		attempts.push_back( ( i % 1100 ) << 16 | ( i * 31 ) % 100 );
+
+	std::unique_ptr< bool[] > results( new bool[ attempts.size() ] );
+	int nAccepted = lock.tryUnlockingMany( attempts.data(), static_cast< int >( attempts.size() ), results.get() );
+
+	int nExpected = 0;
+	for ( int i = 0; i < static_cast< int >( attempts.size() ); ++i )
+	{
+		bool expected = codes.count( attempts[ i ] ) > 0;
+		assert( lock.tryUnlocking( attempts[ i ] ) == expected );
+		assert( results[ i ] == expected );
+		nExpected += expected;
+	}
+
+	assert( nAccepted == nExpected );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( electroniclock_test_invalid_codes )
+{
+	ElectronicLock lock( 123 );
+
+	try
+	{
+		lock.registerCode( -5 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Invalid code" ) );
+	}
+
+	lock.toggleProgrammingMode( 123 );
+	assert( ! lock.tryUnlocking( -1 ) );
+
+	try
+	{
+		lock.tryUnlocking( "99999999999" );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Bad format" ) );
+	}
+
+	try
+	{
+		lock.tryUnlocking( "" );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Bad format" ) );
+	}
+}
+
+
 /*****************************************************************************/
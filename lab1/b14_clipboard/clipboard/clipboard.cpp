@@ -3,9 +3,317 @@
 #include "clipboard.hpp"
 
 #include <stdexcept>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
 
 /*****************************************************************************/
 
-    // TODO ...
+
+Clipboard::Clipboard ( int _maxBufferSize )
+	:	m_maxBufferSize( _maxBufferSize ), m_format( Format_Empty ), m_contentsSize( 0 ), m_lastChunkSize( 0 )
+{
+	if ( _maxBufferSize <= 0 )
+		throw std::logic_error( "Buffer size must be positive" );
+}
+
+
+/*****************************************************************************/
+
+
+Clipboard::Clipboard ( Clipboard const & _c )
+	:	m_maxBufferSize( _c.m_maxBufferSize ), m_format( _c.m_format )
+	,	m_contentsSize( _c.m_contentsSize ), m_lastChunkSize( _c.m_lastChunkSize )
+	,	m_pieces( _c.m_pieces ), m_pJoined( std::atomic_load( & _c.m_pJoined ) )
+{
+}
+
+
+/*****************************************************************************/
+
+
+Clipboard::Clipboard ( Clipboard && _c )
+	:	m_maxBufferSize( _c.m_maxBufferSize ), m_format( _c.m_format )
+	,	m_contentsSize( _c.m_contentsSize ), m_lastChunkSize( _c.m_lastChunkSize )
+	,	m_pieces( std::move( _c.m_pieces ) ), m_pJoined( std::move( _c.m_pJoined ) )
+{
+	_c.clear();
+}
+
+
+/*****************************************************************************/
+
+
+Clipboard & Clipboard::operator = ( Clipboard const & _c )
+{
+	if ( & _c == this )
+		return * this;
+
+	m_pieces = _c.m_pieces;
+	m_pJoined = std::atomic_load( & _c.m_pJoined );
+	m_maxBufferSize = _c.m_maxBufferSize;
+	m_format = _c.m_format;
+	m_contentsSize = _c.m_contentsSize;
+	m_lastChunkSize = _c.m_lastChunkSize;
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+Clipboard & Clipboard::operator = ( Clipboard && _c )
+{
+	if ( & _c == this )
+		return * this;
+
+	m_maxBufferSize = _c.m_maxBufferSize;
+	m_format = _c.m_format;
+	m_contentsSize = _c.m_contentsSize;
+	m_lastChunkSize = _c.m_lastChunkSize;
+	m_pieces = std::move( _c.m_pieces );
+	m_pJoined = std::move( _c.m_pJoined );
+
+	_c.clear();
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+int Clipboard::getCurrentDataSize () const
+{
+	return ( m_format == Format_Text ) ? m_contentsSize + 1 : m_contentsSize;
+}
+
+
+/*****************************************************************************/
+
+
+int Clipboard::getTextLength ( char const * _text, int _limit )
+{
+	int length = 0;
+	while ( length < _limit && _text[ length ] )
+		++length;
+
+	return length;
+}
+
+
+/*****************************************************************************/
+
+
+int Clipboard::getJoinedChunkSize () const
+{
+	return std::min( 2 * ( m_contentsSize + 1 ), m_maxBufferSize );
+}
+
+
+/*****************************************************************************/
+
+
+void Clipboard::setSinglePiece ( std::shared_ptr< char > _pChunk, int _size, int _chunkSize )
+{
+	m_pieces.clear();
+	m_pieces.push_back( Piece{ std::move( _pChunk ), _size } );
+	m_lastChunkSize = _chunkSize;
+	m_contentsSize = _size;
+	m_pJoined.reset();
+}
+
+
+/*****************************************************************************/
+
+
+void Clipboard::takeJoinedChunk ()
+{
+	if ( m_pJoined )
+		setSinglePiece( std::move( m_pJoined ), m_contentsSize, getJoinedChunkSize() );
+}
+
+
+/*****************************************************************************/
+
+
+void Clipboard::appendText ( char const * _text, int _length )
+{
+	// The text may come from a view, which keeps the chunk it points to among the pieces
+	takeJoinedChunk();
+
+	Piece & last = m_pieces.back();
+	if ( last.m_pChunk.use_count() == 1 && last.m_size + _length + 1 <= m_lastChunkSize )
+	{
+		// The text may come from the piece, but never overlaps the room past it
+		memcpy( last.m_pChunk.get() + last.m_size, _text, _length );
+		last.m_size += _length;
+		last.m_pChunk.get()[ last.m_size ] = '\0';
+	}
+	else
+	{
+		// A shared piece may be large and tells nothing of the appends to come,
+		// while a full piece of this clipboard is outgrown geometrically
+		const int wantedSize = ( last.m_pChunk.use_count() > 1 ) ? _length + 1 : 2 * m_lastChunkSize;
+		const int chunkSize = std::min( std::max( _length + 1, wantedSize ), m_maxBufferSize - m_contentsSize );
+
+		std::shared_ptr< char > pChunk( new char[ chunkSize ], std::default_delete< char[] >() );
+		memcpy( pChunk.get(), _text, _length );
+		pChunk.get()[ _length ] = '\0';
+
+		m_pieces.push_back( Piece{ std::move( pChunk ), _length } );
+		m_lastChunkSize = chunkSize;
+	}
+
+	m_contentsSize += _length;
+}
+
+
+/*****************************************************************************/
+
+
+void Clipboard::putText ( char const * _text )
+{
+	const int length = getTextLength( _text, m_maxBufferSize - 1 );
+
+	// The text is copied before clearing, as it may come from a view of this clipboard
+	std::shared_ptr< char > pChunk( new char[ length + 1 ], std::default_delete< char[] >() );
+	memcpy( pChunk.get(), _text, length );
+	pChunk.get()[ length ] = '\0';
+
+	m_format = Format_Text;
+	setSinglePiece( std::move( pChunk ), length, length + 1 );
+}
+
+
+/*****************************************************************************/
+
+
+bool Clipboard::putBinaryData ( void const * _pData, int _size )
+{
+	if ( _size < 0 || _size > m_maxBufferSize )
+		return false;
+
+	std::unique_ptr< char[] > pChunk( new char[ _size ] );
+	memcpy( pChunk.get(), _pData, _size );
+
+	return putBinaryData( std::move( pChunk ), _size );
+}
+
+
+/*****************************************************************************/
+
+
+bool Clipboard::putBinaryData ( std::unique_ptr< char[] > && _pData, int _size )
+{
+	if ( _size < 0 || _size > m_maxBufferSize )
+		return false;
+
+	std::shared_ptr< char > pChunk( _pData.get(), std::default_delete< char[] >() );
+	_pData.release();
+
+	m_format = Format_Binary;
+	setSinglePiece( std::move( pChunk ), _size, _size );
+	return true;
+}
+
+
+/*****************************************************************************/
+
+
+Clipboard & Clipboard::operator += ( char const * _text )
+{
+	if ( m_format == Format_Empty )
+		putText( _text );
+
+	else if ( m_format == Format_Text )
+	{
+		int length = getTextLength( _text, m_maxBufferSize - 1 - m_contentsSize );
+		if ( length )
+			appendText( _text, length );
+	}
+
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+void Clipboard::clear ()
+{
+	m_format = Format_Empty;
+	m_contentsSize = 0;
+	m_lastChunkSize = 0;
+	m_pieces.clear();
+	m_pJoined.reset();
+}
+
+
+/*****************************************************************************/
+
+
+void Clipboard::copyTextTo ( char * _buffer ) const
+{
+	if ( m_format != Format_Text )
+		throw std::logic_error( "No text in clipboard" );
+
+	for ( Piece const & piece : m_pieces )
+	{
+		memcpy( _buffer, piece.m_pChunk.get(), piece.m_size );
+		_buffer += piece.m_size;
+	}
+
+	* _buffer = '\0';
+}
+
+
+/*****************************************************************************/
+
+
+void Clipboard::copyBinaryDataTo ( void * _pBuffer ) const
+{
+	if ( m_format != Format_Binary )
+		throw std::logic_error( "No binary data in clipboard" );
+
+	// Binary data is always a single piece
+	if ( ! m_pieces.empty() )
+		memcpy( _pBuffer, m_pieces[ 0 ].m_pChunk.get(), m_contentsSize );
+}
+
+
+/*****************************************************************************/
+
+
+Clipboard::View Clipboard::view () const
+{
+	if ( m_pieces.size() <= 1 )
+		return View{ m_pieces.empty() ? nullptr : m_pieces[ 0 ].m_pChunk.get(), getCurrentDataSize() };
+
+	// Several pieces are joined once; a concurrent view may have joined them first
+	std::shared_ptr< char > pJoined = std::atomic_load( & m_pJoined );
+	if ( ! pJoined )
+	{
+		std::shared_ptr< char > pChunk( new char[ getJoinedChunkSize() ], std::default_delete< char[] >() );
+		copyTextTo( pChunk.get() );
+
+		if ( std::atomic_compare_exchange_strong( & m_pJoined, & pJoined, pChunk ) )
+			pJoined = std::move( pChunk );
+	}
+
+	return View{ pJoined.get(), getCurrentDataSize() };
+}
+
+
+/*****************************************************************************/
+
+
+Clipboard::View Clipboard::getPiece ( int _index ) const
+{
+	if ( _index < 0 || _index >= getPiecesCount() )
+		throw std::logic_error( "Piece index out of range" );
+
+	return View{ m_pieces[ _index ].m_pChunk.get(), m_pieces[ _index ].m_size };
+}
+
 
 /*****************************************************************************/
@@ -5,6 +5,28 @@
 
 /*****************************************************************************/
 
+#include <vector>
+#include <memory>
+
+/*****************************************************************************/
+
+/*
+	Clipboard contents are a rope of reference-counted pieces, which copies of
+	a clipboard share. A shared chunk is never written to.
+
+	Appending text adds a piece for the new text only, so earlier pieces are
+	never copied, even when other clipboards share them. A piece no other
+	clipboard shares takes appended text into spare room of its chunk, which
+	grows geometrically up to the buffer size, so a series of appends makes a
+	logarithmic number of pieces.
+
+	view() returns the contents as one block: a single piece as it is, several
+	pieces joined into a new chunk on the first view after they change. Views
+	of one clipboard made at the same time agree on the joined chunk, and the
+	next append takes it over in place of the pieces. Each text chunk has room
+	for a terminator past its piece. Views stay valid until the clipboard
+	changes.
+*/
 
 class Clipboard
 {
@@ -24,7 +46,112 @@ public:
 
 /*------------------------------------------------------------------*/
 
-	// TODO ...
+	struct View
+	{
+		char const * m_pData;
+
+		int m_size;
+	};
+
+/*------------------------------------------------------------------*/
+
+	explicit Clipboard ( int _maxBufferSize = 4096 );
+
+	Clipboard ( Clipboard const & _c );
+
+	Clipboard ( Clipboard && _c );
+
+	Clipboard & operator = ( Clipboard const & _c );
+
+	Clipboard & operator = ( Clipboard && _c );
+
+/*------------------------------------------------------------------*/
+
+	int getMaxBufferSize () const;
+
+	// For text the terminator is counted in
+	int getCurrentDataSize () const;
+
+	DataFormat getCurrentFormat () const;
+
+	explicit operator bool () const;
+
+/*------------------------------------------------------------------*/
+
+	// Text is cut to fit the buffer together with its terminator
+	void putText ( char const * _text );
+
+	// Data larger than the buffer is rejected and leaves the clipboard as it was
+	bool putBinaryData ( void const * _pData, int _size );
+
+	// Takes over the buffer instead of copying it; a rejected buffer stays with the caller
+	bool putBinaryData ( std::unique_ptr< char[] > && _pData, int _size );
+
+	// Appends to text, starts text in an empty clipboard, ignored for binary data
+	Clipboard & operator += ( char const * _text );
+
+	void clear ();
+
+/*------------------------------------------------------------------*/
+
+	void copyTextTo ( char * _buffer ) const;
+
+	void copyBinaryDataTo ( void * _pBuffer ) const;
+
+	// getCurrentDataSize() bytes of the contents in one block
+	View view () const;
+
+	int getPiecesCount () const;
+
+	// A piece of the contents without copying; text pieces exclude the terminator
+	View getPiece ( int _index ) const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	struct Piece
+	{
+		std::shared_ptr< char > m_pChunk;
+
+		// Bytes of the contents in the chunk, the text terminator excluded
+		int m_size;
+	};
+
+/*------------------------------------------------------------------*/
+
+	// Length of _text, but not more than _limit
+	static int getTextLength ( char const * _text, int _limit );
+
+	// Bytes allocated for joining the pieces, with room for appends
+	int getJoinedChunkSize () const;
+
+	// Replaces the pieces with the chunk a view joined them into, if any
+	void takeJoinedChunk ();
+
+	// Contents followed by _length characters of _text and a terminator
+	void appendText ( char const * _text, int _length );
+
+	void setSinglePiece ( std::shared_ptr< char > _pChunk, int _size, int _chunkSize );
+
+/*------------------------------------------------------------------*/
+
+	int m_maxBufferSize;
+
+	DataFormat m_format;
+
+	// Bytes in the pieces, the text terminator excluded
+	int m_contentsSize;
+
+	// Bytes allocated for the chunk of the last piece
+	int m_lastChunkSize;
+
+	std::vector< Piece > m_pieces;
+
+	// The pieces joined by view(), accessed atomically by concurrent views
+	mutable std::shared_ptr< char > m_pJoined;
 
 /*------------------------------------------------------------------*/
 
@@ -33,4 +160,41 @@ public:
 
 /*****************************************************************************/
 
+
+inline int Clipboard::getMaxBufferSize () const
+{
+	return m_maxBufferSize;
+}
+
+
+/*****************************************************************************/
+
+
+inline Clipboard::DataFormat Clipboard::getCurrentFormat () const
+{
+	return m_format;
+}
+
+
+/*****************************************************************************/
+
+
+inline Clipboard::operator bool () const
+{
+	return m_format != Format_Empty;
+}
+
+
+/*****************************************************************************/
+
+
+inline int Clipboard::getPiecesCount () const
+{
+	return static_cast< int >( m_pieces.size() );
+}
+
+
+/*****************************************************************************/
+
+
 #endif //  _CLIPBOARD_HPP_
@@ -300,4 +300,156 @@ DECLARE_OOP_TEST( clipboard_test_copy_and_move )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( clipboard_test_copies_share_data )
+{
+	Clipboard c1( 100 );
+	c1.putText( "Hello" );
+
+	Clipboard c2 = c1;
+	assert( c1.view().m_pData == c2.view().m_pData );
+
+	// Appending gives the clipboard a view of its own
+	c2 += " World";
+	assert( c2.view().m_pData != c1.view().m_pData );
+
+	char buf[ 100 ];
+	c1.copyTextTo( buf );
+	assert( ! strcmp( buf, "Hello" ) );
+
+	Clipboard::View v = c2.view();
+	assert( v.m_size == 12 );
+	assert( ! strcmp( v.m_pData, "Hello World" ) );
+	assert( c2.view().m_pData == v.m_pData );
+
+	// Text taken from the clipboard's own view
+	c2 += v.m_pData;
+	c2.copyTextTo( buf );
+	assert( ! strcmp( buf, "Hello WorldHello World" ) );
+
+	c2.putText( c2.view().m_pData + 6 );
+	c2.copyTextTo( buf );
+	assert( ! strcmp( buf, "WorldHello World" ) );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( clipboard_test_append_in_place )
+{
+	Clipboard c( 1000 );
+	c.putText( "a" );
+
+	// Appends to an unshared chunk reuse its room, so reallocations are rare
+	int reallocations = 0;
+	for ( int i = 0; i < 500; ++i )
+	{
+		char const * pBefore = c.view().m_pData;
+		c += "b";
+		if ( c.view().m_pData != pBefore )
+			++reallocations;
+	}
+
+	assert( c.getCurrentDataSize() == 502 );
+	assert( reallocations < 16 );
+
+	// A copy keeps the text it was made with
+	Clipboard copy = c;
+	c += "c";
+	assert( copy.getCurrentDataSize() == 502 );
+	assert( copy.view().m_pData[ 501 ] == '\0' );
+	assert( c.view().m_pData[ 501 ] == 'c' );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( clipboard_test_shared_append_keeps_earlier_chunks )
+{
+	Clipboard c1( 100 );
+	c1.putText( "Hello" );
+
+	// Only the appended text is copied, the shared chunk stays a piece
+	Clipboard c2 = c1;
+	c2 += ", world";
+	assert( c2.getPiecesCount() == 2 );
+	assert( c2.getPiece( 0 ).m_pData == c1.view().m_pData );
+	assert( c2.getPiece( 0 ).m_size == 5 );
+	assert( c2.getPiece( 1 ).m_size == 7 );
+	assert( ! strcmp( c1.view().m_pData, "Hello" ) );
+
+	Clipboard::View v = c2.view();
+	assert( v.m_size == 13 );
+	assert( ! strcmp( v.m_pData, "Hello, world" ) );
+	assert( c2.view().m_pData == v.m_pData );
+
+	// The next append goes to the joined chunk
+	c2 += "!";
+	assert( c2.getPiecesCount() == 1 );
+	assert( c2.view().m_pData == v.m_pData );
+	assert( ! strcmp( c2.view().m_pData, "Hello, world!" ) );
+	assert( ! strcmp( c1.view().m_pData, "Hello" ) );
+
+	try
+	{
+		c2.getPiece( 1 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Piece index out of range" ) );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( clipboard_test_append_respects_limit )
+{
+	Clipboard c( 10 );
+	c.putText( "Hello" );
+	c += " magic";
+	c += " world";
+
+	assert( c.getCurrentDataSize() == 10 );
+	assert( ! strcmp( c.view().m_pData, "Hello mag" ) );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( clipboard_test_owned_binary_data )
+{
+	const int size = 1 << 20;
+	std::unique_ptr< char[] > pPayload( new char[ size ] );
+	for ( int i = 0; i < size; ++i )
+		pPayload[ i ] = static_cast< char >( i );
+
+	char const * pData = pPayload.get();
+
+	// A rejected buffer stays with the caller
+	Clipboard c1( size );
+	assert( ! c1.putBinaryData( std::move( pPayload ), size + 1 ) );
+	assert( pPayload.get() == pData );
+
+	assert( c1.putBinaryData( std::move( pPayload ), size ) );
+	assert( ! pPayload );
+
+	Clipboard c2 = c1;
+	Clipboard c3 = std::move( c2 );
+	assert( c3.view().m_pData == pData );
+	assert( c3.view().m_size == size );
+	assert( c3.view().m_pData[ 1 ] == 1 );
+	assert( c1.getCurrentFormat() == Clipboard::Format_Binary );
+	assert( c2.getCurrentFormat() == Clipboard::Format_Empty );
+	assert( c2.view().m_size == 0 );
+}
+
+
 /*****************************************************************************/
@@ -6,6 +6,70 @@
 
 /*****************************************************************************/
 
-    // TODO ...
+constexpr signed char MusicalNote::s_semitones[ MusicalNote::CodesCount ];
+constexpr unsigned char MusicalNote::s_semitoneCodes[ MusicalNote::SemitonesInOctave ];
+constexpr char MusicalNote::s_names[ MusicalNote::CodesCount ][ MusicalNote::MaxStringLength ];
+
+/*****************************************************************************/
+
+
+MusicalNote::MusicalNote ( Note _note, Sign _sign )
+{
+	if ( _sign < Sign_None || _sign > Sign_Flat )
+		throw std::logic_error( "Invalid note" );
+
+	* this = fromCode( static_cast< unsigned char >( _note * 3 + _sign ) );
+}
+
+
+/*****************************************************************************/
+
+
+MusicalNote::MusicalNote ( const char * _text )
+{
+	if ( _text[ 0 ] < 'A' || _text[ 0 ] > 'G' )
+		throw std::logic_error( "Invalid format" );
+
+	Note note = static_cast< Note >( _text[ 0 ] - 'A' );
+
+	Sign sign;
+	switch ( _text[ 1 ] )
+	{
+		case '\0':
+			sign = Sign_None;
+			break;
+
+		case '#':
+			sign = Sign_Sharp;
+			break;
+
+		case 'b':
+			sign = Sign_Flat;
+			break;
+
+		default:
+			throw std::logic_error( "Invalid format" );
+	}
+
+	if ( sign != Sign_None && _text[ 2 ] != '\0' )
+		throw std::logic_error( "Invalid format" );
+
+	* this = MusicalNote( note, sign );
+}
+
+
+/*****************************************************************************/
+
+
+MusicalNote MusicalNote::fromCode ( unsigned char _code )
+{
+	if ( _code >= CodesCount || s_semitones[ _code ] < 0 )
+		throw std::logic_error( "Invalid note" );
+
+	MusicalNote result;
+	result.m_code = _code;
+	return result;
+}
+
 
 /*****************************************************************************/
@@ -51,14 +51,278 @@ public:
 
 /*------------------------------------------------------------------*/
 
+	// A note packs into one byte as ( note * 3 + sign )
+	static const int CodesCount = 21;
 
-	// TODO ...
+	static const int SemitonesInOctave = 12;
+
+	// Longest name plus '\0'
+	static const int MaxStringLength = 3;
+
+/*------------------------------------------------------------------*/
+
+	MusicalNote ( Note _note, Sign _sign = Sign_None );
+
+	MusicalNote ( const char * _text );
+
+	static MusicalNote fromCode ( unsigned char _code );
+
+	static MusicalNote fromSemitone ( int _semitone );
+
+/*------------------------------------------------------------------*/
+
+	Note getNote () const;
+
+	Sign getSign () const;
+
+	unsigned char getCode () const;
+
+	// Semitones above A, 0 to 11
+	int getSemitone () const;
+
+	// Points to static storage, never allocates
+	const char * toString () const;
+
+/*------------------------------------------------------------------*/
+
+	bool operator == ( MusicalNote _n ) const;
+	bool operator != ( MusicalNote _n ) const;
+
+	MusicalNote & operator ++ ();
+	MusicalNote operator ++ ( int );
+	MusicalNote & operator -- ();
+	MusicalNote operator -- ( int );
+
+	MusicalNote & operator += ( int _semitones );
+	MusicalNote & operator -= ( int _semitones );
+	MusicalNote operator + ( int _semitones ) const;
+	MusicalNote operator - ( int _semitones ) const;
+
+	Interval operator - ( MusicalNote _base ) const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	friend class NoteSequence;
+
+	MusicalNote ();
+
+/*------------------------------------------------------------------*/
+
+	// Semitones above A per code, -1 for B#, Cb, E# and Fb
+	static constexpr signed char s_semitones[ CodesCount ] = {
+			0,  1, 11		// A
+		,	2, -1,  1		// B
+		,	3,  4, -1		// C
+		,	5,  6,  4		// D
+		,	7, -1,  6		// E
+		,	8,  9, -1		// F
+		,	10, 11, 9		// G
+	};
+
+	// Canonical, sharp-based code per semitone above A
+	static constexpr unsigned char s_semitoneCodes[ SemitonesInOctave ] = {
+		0, 1, 3, 6, 7, 9, 10, 12, 15, 16, 18, 19
+	};
+
+	static constexpr char s_names[ CodesCount ][ MaxStringLength ] = {
+			"A", "A#", "Ab"
+		,	"B", "",   "Bb"
+		,	"C", "C#", ""
+		,	"D", "D#", "Db"
+		,	"E", "",   "Eb"
+		,	"F", "F#", ""
+		,	"G", "G#", "Gb"
+	};
+
+/*------------------------------------------------------------------*/
+
+	unsigned char m_code;
 
 /*------------------------------------------------------------------*/
 
 };
 
 
+/*****************************************************************************/
+
+
+inline MusicalNote::MusicalNote ()
+	:	m_code( 0 )
+{
+}
+
+
+/*****************************************************************************/
+
+
+inline MusicalNote::Note MusicalNote::getNote () const
+{
+	return static_cast< Note >( m_code / 3 );
+}
+
+
+/*****************************************************************************/
+
+
+inline MusicalNote::Sign MusicalNote::getSign () const
+{
+	return static_cast< Sign >( m_code % 3 );
+}
+
+
+/*****************************************************************************/
+
+
+inline unsigned char MusicalNote::getCode () const
+{
+	return m_code;
+}
+
+
+/*****************************************************************************/
+
+
+inline int MusicalNote::getSemitone () const
+{
+	return s_semitones[ m_code ];
+}
+
+
+/*****************************************************************************/
+
+
+inline const char * MusicalNote::toString () const
+{
+	return s_names[ m_code ];
+}
+
+
+/*****************************************************************************/
+
+
+inline MusicalNote MusicalNote::fromSemitone ( int _semitone )
+{
+	int semitone = _semitone % SemitonesInOctave;
+	if ( semitone < 0 )
+		semitone += SemitonesInOctave;
+
+	MusicalNote result;
+	result.m_code = s_semitoneCodes[ semitone ];
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool MusicalNote::operator == ( MusicalNote _n ) const
+{
+	return getSemitone() == _n.getSemitone();
+}
+
+
+/*****************************************************************************/
+
+
+inline bool MusicalNote::operator != ( MusicalNote _n ) const
+{
+	return !( * this == _n );
+}
+
+
+/*****************************************************************************/
+
+
+inline MusicalNote & MusicalNote::operator ++ ()
+{
+	return * this += 1;
+}
+
+
+/*****************************************************************************/
+
+
+inline MusicalNote MusicalNote::operator ++ ( int )
+{
+	MusicalNote previous( * this );
+	++ * this;
+	return previous;
+}
+
+
+/*****************************************************************************/
+
+
+inline MusicalNote & MusicalNote::operator -- ()
+{
+	return * this -= 1;
+}
+
+
+/*****************************************************************************/
+
+
+inline MusicalNote MusicalNote::operator -- ( int )
+{
+	MusicalNote previous( * this );
+	-- * this;
+	return previous;
+}
+
+
+/*****************************************************************************/
+
+
+inline MusicalNote & MusicalNote::operator += ( int _semitones )
+{
+	* this = fromSemitone( getSemitone() + _semitones );
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+inline MusicalNote & MusicalNote::operator -= ( int _semitones )
+{
+	* this = fromSemitone( getSemitone() - _semitones );
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+inline MusicalNote MusicalNote::operator + ( int _semitones ) const
+{
+	return fromSemitone( getSemitone() + _semitones );
+}
+
+
+/*****************************************************************************/
+
+
+inline MusicalNote MusicalNote::operator - ( int _semitones ) const
+{
+	return fromSemitone( getSemitone() - _semitones );
+}
+
+
+/*****************************************************************************/
+
+
+inline MusicalNote::Interval MusicalNote::operator - ( MusicalNote _base ) const
+{
+	return static_cast< Interval >(
+		( getSemitone() - _base.getSemitone() + SemitonesInOctave ) % SemitonesInOctave
+	);
+}
+
+
 /*****************************************************************************/
 
 #endif //  _MUSICALNOTE_HPP_
@@ -5,6 +5,7 @@
 #include "testslib.hpp"
 
 #include "musicalnote.hpp"
+#include "note_sequence.hpp"
 
 /*****************************************************************************/
 
@@ -426,4 +427,117 @@ DECLARE_OOP_TEST( musicalnote_test_intervals )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( musicalnote_test_one_byte_encoding )
+{
+	assert( sizeof( MusicalNote ) == 1 );
+
+	MusicalNote n( MusicalNote::Note_G, MusicalNote::Sign_Flat );
+	MusicalNote decoded = MusicalNote::fromCode( n.getCode() );
+	assert( decoded.getNote() == MusicalNote::Note_G );
+	assert( decoded.getSign() == MusicalNote::Sign_Flat );
+
+	assert( MusicalNote::fromSemitone( 3 ).getNote() == MusicalNote::Note_C );
+	assert( MusicalNote::fromSemitone( -1 ) == MusicalNote( "G#" ) );
+
+	try
+	{
+		MusicalNote::fromCode( MusicalNote::CodesCount );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Invalid note" ) );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( musicalnote_test_sequence_parse_and_render )
+{
+	NoteSequence s( "A C#  Eb B" );
+	assert( s.getNotesCount() == 4 );
+	assert( s.getNote( 1 ) == MusicalNote( "Db" ) );
+	assert( s.getNote( 2 ).getSign() == MusicalNote::Sign_Flat );
+
+	assert( s.getRenderedLength() == 9 );
+	assert( s.toString() == "A C# Eb B" );
+
+	char buffer[ 10 ];
+	assert( s.render( buffer, sizeof( buffer ) ) == 9 );
+	assert( ! strcmp( buffer, "A C# Eb B" ) );
+
+	try
+	{
+		s.render( buffer, 9 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Buffer too small" ) );
+	}
+
+	assert( NoteSequence().toString() == "" );
+
+	const char * badScores[] = { "A B##", "A H", "Cb" };
+	for ( const char * score : badScores )
+	{
+		try
+		{
+			NoteSequence bad( score );
+			assert( ! "Exception must have been thrown" );
+		}
+		catch ( std::exception & )
+		{
+		}
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( musicalnote_test_sequence_transpose )
+{
+	NoteSequence s( "A C# Eb B G" );
+
+	for ( int shift = -25; shift <= 25; ++shift )
+	{
+		NoteSequence transposed( s );
+		transposed.transpose( shift );
+
+		for ( int i = 0; i < s.getNotesCount(); ++i )
+			assert( transposed.getNote( i ) == s.getNote( i ) + shift );
+	}
+
+	s.transpose( 3 );
+	assert( s.toString() == "C E F# D A#" );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( musicalnote_test_sequence_intervals )
+{
+	NoteSequence s( "A C E A Bb" );
+
+	MusicalNote::Interval steps[ 4 ];
+	s.computeSteps( steps );
+	assert( steps[ 0 ] == MusicalNote::Interval_Minor_Third );
+	assert( steps[ 1 ] == MusicalNote::Interval_Major_Third );
+	assert( steps[ 2 ] == MusicalNote::Interval_Fourth );
+	assert( steps[ 3 ] == MusicalNote::Interval_Minor_Second );
+
+	MusicalNote::Interval intervals[ 5 ];
+	s.computeIntervalsFrom( MusicalNote( "C" ), intervals );
+	for ( int i = 0; i < 5; ++i )
+		assert( intervals[ i ] == s.getNote( i ) - MusicalNote( "C" ) );
+}
+
+
 /*****************************************************************************/
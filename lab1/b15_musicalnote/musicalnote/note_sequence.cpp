@@ -0,0 +1,222 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "note_sequence.hpp"
+
+#include <stdexcept>
+
+/*****************************************************************************/
+
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+// Name length per code, matching MusicalNote::s_names
+constexpr unsigned char s_nameLengths[ MusicalNote::CodesCount ] = {
+		1, 2, 2
+	,	1, 0, 2
+	,	1, 2, 0
+	,	1, 2, 2
+	,	1, 0, 2
+	,	1, 2, 0
+	,	1, 2, 2
+};
+
+/*-----------------------------------------------------------------*/
+
+}
+
+/*****************************************************************************/
+
+
+NoteSequence::NoteSequence ()
+{
+}
+
+
+/*****************************************************************************/
+
+
+NoteSequence::NoteSequence ( const char * _score )
+{
+	append( _score );
+}
+
+
+/*****************************************************************************/
+
+
+NoteSequence::NoteSequence ( MusicalNote const * _pNotes, int _count )
+{
+	m_codes.reserve( _count );
+	for ( int i = 0; i < _count; ++i )
+		m_codes.push_back( _pNotes[ i ].m_code );
+}
+
+
+/*****************************************************************************/
+
+
+MusicalNote NoteSequence::getNote ( int _index ) const
+{
+	if ( _index < 0 || _index >= getNotesCount() )
+		throw std::logic_error( "Note index out of range" );
+
+	MusicalNote result;
+	result.m_code = m_codes[ _index ];
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+void NoteSequence::append ( const char * _score )
+{
+	const char * p = _score;
+	while ( * p )
+	{
+		if ( * p == ' ' )
+		{
+			++ p;
+			continue;
+		}
+
+		char name[ MusicalNote::MaxStringLength ];
+		int length = 0;
+		while ( p[ length ] && p[ length ] != ' ' )
+		{
+			if ( length == MusicalNote::MaxStringLength - 1 )
+				throw std::logic_error( "Invalid format" );
+
+			name[ length ] = p[ length ];
+			++ length;
+		}
+		name[ length ] = '\0';
+
+		m_codes.push_back( MusicalNote( name ).m_code );
+		p += length;
+	}
+}
+
+
+/*****************************************************************************/
+
+
+void NoteSequence::transpose ( int _semitones )
+{
+	int shift = _semitones % MusicalNote::SemitonesInOctave;
+	if ( shift < 0 )
+		shift += MusicalNote::SemitonesInOctave;
+
+	// One table per call turns the whole pass into a byte lookup per note
+	unsigned char codeMap[ MusicalNote::CodesCount ];
+	for ( int code = 0; code < MusicalNote::CodesCount; ++code )
+	{
+		int semitone = MusicalNote::s_semitones[ code ];
+		codeMap[ code ] = ( semitone < 0 )
+			?	static_cast< unsigned char >( code )
+			:	MusicalNote::s_semitoneCodes[ ( semitone + shift ) % MusicalNote::SemitonesInOctave ];
+	}
+
+	unsigned char * pCodes = m_codes.data();
+	const int nCodes = getNotesCount();
+	for ( int i = 0; i < nCodes; ++i )
+		pCodes[ i ] = codeMap[ pCodes[ i ] ];
+}
+
+
+/*****************************************************************************/
+
+
+void NoteSequence::computeSteps ( MusicalNote::Interval * _pResults ) const
+{
+	const int nCodes = getNotesCount();
+	for ( int i = 1; i < nCodes; ++i )
+	{
+		int difference = MusicalNote::s_semitones[ m_codes[ i ] ] - MusicalNote::s_semitones[ m_codes[ i - 1 ] ];
+		_pResults[ i - 1 ] = static_cast< MusicalNote::Interval >(
+			( difference + MusicalNote::SemitonesInOctave ) % MusicalNote::SemitonesInOctave
+		);
+	}
+}
+
+
+/*****************************************************************************/
+
+
+void NoteSequence::computeIntervalsFrom ( MusicalNote _base, MusicalNote::Interval * _pResults ) const
+{
+	// Precompute the interval for every code relative to the fixed base
+	MusicalNote::Interval intervals[ MusicalNote::CodesCount ];
+	for ( int code = 0; code < MusicalNote::CodesCount; ++code )
+		intervals[ code ] = static_cast< MusicalNote::Interval >(
+			( MusicalNote::s_semitones[ code ] - _base.getSemitone() + 2 * MusicalNote::SemitonesInOctave )
+			% MusicalNote::SemitonesInOctave
+		);
+
+	const int nCodes = getNotesCount();
+	for ( int i = 0; i < nCodes; ++i )
+		_pResults[ i ] = intervals[ m_codes[ i ] ];
+}
+
+
+/*****************************************************************************/
+
+
+int NoteSequence::getRenderedLength () const
+{
+	if ( m_codes.empty() )
+		return 0;
+
+	int length = getNotesCount() - 1;
+	for ( unsigned char code : m_codes )
+		length += s_nameLengths[ code ];
+
+	return length;
+}
+
+
+/*****************************************************************************/
+
+
+int NoteSequence::render ( char * _buffer, int _bufferSize ) const
+{
+	const int length = getRenderedLength();
+	if ( length >= _bufferSize )
+		throw std::logic_error( "Buffer too small" );
+
+	char * p = _buffer;
+	const int nCodes = getNotesCount();
+	for ( int i = 0; i < nCodes; ++i )
+	{
+		if ( i )
+			* p ++ = ' ';
+
+		const unsigned char code = m_codes[ i ];
+		const char * name = MusicalNote::s_names[ code ];
+
+		// Names are one or two characters long
+		p[ 0 ] = name[ 0 ];
+		p[ 1 ] = name[ 1 ];
+		p += s_nameLengths[ code ];
+	}
+	* p = '\0';
+
+	return length;
+}
+
+
+/*****************************************************************************/
+
+
+std::string NoteSequence::toString () const
+{
+	std::string result( getRenderedLength() + 1, '\0' );
+	render( & result[ 0 ], static_cast< int >( result.size() ) );
+	result.pop_back();
+	return result;
+}
+
+
+/*****************************************************************************/
@@ -0,0 +1,100 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _NOTE_SEQUENCE_HPP_
+#define _NOTE_SEQUENCE_HPP_
+
+/*****************************************************************************/
+
+#include "musicalnote.hpp"
+
+#include <vector>
+#include <string>
+
+/*****************************************************************************/
+
+/*
+	A score stored as one byte per note, using the MusicalNote encoding.
+	Bulk operations work on the raw codes through small lookup tables,
+	so no MusicalNote objects or per-note strings are created.
+*/
+
+class NoteSequence
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*------------------------------------------------------------------*/
+
+	NoteSequence ();
+
+	// Note names separated by spaces, e.g. "A C# Eb"
+	explicit NoteSequence ( const char * _score );
+
+	NoteSequence ( MusicalNote const * _pNotes, int _count );
+
+/*------------------------------------------------------------------*/
+
+	int getNotesCount () const;
+
+	MusicalNote getNote ( int _index ) const;
+
+	void addNote ( MusicalNote _note );
+
+	void append ( const char * _score );
+
+/*------------------------------------------------------------------*/
+
+	void transpose ( int _semitones );
+
+	// Writes getNotesCount() - 1 intervals between neighbouring notes
+	void computeSteps ( MusicalNote::Interval * _pResults ) const;
+
+	// Writes getNotesCount() intervals, each note measured from _base
+	void computeIntervalsFrom ( MusicalNote _base, MusicalNote::Interval * _pResults ) const;
+
+/*------------------------------------------------------------------*/
+
+	// Length of the rendered score, without '\0'
+	int getRenderedLength () const;
+
+	// Writes the space separated score into the caller's buffer, returns its length
+	int render ( char * _buffer, int _bufferSize ) const;
+
+	std::string toString () const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	std::vector< unsigned char > m_codes;
+
+/*------------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline int NoteSequence::getNotesCount () const
+{
+	return static_cast< int >( m_codes.size() );
+}
+
+
+/*****************************************************************************/
+
+
+inline void NoteSequence::addNote ( MusicalNote _note )
+{
+	m_codes.push_back( _note.m_code );
+}
+
+
+/*****************************************************************************/
+
+#endif //  _NOTE_SEQUENCE_HPP_
@@ -3,10 +3,178 @@
 #include "numeric_range.hpp"
 
 #include <stdexcept>
+#include <cstdio>
+#include <algorithm>
 
 /*****************************************************************************/
 
-// TODO ...
+
+NumericRange::NumericRange ()
+	:	m_lowBound( 0 ), m_highBound( 0 )
+{
+}
+
+
+/*****************************************************************************/
+
+
+NumericRange::NumericRange ( int _lowBound, int _highBound )
+	:	m_lowBound( _lowBound ), m_highBound( _highBound )
+{
+	if ( m_lowBound > m_highBound )
+		throw std::logic_error( "Low bound higher than high bound" );
+}
+
+
+/*****************************************************************************/
+
+
+NumericRange::NumericRange ( const char * _text )
+{
+	char openBracket, separator, closeBracket;
+	int nConsumed = 0;
+	int nMatched = sscanf(
+			_text
+		,	"%c%d%c%d%c%n"
+		,	& openBracket, & m_lowBound, & separator, & m_highBound, & closeBracket, & nConsumed
+	);
+
+	if ( nMatched != 5 || _text[ nConsumed ] != '\0'
+		|| openBracket != '[' || separator != ':' || closeBracket != ']' )
+		throw std::logic_error( "Invalid format" );
+
+	if ( m_lowBound > m_highBound )
+		throw std::logic_error( "Low bound higher than high bound" );
+}
+
+
+/*****************************************************************************/
+
+
+NumericRange::ChunkedView::ChunkedView ( NumericRange _r, int _chunkSize )
+	:	m_first( _r.getLowBound() ), m_last( _r.getHighBound() ), m_chunkSize( _chunkSize )
+{
+	if ( _chunkSize <= 0 )
+		throw std::logic_error( "Chunk size must be positive" );
+}
+
+
+/*****************************************************************************/
+
+
+void NumericRange::containsMany ( int const * _pValues, int _count, unsigned char * _pResults ) const
+{
+	// low <= x <= high folds into a single unsigned compare: x - low <= high - low
+	const unsigned low = static_cast< unsigned >( m_lowBound );
+	const unsigned span = static_cast< unsigned >( m_highBound ) - low;
+
+	for ( int i = 0; i < _count; ++i )
+		_pResults[ i ] = ( static_cast< unsigned >( _pValues[ i ] ) - low ) <= span;
+}
+
+
+/*****************************************************************************/
+
+
+int NumericRange::countContained ( int const * _pValues, int _count ) const
+{
+	const unsigned low = static_cast< unsigned >( m_lowBound );
+	const unsigned span = static_cast< unsigned >( m_highBound ) - low;
+
+	int result = 0;
+	for ( int i = 0; i < _count; ++i )
+		result += ( static_cast< unsigned >( _pValues[ i ] ) - low ) <= span;
+
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+void NumericRange::containsMany (
+		NumericRange const * _pSortedRanges
+	,	int _rangesCount
+	,	int const * _pValues
+	,	int _count
+	,	unsigned char * _pResults
+)
+{
+	// Short lists: one vectorized compare pass per range
+	const int ShortListSize = 8;
+
+	if ( _rangesCount <= ShortListSize )
+	{
+		std::fill( _pResults, _pResults + _count, 0 );
+
+		for ( int r = 0; r < _rangesCount; ++r )
+		{
+			const unsigned low = static_cast< unsigned >( _pSortedRanges[ r ].m_lowBound );
+			const unsigned span = static_cast< unsigned >( _pSortedRanges[ r ].m_highBound ) - low;
+
+			for ( int i = 0; i < _count; ++i )
+				_pResults[ i ] |= ( static_cast< unsigned >( _pValues[ i ] ) - low ) <= span;
+		}
+
+		return;
+	}
+
+	// Long lists: branch-free binary search for the last range starting at or before the value
+	for ( int i = 0; i < _count; ++i )
+	{
+		const int value = _pValues[ i ];
+
+		NumericRange const * pBase = _pSortedRanges;
+		int length = _rangesCount;
+		while ( length > 1 )
+		{
+			int half = length / 2;
+			pBase = ( pBase[ half ].m_lowBound <= value ) ? pBase + half : pBase;
+			length -= half;
+		}
+
+		_pResults[ i ] = pBase->contains( value );
+	}
+}
+
 
 /*****************************************************************************/
 
+
+std::vector< NumericRange > NumericRange::coalesce ( std::vector< NumericRange > _ranges )
+{
+	if ( _ranges.empty() )
+		return _ranges;
+
+	if ( ! std::is_sorted( _ranges.begin(), _ranges.end() ) )
+		std::sort( _ranges.begin(), _ranges.end() );
+
+	// Merge in place: the output never overtakes the input
+	size_t last = 0;
+	for ( size_t i = 1; i < _ranges.size(); ++i )
+	{
+		NumericRange & current = _ranges[ last ];
+		NumericRange next = _ranges[ i ];
+
+		if ( next.m_lowBound <= static_cast< long long >( current.m_highBound ) + 1 )
+			current.m_highBound = std::max( current.m_highBound, next.m_highBound );
+
+		else
+			_ranges[ ++ last ] = next;
+	}
+
+	_ranges.resize( last + 1 );
+	return _ranges;
+}
+
+
+/*****************************************************************************/
+
+
+std::ostream & operator << ( std::ostream & _o, NumericRange _r )
+{
+	return _o << '[' << _r.getLowBound() << ':' << _r.getHighBound() << ']';
+}
+
+
+/*****************************************************************************/
@@ -6,6 +6,7 @@
 /*****************************************************************************/
 
 #include <iostream>
+#include <vector>
 
 /*****************************************************************************/
 
@@ -19,7 +20,182 @@ public:
 
 /*------------------------------------------------------------------*/
 
-	// TODO ...
+	class Iterator
+	{
+	public:
+
+		explicit Iterator ( long long _current )
+			:	m_current( _current )
+		{
+		}
+
+		int operator * () const
+		{
+			return static_cast< int >( m_current );
+		}
+
+		Iterator & operator ++ ()
+		{
+			++ m_current;
+			return * this;
+		}
+
+		bool operator == ( Iterator _it ) const
+		{
+			return m_current == _it.m_current;
+		}
+
+		bool operator != ( Iterator _it ) const
+		{
+			return m_current != _it.m_current;
+		}
+
+	private:
+
+		// Wide enough to step past INT_MAX without overflowing
+		long long m_current;
+	};
+
+/*------------------------------------------------------------------*/
+
+	// A run of consecutive values; loops over [0, m_count) have a known
+	// trip count and no per-element bound check, so they vectorize
+	struct Chunk
+	{
+		int m_first;
+		int m_count;
+	};
+
+	class ChunkIterator
+	{
+	public:
+
+		ChunkIterator ( long long _current, long long _last, int _chunkSize )
+			:	m_current( _current ), m_last( _last ), m_chunkSize( _chunkSize )
+		{
+		}
+
+		Chunk operator * () const
+		{
+			long long remaining = m_last - m_current + 1;
+			Chunk c;
+			c.m_first = static_cast< int >( m_current );
+			c.m_count = static_cast< int >( remaining < m_chunkSize ? remaining : m_chunkSize );
+			return c;
+		}
+
+		ChunkIterator & operator ++ ()
+		{
+			m_current += m_chunkSize;
+			if ( m_current > m_last )
+				m_current = m_last + 1;
+			return * this;
+		}
+
+		bool operator == ( ChunkIterator const & _it ) const
+		{
+			return m_current == _it.m_current;
+		}
+
+		bool operator != ( ChunkIterator const & _it ) const
+		{
+			return m_current != _it.m_current;
+		}
+
+	private:
+
+		long long m_current, m_last;
+		int m_chunkSize;
+	};
+
+	class ChunkedView
+	{
+	public:
+
+		ChunkedView ( NumericRange _r, int _chunkSize );
+
+		ChunkIterator begin () const;
+
+		ChunkIterator end () const;
+
+	private:
+
+		const long long m_first, m_last;
+		const int m_chunkSize;
+	};
+
+/*------------------------------------------------------------------*/
+
+	NumericRange ();
+
+	NumericRange ( int _lowBound, int _highBound );
+
+	NumericRange ( const char * _text );
+
+/*------------------------------------------------------------------*/
+
+	int getLowBound () const;
+
+	int getHighBound () const;
+
+	long long getWidth () const;
+
+/*------------------------------------------------------------------*/
+
+	bool contains ( int _value ) const;
+
+	bool intersectsWith ( NumericRange _r ) const;
+
+	bool includes ( NumericRange _r ) const;
+
+	bool adjacentTo ( NumericRange _r ) const;
+
+	bool belongsTo ( NumericRange _r ) const;
+
+/*------------------------------------------------------------------*/
+
+	bool operator == ( NumericRange _r ) const;
+	bool operator != ( NumericRange _r ) const;
+	bool operator < ( NumericRange _r ) const;
+	bool operator <= ( NumericRange _r ) const;
+	bool operator > ( NumericRange _r ) const;
+	bool operator >= ( NumericRange _r ) const;
+
+/*------------------------------------------------------------------*/
+
+	Iterator begin () const;
+
+	Iterator end () const;
+
+	ChunkedView chunks ( int _chunkSize ) const;
+
+/*------------------------------------------------------------------*/
+
+	// Writes 1 or 0 per value into _pResults
+	void containsMany ( int const * _pValues, int _count, unsigned char * _pResults ) const;
+
+	int countContained ( int const * _pValues, int _count ) const;
+
+	// Tests values against a sorted list of disjoint ranges, such as coalesce() returns
+	static void containsMany (
+			NumericRange const * _pSortedRanges
+		,	int _rangesCount
+		,	int const * _pValues
+		,	int _count
+		,	unsigned char * _pResults
+	);
+
+	// Sorts and sweeps the ranges into a minimal disjoint set,
+	// merging both overlapping and adjacent ranges
+	static std::vector< NumericRange > coalesce ( std::vector< NumericRange > _ranges );
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	int m_lowBound, m_highBound;
 
 /*------------------------------------------------------------------*/
 
@@ -29,4 +205,166 @@ public:
 /*****************************************************************************/
 
 
+inline int NumericRange::getLowBound () const
+{
+	return m_lowBound;
+}
+
+
+/*****************************************************************************/
+
+
+inline int NumericRange::getHighBound () const
+{
+	return m_highBound;
+}
+
+
+/*****************************************************************************/
+
+
+inline long long NumericRange::getWidth () const
+{
+	return static_cast< long long >( m_highBound ) - m_lowBound + 1;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool NumericRange::contains ( int _value ) const
+{
+	return m_lowBound <= _value && _value <= m_highBound;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool NumericRange::intersectsWith ( NumericRange _r ) const
+{
+	return m_lowBound <= _r.m_highBound && _r.m_lowBound <= m_highBound;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool NumericRange::includes ( NumericRange _r ) const
+{
+	return m_lowBound <= _r.m_lowBound && _r.m_highBound <= m_highBound;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool NumericRange::adjacentTo ( NumericRange _r ) const
+{
+	return static_cast< long long >( m_highBound ) + 1 == _r.m_lowBound
+		|| static_cast< long long >( _r.m_highBound ) + 1 == m_lowBound;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool NumericRange::belongsTo ( NumericRange _r ) const
+{
+	return _r.includes( * this );
+}
+
+
+/*****************************************************************************/
+
+
+inline bool NumericRange::operator == ( NumericRange _r ) const
+{
+	return m_lowBound == _r.m_lowBound && m_highBound == _r.m_highBound;
+}
+
+
+inline bool NumericRange::operator != ( NumericRange _r ) const
+{
+	return !( * this == _r );
+}
+
+
+inline bool NumericRange::operator < ( NumericRange _r ) const
+{
+	return m_lowBound < _r.m_lowBound
+		|| ( m_lowBound == _r.m_lowBound && m_highBound < _r.m_highBound );
+}
+
+
+inline bool NumericRange::operator <= ( NumericRange _r ) const
+{
+	return !( _r < * this );
+}
+
+
+inline bool NumericRange::operator > ( NumericRange _r ) const
+{
+	return _r < * this;
+}
+
+
+inline bool NumericRange::operator >= ( NumericRange _r ) const
+{
+	return !( * this < _r );
+}
+
+
+/*****************************************************************************/
+
+
+inline NumericRange::Iterator NumericRange::begin () const
+{
+	return Iterator( m_lowBound );
+}
+
+
+/*****************************************************************************/
+
+
+inline NumericRange::Iterator NumericRange::end () const
+{
+	return Iterator( static_cast< long long >( m_highBound ) + 1 );
+}
+
+
+/*****************************************************************************/
+
+
+inline NumericRange::ChunkedView NumericRange::chunks ( int _chunkSize ) const
+{
+	return ChunkedView( * this, _chunkSize );
+}
+
+
+/*****************************************************************************/
+
+
+inline NumericRange::ChunkIterator NumericRange::ChunkedView::begin () const
+{
+	return ChunkIterator( m_first, m_last, m_chunkSize );
+}
+
+
+/*****************************************************************************/
+
+
+inline NumericRange::ChunkIterator NumericRange::ChunkedView::end () const
+{
+	return ChunkIterator( m_last + 1, m_last, m_chunkSize );
+}
+
+
+/*****************************************************************************/
+
+std::ostream & operator << ( std::ostream & _o, NumericRange _r );
+
+/*****************************************************************************/
+
+
 #endif //  _NUMERIC_RANGE_HPP_
@@ -0,0 +1,165 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "numeric_range_set.hpp"
+
+#include <algorithm>
+
+/*****************************************************************************/
+
+
+NumericRangeSet::NumericRangeSet ()
+	:	m_rootLevel( 0 ), m_indexed( true )
+{
+}
+
+
+/*****************************************************************************/
+
+
+NumericRangeSet::NumericRangeSet ( std::vector< NumericRange > _ranges )
+	:	m_ranges( std::move( _ranges ) ), m_rootLevel( 0 ), m_indexed( false )
+{
+}
+
+
+/*****************************************************************************/
+
+
+void NumericRangeSet::insert ( NumericRange _r )
+{
+	m_ranges.push_back( _r );
+	m_indexed = false;
+}
+
+
+/*****************************************************************************/
+
+
+void NumericRangeSet::insert ( NumericRange const * _pRanges, int _count )
+{
+	m_ranges.insert( m_ranges.end(), _pRanges, _pRanges + _count );
+	m_indexed = false;
+}
+
+
+/*****************************************************************************/
+
+
+void NumericRangeSet::clear ()
+{
+	m_ranges.clear();
+	m_subtreeHighBounds.clear();
+	m_rootLevel = 0;
+	m_indexed = true;
+}
+
+
+/*****************************************************************************/
+
+
+bool NumericRangeSet::anyContains ( int _value ) const
+{
+	bool found = false;
+	forEachOverlapping(
+			NumericRange( _value, _value )
+		,	[ & ] ( NumericRange ) { found = true; return false; }
+	);
+	return found;
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< NumericRange > NumericRangeSet::findContaining ( int _value ) const
+{
+	return findOverlapping( NumericRange( _value, _value ) );
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< NumericRange > NumericRangeSet::findOverlapping ( NumericRange _r ) const
+{
+	std::vector< NumericRange > result;
+	forEachOverlapping(
+			_r
+		,	[ & ] ( NumericRange _found ) { result.push_back( _found ); return true; }
+	);
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+NumericRangeSet NumericRangeSet::merged () const
+{
+	// Ranges are already sorted here, so coalescing is a single sweep
+	prepareIndex();
+	return NumericRangeSet( NumericRange::coalesce( m_ranges ) );
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< NumericRange > const & NumericRangeSet::getRanges () const
+{
+	prepareIndex();
+	return m_ranges;
+}
+
+
+/*****************************************************************************/
+
+
+void NumericRangeSet::prepareIndex () const
+{
+	if ( m_indexed )
+		return;
+
+	std::sort( m_ranges.begin(), m_ranges.end() );
+
+	const int nRanges = getRangesCount();
+	m_subtreeHighBounds.resize( nRanges );
+	m_rootLevel = 0;
+	m_indexed = true;
+
+	if ( ! nRanges )
+		return;
+
+	// Leaves: even indices hold level 0 nodes
+	int lastNode = 0, lastHigh = 0;
+	for ( int i = 0; i < nRanges; i += 2 )
+	{
+		lastNode = i;
+		lastHigh = m_subtreeHighBounds[ i ] = m_ranges[ i ].getHighBound();
+	}
+
+	// Inner nodes bottom-up; lastHigh tracks the rightmost, possibly incomplete, subtree
+	// so that nodes whose right child lies past the end still see its ranges
+	int level = 1;
+	for ( ; ( 1LL << level ) <= nRanges; ++level )
+	{
+		int half = 1 << ( level - 1 );
+		int step = half << 2;
+
+		for ( int i = ( half << 1 ) - 1; i < nRanges; i += step )
+		{
+			int leftHigh = m_subtreeHighBounds[ i - half ];
+			int rightHigh = ( i + half < nRanges ) ? m_subtreeHighBounds[ i + half ] : lastHigh;
+			m_subtreeHighBounds[ i ] = std::max( m_ranges[ i ].getHighBound(), std::max( leftHigh, rightHigh ) );
+		}
+
+		lastNode = ( ( lastNode >> level ) & 1 ) ? lastNode - half : lastNode + half;
+		if ( lastNode < nRanges && m_subtreeHighBounds[ lastNode ] > lastHigh )
+			lastHigh = m_subtreeHighBounds[ lastNode ];
+	}
+
+	m_rootLevel = level - 1;
+}
+
+
+/*****************************************************************************/
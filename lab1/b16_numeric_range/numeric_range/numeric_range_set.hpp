@@ -0,0 +1,170 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _NUMERIC_RANGE_SET_HPP_
+#define _NUMERIC_RANGE_SET_HPP_
+
+/*****************************************************************************/
+
+#include "numeric_range.hpp"
+
+#include <vector>
+
+/*****************************************************************************/
+
+/*
+	Index over a large collection of ranges.
+
+	Ranges are kept sorted by their low bound, and the sorted array doubles as
+	an implicit balanced binary tree: the node at index i sits at the level equal
+	to the number of trailing 1-bits in i. Every node caches the highest bound of
+	its subtree, which lets overlap queries skip subtrees that end too early and
+	answer in O(log n + k).
+
+	Insertions are appended and the index is rebuilt lazily by the next query,
+	so bulk loading costs a single sort. Queries on a set with pending
+	insertions are not safe to run concurrently.
+*/
+
+class NumericRangeSet
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*------------------------------------------------------------------*/
+
+	NumericRangeSet ();
+
+	explicit NumericRangeSet ( std::vector< NumericRange > _ranges );
+
+/*------------------------------------------------------------------*/
+
+	int getRangesCount () const;
+
+	void insert ( NumericRange _r );
+
+	void insert ( NumericRange const * _pRanges, int _count );
+
+	void clear ();
+
+/*------------------------------------------------------------------*/
+
+	bool anyContains ( int _value ) const;
+
+	std::vector< NumericRange > findContaining ( int _value ) const;
+
+	std::vector< NumericRange > findOverlapping ( NumericRange _r ) const;
+
+	// Calls _callback( NumericRange ) for each stored range overlapping _r, in sorted order;
+	// returning false from the callback stops the search
+	template< typename _Callback >
+	void forEachOverlapping ( NumericRange _r, _Callback _callback ) const;
+
+	// Coalesces overlapping and adjacent ranges into a minimal disjoint set
+	NumericRangeSet merged () const;
+
+	// Stored ranges, sorted by low bound, then by high bound
+	std::vector< NumericRange > const & getRanges () const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	void prepareIndex () const;
+
+/*------------------------------------------------------------------*/
+
+	// Subtrees of 2^(LinearScanLevel+1) - 1 ranges are scanned without descending
+	static const int LinearScanLevel = 3;
+
+	mutable std::vector< NumericRange > m_ranges;
+
+	mutable std::vector< int > m_subtreeHighBounds;
+
+	mutable int m_rootLevel;
+
+	mutable bool m_indexed;
+
+/*------------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline int NumericRangeSet::getRangesCount () const
+{
+	return static_cast< int >( m_ranges.size() );
+}
+
+
+/*****************************************************************************/
+
+
+template< typename _Callback >
+void NumericRangeSet::forEachOverlapping ( NumericRange _r, _Callback _callback ) const
+{
+	prepareIndex();
+
+	const int nRanges = getRangesCount();
+	if ( ! nRanges )
+		return;
+
+	const int queryLow = _r.getLowBound(), queryHigh = _r.getHighBound();
+
+	struct Frame
+	{
+		int m_node, m_level;
+		bool m_leftVisited;
+	};
+
+	Frame stack[ 64 ];
+	int stackSize = 0;
+	stack[ stackSize ++ ] = Frame{ ( 1 << m_rootLevel ) - 1, m_rootLevel, false };
+
+	while ( stackSize )
+	{
+		Frame frame = stack[ -- stackSize ];
+
+		if ( frame.m_level <= LinearScanLevel )
+		{
+			int first = frame.m_node >> frame.m_level << frame.m_level;
+			int last = first + ( 1 << ( frame.m_level + 1 ) ) - 1;
+			if ( last > nRanges )
+				last = nRanges;
+
+			for ( int i = first; i < last && m_ranges[ i ].getLowBound() <= queryHigh; ++i )
+				if ( queryLow <= m_ranges[ i ].getHighBound() && ! _callback( m_ranges[ i ] ) )
+					return;
+		}
+
+		else if ( ! frame.m_leftVisited )
+		{
+			int left = frame.m_node - ( 1 << ( frame.m_level - 1 ) );
+			stack[ stackSize ++ ] = Frame{ frame.m_node, frame.m_level, true };
+
+			// A left child past the end still has real ranges below it
+			if ( left >= nRanges || m_subtreeHighBounds[ left ] >= queryLow )
+				stack[ stackSize ++ ] = Frame{ left, frame.m_level - 1, false };
+		}
+
+		else if ( frame.m_node < nRanges && m_ranges[ frame.m_node ].getLowBound() <= queryHigh )
+		{
+			if ( queryLow <= m_ranges[ frame.m_node ].getHighBound() && ! _callback( m_ranges[ frame.m_node ] ) )
+				return;
+
+			int right = frame.m_node + ( 1 << ( frame.m_level - 1 ) );
+			stack[ stackSize ++ ] = Frame{ right, frame.m_level - 1, false };
+		}
+	}
+}
+
+
+/*****************************************************************************/
+
+
+#endif //  _NUMERIC_RANGE_SET_HPP_
@@ -6,9 +6,11 @@
 #include "utils.hpp"
 
 #include "numeric_range.hpp"
+#include "numeric_range_set.hpp"
 
 #include <sstream>
 #include <vector>
+#include <climits>
 
 /*****************************************************************************/
 
@@ -356,4 +358,180 @@ DECLARE_OOP_TEST( numeric_range_test_stream_output )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( numeric_range_set_test_queries_match_linear_scan )
+{
+	std::vector< NumericRange > ranges;
+	unsigned seed = 12345;
+	for ( int i = 0; i < 1000; ++i )
+	{
+		seed = seed * 1103515245 + 12345;
+		int low = ( seed >> 8 ) % 10000;
+		int width = ( seed >> 20 ) % ( i % 10 == 0 ? 500 : 20 );
+		ranges.push_back( NumericRange( low, low + width ) );
+	}
+
+	NumericRangeSet set( ranges );
+	assert( set.getRangesCount() == 1000 );
+
+	std::sort( ranges.begin(), ranges.end() );
+	assert( set.getRanges() == ranges );
+
+	for ( int x = -5; x < 10600; x += 7 )
+	{
+		std::vector< NumericRange > expected;
+		for ( NumericRange r : ranges )
+			if ( r.contains( x ) )
+				expected.push_back( r );
+
+		assert( set.findContaining( x ) == expected );
+		assert( set.anyContains( x ) == ! expected.empty() );
+	}
+
+	for ( int low = -50; low < 10600; low += 97 )
+	{
+		NumericRange query( low, low + 40 );
+
+		std::vector< NumericRange > expected;
+		for ( NumericRange r : ranges )
+			if ( r.intersectsWith( query ) )
+				expected.push_back( r );
+
+		assert( set.findOverlapping( query ) == expected );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( numeric_range_set_test_insert_and_merge )
+{
+	NumericRangeSet set;
+	assert( set.findContaining( 1 ).empty() );
+	assert( set.merged().getRangesCount() == 0 );
+
+	set.insert( NumericRange( 10, 12 ) );
+	set.insert( NumericRange( 1, 3 ) );
+	set.insert( NumericRange( 4, 5 ) );
+	set.insert( NumericRange( 11, 20 ) );
+	set.insert( NumericRange( 30, 30 ) );
+
+	std::vector< NumericRange > containing11 = { NumericRange( 10, 12 ), NumericRange( 11, 20 ) };
+	assert( set.findContaining( 11 ) == containing11 );
+	assert( ! set.anyContains( 25 ) );
+
+	std::vector< NumericRange > mergedPattern = { NumericRange( 1, 5 ), NumericRange( 10, 20 ), NumericRange( 30, 30 ) };
+	assert( set.merged().getRanges() == mergedPattern );
+
+	set.clear();
+	assert( set.getRangesCount() == 0 );
+	assert( ! set.anyContains( 11 ) );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( numeric_range_test_chunked_loop )
+{
+	NumericRange r( -3, 1000 );
+
+	std::vector< int > result;
+	int nChunks = 0;
+	for ( NumericRange::Chunk c : r.chunks( 64 ) )
+	{
+		assert( c.m_count > 0 && c.m_count <= 64 );
+		for ( int i = 0; i < c.m_count; ++i )
+			result.push_back( c.m_first + i );
+		++ nChunks;
+	}
+
+	std::vector< int > pattern;
+	for ( int x : r )
+		pattern.push_back( x );
+
+	assert( result == pattern );
+	assert( nChunks == 16 );
+
+	std::vector< int > singleResult, singlePattern = { 3 };
+	for ( NumericRange::Chunk c : NumericRange( 3, 3 ).chunks( 8 ) )
+		for ( int i = 0; i < c.m_count; ++i )
+			singleResult.push_back( c.m_first + i );
+	assert( singleResult == singlePattern );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( numeric_range_test_contains_many )
+{
+	std::vector< int > values;
+	for ( int x = -100; x <= 100; ++x )
+		values.push_back( x );
+	values.push_back( INT_MIN );
+	values.push_back( INT_MAX );
+
+	NumericRange r( -5, 17 );
+	std::vector< unsigned char > results( values.size() );
+	r.containsMany( values.data(), ( int ) values.size(), results.data() );
+
+	for ( size_t i = 0; i < values.size(); ++i )
+		assert( results[ i ] == r.contains( values[ i ] ) );
+
+	assert( r.countContained( values.data(), ( int ) values.size() ) == 23 );
+	assert( NumericRange( INT_MIN, INT_MAX ).countContained( values.data(), ( int ) values.size() ) == ( int ) values.size() );
+
+	for ( int nRanges : { 0, 3, 20 } )
+	{
+		std::vector< NumericRange > ranges;
+		for ( int i = 0; i < nRanges; ++i )
+			ranges.push_back( NumericRange( -90 + i * 9, -90 + i * 9 + i % 4 ) );
+
+		NumericRange::containsMany( ranges.data(), nRanges, values.data(), ( int ) values.size(), results.data() );
+
+		for ( size_t i = 0; i < values.size(); ++i )
+		{
+			bool expected = false;
+			for ( NumericRange range : ranges )
+				expected = expected || range.contains( values[ i ] );
+
+			assert( results[ i ] == expected );
+		}
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( numeric_range_test_coalesce )
+{
+	std::vector< NumericRange > ranges = {
+			NumericRange( 20, 25 )
+		,	NumericRange( 1, 3 )
+		,	NumericRange( 8, 9 )
+		,	NumericRange( 4, 6 )
+		,	NumericRange( 22, 30 )
+		,	NumericRange( 2, 2 )
+		,	NumericRange( 10, 10 )
+		,	NumericRange( INT_MAX, INT_MAX )
+	};
+
+	std::vector< NumericRange > pattern = {
+			NumericRange( 1, 6 )
+		,	NumericRange( 8, 10 )
+		,	NumericRange( 20, 30 )
+		,	NumericRange( INT_MAX, INT_MAX )
+	};
+
+	assert( NumericRange::coalesce( ranges ) == pattern );
+	assert( NumericRange::coalesce( pattern ) == pattern );
+	assert( NumericRange::coalesce( std::vector< NumericRange >() ).empty() );
+}
+
+
 /*****************************************************************************/
@@ -4,6 +4,137 @@
 
 /*****************************************************************************/
 
-// ... TODO ...
+
+Triangle::Triangle ( double _x1, double _y1, double _x2, double _y2, double _x3, double _y3 )
+    :    m_p1( _x1, _y1 ), m_p2( _x2, _y2 ), m_p3( _x3, _y3 )
+{
+}
+
+
+/*****************************************************************************/
+
+
+Triangle::Triangle ( Point const & _p1, Point const & _p2, Point const & _p3 )
+    :    m_p1( _p1 ), m_p2( _p2 ), m_p3( _p3 )
+{
+}
+
+
+/*****************************************************************************/
+
+
+double Triangle::getPerimeter () const
+{
+    return getSide12Length() + getSide13Length() + getSide23Length();
+}
+
+
+/*****************************************************************************/
+
+
+double Triangle::getArea () const
+{
+    double cross =
+            ( m_p2.m_x - m_p1.m_x ) * ( m_p3.m_y - m_p1.m_y )
+        -   ( m_p2.m_y - m_p1.m_y ) * ( m_p3.m_x - m_p1.m_x );
+
+    return fabs( cross ) * 0.5;
+}
+
+
+/*****************************************************************************/
+
+
+double Triangle::angleOpposite ( double _opposite, double _side1, double _side2 )
+{
+    double cosine = ( _side1 * _side1 + _side2 * _side2 - _opposite * _opposite ) / ( 2.0 * _side1 * _side2 );
+
+    // Rounding may push the cosine of a degenerate triangle slightly outside [-1, 1]
+    if ( cosine > 1.0 )
+        cosine = 1.0;
+    else if ( cosine < -1.0 )
+        cosine = -1.0;
+
+    return acos( cosine );
+}
+
+
+/*****************************************************************************/
+
+
+double Triangle::getAngle1 () const
+{
+    return angleOpposite( getSide23Length(), getSide12Length(), getSide13Length() );
+}
+
+
+/*****************************************************************************/
+
+
+double Triangle::getAngle2 () const
+{
+    return angleOpposite( getSide13Length(), getSide12Length(), getSide23Length() );
+}
+
+
+/*****************************************************************************/
+
+
+double Triangle::getAngle3 () const
+{
+    return angleOpposite( getSide12Length(), getSide13Length(), getSide23Length() );
+}
+
+
+/*****************************************************************************/
+
+
+bool Triangle::isRectangular () const
+{
+    double side12 = squaredDistance( m_p1, m_p2 );
+    double side13 = squaredDistance( m_p1, m_p3 );
+    double side23 = squaredDistance( m_p2, m_p3 );
+
+    return equalDoubles( side12 + side13, side23 )
+        || equalDoubles( side12 + side23, side13 )
+        || equalDoubles( side13 + side23, side12 );
+}
+
+
+/*****************************************************************************/
+
+
+bool Triangle::isIsosceles () const
+{
+    double side12 = getSide12Length();
+    double side13 = getSide13Length();
+    double side23 = getSide23Length();
+
+    return equalDoubles( side12, side13 )
+        || equalDoubles( side12, side23 )
+        || equalDoubles( side13, side23 );
+}
+
+
+/*****************************************************************************/
+
+
+bool Triangle::isEquilateral () const
+{
+    double side13 = getSide13Length();
+
+    return equalDoubles( getSide12Length(), side13 )
+        && equalDoubles( side13, getSide23Length() );
+}
+
+
+/*****************************************************************************/
+
+
+bool Triangle::operator == ( Triangle const & _t ) const
+{
+    return m_p1 == _t.m_p1 && m_p2 == _t.m_p2 && m_p3 == _t.m_p3;
+}
+
 
 /*****************************************************************************/
@@ -15,13 +15,151 @@ class Triangle
 
 /*-----------------------------------------------------------------*/
 
-    // ... TODO ...
+public:
+
+/*------------------------------------------------------------------*/
+
+    Triangle ( double _x1, double _y1, double _x2, double _y2, double _x3, double _y3 );
+
+    Triangle ( Point const & _p1, Point const & _p2, Point const & _p3 );
+
+/*------------------------------------------------------------------*/
+
+    Point const & getPoint1 () const;
+
+    Point const & getPoint2 () const;
+
+    Point const & getPoint3 () const;
+
+/*------------------------------------------------------------------*/
+
+    double getSide12Length () const;
+
+    double getSide13Length () const;
+
+    double getSide23Length () const;
+
+    double getPerimeter () const;
+
+    double getArea () const;
+
+    // Angles in radians at the corresponding vertex
+    double getAngle1 () const;
+
+    double getAngle2 () const;
+
+    double getAngle3 () const;
+
+/*------------------------------------------------------------------*/
+
+    // Squared sides satisfy Pythagoras within equalDoubles tolerance
+    bool isRectangular () const;
+
+    // Some two sides are equal within equalDoubles tolerance
+    bool isIsosceles () const;
+
+    // Side 1-2 equals side 1-3, and side 1-3 equals side 2-3
+    bool isEquilateral () const;
+
+/*------------------------------------------------------------------*/
+
+    bool operator == ( Triangle const & _t ) const;
+
+    bool operator != ( Triangle const & _t ) const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+    static double squaredDistance ( Point const & _p1, Point const & _p2 );
+
+    static double angleOpposite ( double _opposite, double _side1, double _side2 );
+
+/*------------------------------------------------------------------*/
+
+    const Point m_p1, m_p2, m_p3;
 
 /*------------------------------------------------------------------*/
 
 };
 
 
+/*****************************************************************************/
+
+
+inline Point const & Triangle::getPoint1 () const
+{
+    return m_p1;
+}
+
+
+/*****************************************************************************/
+
+
+inline Point const & Triangle::getPoint2 () const
+{
+    return m_p2;
+}
+
+
+/*****************************************************************************/
+
+
+inline Point const & Triangle::getPoint3 () const
+{
+    return m_p3;
+}
+
+
+/*****************************************************************************/
+
+
+inline double Triangle::getSide12Length () const
+{
+    return m_p1.distanceTo( m_p2 );
+}
+
+
+/*****************************************************************************/
+
+
+inline double Triangle::getSide13Length () const
+{
+    return m_p1.distanceTo( m_p3 );
+}
+
+
+/*****************************************************************************/
+
+
+inline double Triangle::getSide23Length () const
+{
+    return m_p2.distanceTo( m_p3 );
+}
+
+
+/*****************************************************************************/
+
+
+inline double Triangle::squaredDistance ( Point const & _p1, Point const & _p2 )
+{
+    double diffX = _p2.m_x - _p1.m_x;
+    double diffY = _p2.m_y - _p1.m_y;
+    return diffX * diffX + diffY * diffY;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Triangle::operator != ( Triangle const & _t ) const
+{
+    return !( * this == _t );
+}
+
+
 /*****************************************************************************/
 
 #endif //  _TRIANGLE_HPP_
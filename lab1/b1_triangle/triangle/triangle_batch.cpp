@@ -0,0 +1,363 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "triangle_batch.hpp"
+
+#include <stdexcept>
+
+// On x86 the AVX2 kernels are always compiled, with a per-function target
+// where the compiler needs one, and used only on processors that have AVX2
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+    #include <intrin.h>
+    #include <immintrin.h>
+    #define TRIANGLE_BATCH_AVX2_KERNELS
+    #define AVX2_TARGET
+#elif defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+    #include <immintrin.h>
+    #define TRIANGLE_BATCH_AVX2_KERNELS
+    #define AVX2_TARGET __attribute__(( target( "avx2" ) ))
+#endif
+
+/*****************************************************************************/
+
+#if defined( TRIANGLE_BATCH_AVX2_KERNELS )
+
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+
+bool processorHasAvx2 ()
+{
+#if defined( _MSC_VER )
+    int info[ 4 ];
+    __cpuid( info, 0 );
+    if ( info[ 0 ] < 7 )
+        return false;
+
+    // AVX needs OSXSAVE, and XCR0 must show the system preserves YMM state
+    __cpuid( info, 1 );
+    const int osxsaveAndAvx = ( 1 << 27 ) | ( 1 << 28 );
+    if ( ( info[ 2 ] & osxsaveAndAvx ) != osxsaveAndAvx || ( _xgetbv( 0 ) & 6 ) != 6 )
+        return false;
+
+    __cpuidex( info, 7, 0 );
+    return ( info[ 1 ] & ( 1 << 5 ) ) != 0;
+#else
+    return __builtin_cpu_supports( "avx2" ) != 0;
+#endif
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+bool useAvx2Kernels ()
+{
+    static const bool s_useAvx2Kernels = processorHasAvx2();
+    return s_useAvx2Kernels;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+// Coordinate columns of a batch, as seen by the kernels
+struct Columns
+{
+    double const * m_pX1, * m_pY1, * m_pX2, * m_pY2, * m_pX3, * m_pY3;
+};
+
+
+/*-----------------------------------------------------------------*/
+
+
+// Coordinate differences and squared sides of four triangles
+struct SideVectors
+{
+    __m256d m_dx12, m_dy12, m_dx13, m_dy13;
+    __m256d m_squared12, m_squared13, m_squared23;
+};
+
+
+/*-----------------------------------------------------------------*/
+
+
+AVX2_TARGET
+SideVectors loadSides ( Columns const & _columns, int _index )
+{
+    __m256d x1 = _mm256_loadu_pd( _columns.m_pX1 + _index ), y1 = _mm256_loadu_pd( _columns.m_pY1 + _index );
+    __m256d x2 = _mm256_loadu_pd( _columns.m_pX2 + _index ), y2 = _mm256_loadu_pd( _columns.m_pY2 + _index );
+    __m256d x3 = _mm256_loadu_pd( _columns.m_pX3 + _index ), y3 = _mm256_loadu_pd( _columns.m_pY3 + _index );
+
+    SideVectors result;
+    result.m_dx12 = _mm256_sub_pd( x2, x1 );
+    result.m_dy12 = _mm256_sub_pd( y2, y1 );
+    result.m_dx13 = _mm256_sub_pd( x3, x1 );
+    result.m_dy13 = _mm256_sub_pd( y3, y1 );
+
+    __m256d dx23 = _mm256_sub_pd( x3, x2 ), dy23 = _mm256_sub_pd( y3, y2 );
+
+    result.m_squared12 = _mm256_add_pd( _mm256_mul_pd( result.m_dx12, result.m_dx12 ), _mm256_mul_pd( result.m_dy12, result.m_dy12 ) );
+    result.m_squared13 = _mm256_add_pd( _mm256_mul_pd( result.m_dx13, result.m_dx13 ), _mm256_mul_pd( result.m_dy13, result.m_dy13 ) );
+    result.m_squared23 = _mm256_add_pd( _mm256_mul_pd( dx23, dx23 ), _mm256_mul_pd( dy23, dy23 ) );
+    return result;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+// Vector form of equalDoubles with its default tolerance
+AVX2_TARGET
+__m256d equalDoubles4 ( __m256d _d1, __m256d _d2 )
+{
+    const __m256d signBit = _mm256_set1_pd( -0.0 );
+    const __m256d tolerance = _mm256_set1_pd( 0.001 );
+
+    __m256d difference = _mm256_andnot_pd( signBit, _mm256_sub_pd( _d1, _d2 ) );
+    return _mm256_cmp_pd( difference, tolerance, _CMP_LE_OQ );
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+// The kernels handle whole groups of four and return how many triangles they did
+
+AVX2_TARGET
+int computeAreasAvx2 ( Columns const & _columns, int _nTriangles, double * _pResults )
+{
+    const __m256d signBit = _mm256_set1_pd( -0.0 );
+    const __m256d half = _mm256_set1_pd( 0.5 );
+
+    int i = 0;
+    for ( ; i + 4 <= _nTriangles; i += 4 )
+    {
+        SideVectors sides = loadSides( _columns, i );
+
+        __m256d cross = _mm256_sub_pd(
+                _mm256_mul_pd( sides.m_dx12, sides.m_dy13 )
+            ,    _mm256_mul_pd( sides.m_dy12, sides.m_dx13 )
+        );
+
+        _mm256_storeu_pd( _pResults + i, _mm256_mul_pd( _mm256_andnot_pd( signBit, cross ), half ) );
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+AVX2_TARGET
+int computePerimetersAvx2 ( Columns const & _columns, int _nTriangles, double * _pResults )
+{
+    int i = 0;
+    for ( ; i + 4 <= _nTriangles; i += 4 )
+    {
+        SideVectors sides = loadSides( _columns, i );
+
+        __m256d perimeter = _mm256_add_pd(
+                _mm256_add_pd( _mm256_sqrt_pd( sides.m_squared12 ), _mm256_sqrt_pd( sides.m_squared13 ) )
+            ,    _mm256_sqrt_pd( sides.m_squared23 )
+        );
+
+        _mm256_storeu_pd( _pResults + i, perimeter );
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+AVX2_TARGET
+int classifyAvx2 ( Columns const & _columns, int _nTriangles, unsigned char * _pResults )
+{
+    int i = 0;
+    for ( ; i + 4 <= _nTriangles; i += 4 )
+    {
+        SideVectors sides = loadSides( _columns, i );
+
+        __m256d rectangular = _mm256_or_pd(
+                equalDoubles4( _mm256_add_pd( sides.m_squared12, sides.m_squared13 ), sides.m_squared23 )
+            ,    _mm256_or_pd(
+                        equalDoubles4( _mm256_add_pd( sides.m_squared12, sides.m_squared23 ), sides.m_squared13 )
+                    ,    equalDoubles4( _mm256_add_pd( sides.m_squared13, sides.m_squared23 ), sides.m_squared12 )
+                )
+        );
+
+        __m256d side12 = _mm256_sqrt_pd( sides.m_squared12 );
+        __m256d side13 = _mm256_sqrt_pd( sides.m_squared13 );
+        __m256d side23 = _mm256_sqrt_pd( sides.m_squared23 );
+
+        __m256d equal12and13 = equalDoubles4( side12, side13 );
+        __m256d equal13and23 = equalDoubles4( side13, side23 );
+
+        __m256d isosceles = _mm256_or_pd(
+                _mm256_or_pd( equal12and13, equalDoubles4( side12, side23 ) )
+            ,    equal13and23
+        );
+
+        __m256d equilateral = _mm256_and_pd( equal12and13, equal13and23 );
+
+        int rectangularBits = _mm256_movemask_pd( rectangular );
+        int isoscelesBits = _mm256_movemask_pd( isosceles );
+        int equilateralBits = _mm256_movemask_pd( equilateral );
+
+        for ( int lane = 0; lane < 4; ++lane )
+            _pResults[ i + lane ] = static_cast< unsigned char >(
+                    ( ( ( rectangularBits >> lane ) & 1 ) ? TriangleBatch::Kind_Rectangular : 0 )
+                |    ( ( ( isoscelesBits >> lane ) & 1 ) ? TriangleBatch::Kind_Isosceles : 0 )
+                |    ( ( ( equilateralBits >> lane ) & 1 ) ? TriangleBatch::Kind_Equilateral : 0 )
+            );
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+}
+
+#endif
+
+/*****************************************************************************/
+
+
+TriangleBatch::TriangleBatch ()
+{
+}
+
+
+/*****************************************************************************/
+
+
+void TriangleBatch::reserve ( int _trianglesCount )
+{
+    m_x1.reserve( _trianglesCount );
+    m_y1.reserve( _trianglesCount );
+    m_x2.reserve( _trianglesCount );
+    m_y2.reserve( _trianglesCount );
+    m_x3.reserve( _trianglesCount );
+    m_y3.reserve( _trianglesCount );
+}
+
+
+/*****************************************************************************/
+
+
+void TriangleBatch::addTriangle ( Triangle const & _t )
+{
+    addTriangle(
+            _t.getPoint1().m_x, _t.getPoint1().m_y
+        ,    _t.getPoint2().m_x, _t.getPoint2().m_y
+        ,    _t.getPoint3().m_x, _t.getPoint3().m_y
+    );
+}
+
+
+/*****************************************************************************/
+
+
+void TriangleBatch::addTriangle ( double _x1, double _y1, double _x2, double _y2, double _x3, double _y3 )
+{
+    m_x1.push_back( _x1 );
+    m_y1.push_back( _y1 );
+    m_x2.push_back( _x2 );
+    m_y2.push_back( _y2 );
+    m_x3.push_back( _x3 );
+    m_y3.push_back( _y3 );
+}
+
+
+/*****************************************************************************/
+
+
+Triangle TriangleBatch::getTriangle ( int _index ) const
+{
+    if ( _index < 0 || _index >= getTrianglesCount() )
+        throw std::logic_error( "Triangle index out of range" );
+
+    return Triangle( m_x1[ _index ], m_y1[ _index ], m_x2[ _index ], m_y2[ _index ], m_x3[ _index ], m_y3[ _index ] );
+}
+
+
+/*****************************************************************************/
+
+
+void TriangleBatch::computeAreas ( double * _pResults ) const
+{
+    const int nTriangles = getTrianglesCount();
+    int i = 0;
+
+#if defined( TRIANGLE_BATCH_AVX2_KERNELS )
+    if ( useAvx2Kernels() )
+    {
+        const Columns columns = { m_x1.data(), m_y1.data(), m_x2.data(), m_y2.data(), m_x3.data(), m_y3.data() };
+        i = computeAreasAvx2( columns, nTriangles, _pResults );
+    }
+#endif
+
+    for ( ; i < nTriangles; ++i )
+        _pResults[ i ] = getTriangle( i ).getArea();
+}
+
+
+/*****************************************************************************/
+
+
+void TriangleBatch::computePerimeters ( double * _pResults ) const
+{
+    const int nTriangles = getTrianglesCount();
+    int i = 0;
+
+#if defined( TRIANGLE_BATCH_AVX2_KERNELS )
+    if ( useAvx2Kernels() )
+    {
+        const Columns columns = { m_x1.data(), m_y1.data(), m_x2.data(), m_y2.data(), m_x3.data(), m_y3.data() };
+        i = computePerimetersAvx2( columns, nTriangles, _pResults );
+    }
+#endif
+
+    for ( ; i < nTriangles; ++i )
+        _pResults[ i ] = getTriangle( i ).getPerimeter();
+}
+
+
+/*****************************************************************************/
+
+
+void TriangleBatch::classify ( unsigned char * _pResults ) const
+{
+    const int nTriangles = getTrianglesCount();
+    int i = 0;
+
+#if defined( TRIANGLE_BATCH_AVX2_KERNELS )
+    if ( useAvx2Kernels() )
+    {
+        const Columns columns = { m_x1.data(), m_y1.data(), m_x2.data(), m_y2.data(), m_x3.data(), m_y3.data() };
+        i = classifyAvx2( columns, nTriangles, _pResults );
+    }
+#endif
+
+    for ( ; i < nTriangles; ++i )
+    {
+        Triangle t = getTriangle( i );
+        _pResults[ i ] = static_cast< unsigned char >(
+                ( t.isRectangular() ? Kind_Rectangular : 0 )
+            |    ( t.isIsosceles() ? Kind_Isosceles : 0 )
+            |    ( t.isEquilateral() ? Kind_Equilateral : 0 )
+        );
+    }
+}
+
+
+/*****************************************************************************/
@@ -0,0 +1,88 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _TRIANGLE_BATCH_HPP_
+#define _TRIANGLE_BATCH_HPP_
+
+/*****************************************************************************/
+
+#include "triangle.hpp"
+
+#include <vector>
+
+/*****************************************************************************/
+
+/*
+    Many triangles stored as structure-of-arrays, one coordinate per array.
+
+    The kernels process four triangles per step with AVX2 on processors that
+    report it at run time; the AVX2 code is compiled into every x86 build, so no
+    /arch:AVX2 is needed. Other processors fall back to the Triangle methods.
+    Both paths follow the Triangle formulas,
+    including the equalDoubles tolerance used by the classification.
+*/
+
+class TriangleBatch
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*------------------------------------------------------------------*/
+
+    enum Kind
+    {
+        Kind_Rectangular = 1,
+        Kind_Isosceles = 2,
+        Kind_Equilateral = 4
+    };
+
+/*------------------------------------------------------------------*/
+
+    TriangleBatch ();
+
+    void reserve ( int _trianglesCount );
+
+    void addTriangle ( Triangle const & _t );
+
+    void addTriangle ( double _x1, double _y1, double _x2, double _y2, double _x3, double _y3 );
+
+    int getTrianglesCount () const;
+
+    Triangle getTriangle ( int _index ) const;
+
+/*------------------------------------------------------------------*/
+
+    // Each output array receives getTrianglesCount() values
+    void computeAreas ( double * _pResults ) const;
+
+    void computePerimeters ( double * _pResults ) const;
+
+    // Combination of Kind flags per triangle
+    void classify ( unsigned char * _pResults ) const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+    std::vector< double > m_x1, m_y1, m_x2, m_y2, m_x3, m_y3;
+
+/*------------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline int TriangleBatch::getTrianglesCount () const
+{
+    return static_cast< int >( m_x1.size() );
+}
+
+
+/*****************************************************************************/
+
+#endif //  _TRIANGLE_BATCH_HPP_
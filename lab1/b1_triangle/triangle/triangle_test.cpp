@@ -5,6 +5,7 @@
 #include "testslib.hpp"
 
 #include "triangle.hpp"
+#include "triangle_batch.hpp"
 
 /*****************************************************************************/
 
@@ -136,4 +137,59 @@ DECLARE_OOP_TEST( triangles_test_IsEquilateral )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( triangles_test_Batch_MatchesTriangles )
+{
+    TriangleBatch batch;
+    batch.reserve( 1003 );
+
+    batch.addTriangle( Triangle( Point( 0.0, 3.0 ), Point( 0.0, 0.0 ), Point( 7.0, 0.0 ) ) );
+    batch.addTriangle( Triangle( Point( 0.0, 3.464 ), Point( -2.0, 0.0 ), Point( 2.0, 0.0 ) ) );
+    batch.addTriangle( Triangle( Point( 0.0, 3.0 ), Point( -1.0, 0.0 ), Point( 1.0, 0.0 ) ) );
+
+    unsigned seed = 7;
+    for ( int i = 0; i < 1000; ++i )
+    {
+        double coordinates[ 6 ];
+        for ( double & c : coordinates )
+        {
+            seed = seed * 1103515245 + 12345;
+            c = ( ( seed >> 16 ) % 21 ) * 0.5 - 5.0;
+        }
+        batch.addTriangle( coordinates[ 0 ], coordinates[ 1 ], coordinates[ 2 ], coordinates[ 3 ], coordinates[ 4 ], coordinates[ 5 ] );
+    }
+
+    const int nTriangles = batch.getTrianglesCount();
+    assert( nTriangles == 1003 );
+
+    std::vector< double > areas( nTriangles ), perimeters( nTriangles );
+    std::vector< unsigned char > kinds( nTriangles );
+    batch.computeAreas( areas.data() );
+    batch.computePerimeters( perimeters.data() );
+    batch.classify( kinds.data() );
+
+    int nRectangular = 0, nIsosceles = 0;
+    for ( int i = 0; i < nTriangles; ++i )
+    {
+        Triangle t = batch.getTriangle( i );
+        assert( equalDoubles( areas[ i ], t.getArea() ) );
+        assert( equalDoubles( perimeters[ i ], t.getPerimeter() ) );
+
+        assert( ( ( kinds[ i ] & TriangleBatch::Kind_Rectangular ) != 0 ) == t.isRectangular() );
+        assert( ( ( kinds[ i ] & TriangleBatch::Kind_Isosceles ) != 0 ) == t.isIsosceles() );
+        assert( ( ( kinds[ i ] & TriangleBatch::Kind_Equilateral ) != 0 ) == t.isEquilateral() );
+
+        nRectangular += t.isRectangular();
+        nIsosceles += t.isIsosceles();
+    }
+
+    assert( kinds[ 0 ] == TriangleBatch::Kind_Rectangular );
+    assert( kinds[ 1 ] == ( TriangleBatch::Kind_Isosceles | TriangleBatch::Kind_Equilateral ) );
+    assert( kinds[ 2 ] == TriangleBatch::Kind_Isosceles );
+    assert( nRectangular > 3 && nIsosceles > 3 );
+}
+
+
 /*****************************************************************************/
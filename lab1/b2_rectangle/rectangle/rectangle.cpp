@@ -6,6 +6,35 @@
 
 /*****************************************************************************/
 
-// ... TODO ...
+
+Rectangle::Rectangle ( Point const & _topLeft, Point const & _bottomRight )
+    :    m_left( _topLeft.m_x ), m_top( _topLeft.m_y )
+    ,    m_right( _bottomRight.m_x ), m_bottom( _bottomRight.m_y )
+{
+    if ( m_right < m_left || m_top < m_bottom )
+        throw std::logic_error( "Invalid rectangle coordinates" );
+}
+
+
+/*****************************************************************************/
+
+
+Rectangle::Rectangle ( Point const & _topLeft, double _width, double _height )
+    :    m_left( _topLeft.m_x ), m_top( _topLeft.m_y )
+    ,    m_right( _topLeft.m_x + _width ), m_bottom( _topLeft.m_y - _height )
+{
+    if ( _width < 0.0 || _height < 0.0 )
+        throw std::logic_error( "Invalid rectangle coordinates" );
+}
+
+
+/*****************************************************************************/
+
+
+bool Rectangle::operator == ( Rectangle const & _r ) const
+{
+    return getTopLeft() == _r.getTopLeft() && getBottomRight() == _r.getBottomRight();
+}
+
 
 /*****************************************************************************/
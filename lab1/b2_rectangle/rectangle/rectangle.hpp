@@ -13,15 +13,194 @@
 class Rectangle
 {
 
-//*-----------------------------------------------------------------*/
+/*-----------------------------------------------------------------*/
 
-    // ... TODO ...
+public:
+
+/*------------------------------------------------------------------*/
+
+    Rectangle ( Point const & _topLeft, Point const & _bottomRight );
+
+    Rectangle ( Point const & _topLeft, double _width, double _height );
+
+/*------------------------------------------------------------------*/
+
+    Point getTopLeft () const;
+
+    Point getTopRight () const;
+
+    Point getBottomLeft () const;
+
+    Point getBottomRight () const;
+
+    double getLeft () const;
+
+    double getTop () const;
+
+    double getRight () const;
+
+    double getBottom () const;
+
+    double getWidth () const;
+
+    double getHeight () const;
+
+    double getPerimeter () const;
+
+    double getArea () const;
+
+/*------------------------------------------------------------------*/
+
+    bool operator == ( Rectangle const & _r ) const;
+
+    bool operator != ( Rectangle const & _r ) const;
+
+/*------------------------------------------------------------------*/
+
+    // Borders count as inside
+    bool contains ( Point const & _p ) const;
+
+    bool contains ( Point const & _p1, Point const & _p2 ) const;
+
+    bool intersects ( Rectangle const & _r ) const;
+
+    bool covers ( Rectangle const & _r ) const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+    // Stored as plain coordinates so that rectangles stay assignable
+    double m_left, m_top, m_right, m_bottom;
 
 /*------------------------------------------------------------------*/
 
 };
 
 
+/*****************************************************************************/
+
+
+inline Point Rectangle::getTopLeft () const
+{
+    return Point( m_left, m_top );
+}
+
+
+inline Point Rectangle::getTopRight () const
+{
+    return Point( m_right, m_top );
+}
+
+
+inline Point Rectangle::getBottomLeft () const
+{
+    return Point( m_left, m_bottom );
+}
+
+
+inline Point Rectangle::getBottomRight () const
+{
+    return Point( m_right, m_bottom );
+}
+
+
+/*****************************************************************************/
+
+
+inline double Rectangle::getLeft () const
+{
+    return m_left;
+}
+
+
+inline double Rectangle::getTop () const
+{
+    return m_top;
+}
+
+
+inline double Rectangle::getRight () const
+{
+    return m_right;
+}
+
+
+inline double Rectangle::getBottom () const
+{
+    return m_bottom;
+}
+
+
+/*****************************************************************************/
+
+
+inline double Rectangle::getWidth () const
+{
+    return m_right - m_left;
+}
+
+
+inline double Rectangle::getHeight () const
+{
+    return m_top - m_bottom;
+}
+
+
+inline double Rectangle::getPerimeter () const
+{
+    return 2.0 * ( getWidth() + getHeight() );
+}
+
+
+inline double Rectangle::getArea () const
+{
+    return getWidth() * getHeight();
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Rectangle::operator != ( Rectangle const & _r ) const
+{
+    return !( * this == _r );
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Rectangle::contains ( Point const & _p ) const
+{
+    return m_left <= _p.m_x && _p.m_x <= m_right
+        && m_bottom <= _p.m_y && _p.m_y <= m_top;
+}
+
+
+inline bool Rectangle::contains ( Point const & _p1, Point const & _p2 ) const
+{
+    // A rectangle is convex, so containing both ends means containing the segment
+    return contains( _p1 ) && contains( _p2 );
+}
+
+
+inline bool Rectangle::intersects ( Rectangle const & _r ) const
+{
+    return m_left <= _r.m_right && _r.m_left <= m_right
+        && m_bottom <= _r.m_top && _r.m_bottom <= m_top;
+}
+
+
+inline bool Rectangle::covers ( Rectangle const & _r ) const
+{
+    return m_left <= _r.m_left && _r.m_right <= m_right
+        && m_bottom <= _r.m_bottom && _r.m_top <= m_top;
+}
+
+
 /*****************************************************************************/
 
 #endif //  _RECTANGLE_HPP_
@@ -0,0 +1,552 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "rectangle_index.hpp"
+
+#include <algorithm>
+#include <queue>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <cmath>
+
+/*****************************************************************************/
+
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+Rectangle unite ( Rectangle const & _r1, Rectangle const & _r2 )
+{
+    return Rectangle(
+            Point( std::min( _r1.getLeft(), _r2.getLeft() ), std::max( _r1.getTop(), _r2.getTop() ) )
+        ,    Point( std::max( _r1.getRight(), _r2.getRight() ), std::min( _r1.getBottom(), _r2.getBottom() ) )
+    );
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+double getCenterX ( Rectangle const & _r )
+{
+    return ( _r.getLeft() + _r.getRight() ) * 0.5;
+}
+
+
+double getCenterY ( Rectangle const & _r )
+{
+    return ( _r.getBottom() + _r.getTop() ) * 0.5;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+double squaredDistance ( Rectangle const & _r, Point const & _p )
+{
+    double dx = std::max( std::max( _r.getLeft() - _p.m_x, _p.m_x - _r.getRight() ), 0.0 );
+    double dy = std::max( std::max( _r.getBottom() - _p.m_y, _p.m_y - _r.getTop() ), 0.0 );
+    return dx * dx + dy * dy;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+// Orders _items so that every consecutive run of _nodeCapacity items forms a compact tile
+template< typename _Item, typename _GetBounds >
+void sortTiles ( std::vector< _Item > & _items, int _nodeCapacity, _GetBounds _getBounds )
+{
+    const int nItems = static_cast< int >( _items.size() );
+    const int nNodes = ( nItems + _nodeCapacity - 1 ) / _nodeCapacity;
+    const int nSlices = static_cast< int >( std::ceil( std::sqrt( static_cast< double >( nNodes ) ) ) );
+    const int sliceSize = nSlices * _nodeCapacity;
+
+    std::sort(
+            _items.begin(), _items.end()
+        ,    [ & ] ( _Item const & _i1, _Item const & _i2 )
+             {
+                 return getCenterX( _getBounds( _i1 ) ) < getCenterX( _getBounds( _i2 ) );
+             }
+    );
+
+    for ( int first = 0; first < nItems; first += sliceSize )
+        std::sort(
+                _items.begin() + first, _items.begin() + std::min( first + sliceSize, nItems )
+            ,    [ & ] ( _Item const & _i1, _Item const & _i2 )
+                 {
+                     return getCenterY( _getBounds( _i1 ) ) < getCenterY( _getBounds( _i2 ) );
+                 }
+        );
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+// Sorts _entries along the longer side of _bounds and moves the upper half out
+template< typename _Item, typename _GetBounds >
+std::vector< _Item > splitHalves ( std::vector< _Item > & _entries, Rectangle const & _bounds, _GetBounds _getBounds )
+{
+    const bool alongX = _bounds.getWidth() >= _bounds.getHeight();
+
+    std::sort(
+            _entries.begin(), _entries.end()
+        ,    [ & ] ( _Item const & _i1, _Item const & _i2 )
+             {
+                 return alongX
+                     ?    getCenterX( _getBounds( _i1 ) ) < getCenterX( _getBounds( _i2 ) )
+                     :    getCenterY( _getBounds( _i1 ) ) < getCenterY( _getBounds( _i2 ) );
+             }
+    );
+
+    const int half = static_cast< int >( _entries.size() ) / 2;
+
+    std::vector< _Item > upper;
+    upper.reserve( _entries.size() - half );
+    std::move( _entries.begin() + half, _entries.end(), std::back_inserter( upper ) );
+    _entries.erase( _entries.begin() + half, _entries.end() );
+    return upper;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+}
+
+/*****************************************************************************/
+
+
+RectangleIndex::RectangleIndex ()
+    :    m_rectanglesCount( 0 ), m_height( 0 )
+{
+}
+
+
+/*****************************************************************************/
+
+
+RectangleIndex::RectangleIndex ( std::vector< Rectangle > _rectangles )
+    :    m_rectanglesCount( 0 ), m_height( 0 )
+{
+    bulkLoad( std::move( _rectangles ) );
+}
+
+
+/*****************************************************************************/
+
+
+void RectangleIndex::bulkLoad ( std::vector< Rectangle > _rectangles )
+{
+    clear();
+
+    if ( _rectangles.empty() )
+        return;
+
+    auto rectangleBounds = [] ( Rectangle const & _r ) -> Rectangle const & { return _r; };
+    auto nodeBounds = [] ( std::unique_ptr< Node > const & _pNode ) -> Rectangle const & { return _pNode->m_bounds; };
+
+    sortTiles( _rectangles, MaxEntries, rectangleBounds );
+
+    std::vector< std::unique_ptr< Node > > level;
+    for ( std::size_t first = 0; first < _rectangles.size(); first += MaxEntries )
+    {
+        std::unique_ptr< Node > pLeaf( new Node( _rectangles[ first ], true ) );
+        std::size_t last = std::min( first + MaxEntries, _rectangles.size() );
+        pLeaf->m_rectangles.assign( _rectangles.begin() + first, _rectangles.begin() + last );
+        updateBounds( * pLeaf );
+        level.push_back( std::move( pLeaf ) );
+    }
+
+    m_height = 1;
+
+    while ( level.size() > 1 )
+    {
+        sortTiles( level, MaxEntries, nodeBounds );
+
+        std::vector< std::unique_ptr< Node > > parents;
+        for ( std::size_t first = 0; first < level.size(); first += MaxEntries )
+        {
+            std::unique_ptr< Node > pParent( new Node( level[ first ]->m_bounds, false ) );
+            std::size_t last = std::min( first + MaxEntries, level.size() );
+            for ( std::size_t i = first; i < last; ++i )
+                pParent->m_children.push_back( std::move( level[ i ] ) );
+            updateBounds( * pParent );
+            parents.push_back( std::move( pParent ) );
+        }
+
+        level.swap( parents );
+        ++ m_height;
+    }
+
+    m_root = std::move( level.front() );
+    m_rectanglesCount = static_cast< int >( _rectangles.size() );
+}
+
+
+/*****************************************************************************/
+
+
+void RectangleIndex::insert ( Rectangle const & _r )
+{
+    if ( ! m_root )
+    {
+        m_root.reset( new Node( _r, true ) );
+        m_height = 1;
+    }
+
+    std::unique_ptr< Node > pSibling = insertInto( * m_root, _r );
+    if ( pSibling )
+    {
+        std::unique_ptr< Node > pNewRoot( new Node( unite( m_root->m_bounds, pSibling->m_bounds ), false ) );
+        pNewRoot->m_children.push_back( std::move( m_root ) );
+        pNewRoot->m_children.push_back( std::move( pSibling ) );
+        m_root = std::move( pNewRoot );
+        ++ m_height;
+    }
+
+    ++ m_rectanglesCount;
+}
+
+
+/*****************************************************************************/
+
+
+bool RectangleIndex::remove ( Rectangle const & _r )
+{
+    std::vector< Rectangle > orphans;
+    if ( ! m_root || ! removeFrom( * m_root, _r, orphans ) )
+        return false;
+
+    m_rectanglesCount -= 1 + static_cast< int >( orphans.size() );
+
+    while ( ! m_root->m_isLeaf && m_root->m_children.size() == 1 )
+    {
+        std::unique_ptr< Node > pChild = std::move( m_root->m_children.front() );
+        m_root = std::move( pChild );
+        -- m_height;
+    }
+
+    if ( ! m_root->getEntriesCount() )
+    {
+        m_root.reset();
+        m_height = 0;
+    }
+
+    for ( Rectangle const & orphan : orphans )
+        insert( orphan );
+
+    return true;
+}
+
+
+/*****************************************************************************/
+
+
+void RectangleIndex::clear ()
+{
+    m_root.reset();
+    m_rectanglesCount = 0;
+    m_height = 0;
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< Rectangle > RectangleIndex::findContaining ( Point const & _p ) const
+{
+    std::vector< Rectangle > result;
+    if ( ! m_root )
+        return result;
+
+    std::vector< Node const * > stack( 1, m_root.get() );
+    while ( ! stack.empty() )
+    {
+        Node const * pNode = stack.back();
+        stack.pop_back();
+
+        if ( pNode->m_isLeaf )
+        {
+            for ( Rectangle const & r : pNode->m_rectangles )
+                if ( r.contains( _p ) )
+                    result.push_back( r );
+        }
+        else
+        {
+            for ( auto const & pChild : pNode->m_children )
+                if ( pChild->m_bounds.contains( _p ) )
+                    stack.push_back( pChild.get() );
+        }
+    }
+
+    return result;
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< Rectangle > RectangleIndex::findIntersecting ( Rectangle const & _window ) const
+{
+    std::vector< Rectangle > result;
+    if ( ! m_root )
+        return result;
+
+    std::vector< Node const * > stack( 1, m_root.get() );
+    while ( ! stack.empty() )
+    {
+        Node const * pNode = stack.back();
+        stack.pop_back();
+
+        // Everything below a node inside the window intersects it
+        if ( _window.covers( pNode->m_bounds ) )
+            collect( * pNode, result );
+
+        else if ( pNode->m_isLeaf )
+        {
+            for ( Rectangle const & r : pNode->m_rectangles )
+                if ( r.intersects( _window ) )
+                    result.push_back( r );
+        }
+
+        else
+        {
+            for ( auto const & pChild : pNode->m_children )
+                if ( pChild->m_bounds.intersects( _window ) )
+                    stack.push_back( pChild.get() );
+        }
+    }
+
+    return result;
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< Rectangle > RectangleIndex::findCoveredBy ( Rectangle const & _window ) const
+{
+    std::vector< Rectangle > result;
+    if ( ! m_root )
+        return result;
+
+    std::vector< Node const * > stack( 1, m_root.get() );
+    while ( ! stack.empty() )
+    {
+        Node const * pNode = stack.back();
+        stack.pop_back();
+
+        if ( _window.covers( pNode->m_bounds ) )
+            collect( * pNode, result );
+
+        else if ( pNode->m_isLeaf )
+        {
+            for ( Rectangle const & r : pNode->m_rectangles )
+                if ( _window.covers( r ) )
+                    result.push_back( r );
+        }
+
+        else
+        {
+            for ( auto const & pChild : pNode->m_children )
+                if ( pChild->m_bounds.intersects( _window ) )
+                    stack.push_back( pChild.get() );
+        }
+    }
+
+    return result;
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< Rectangle > RectangleIndex::findNearest ( Point const & _p, int _count ) const
+{
+    if ( _count < 0 )
+        throw std::logic_error( "Invalid neighbours count" );
+
+    std::vector< Rectangle > result;
+    if ( ! m_root || ! _count )
+        return result;
+
+    // Best-first search: a rectangle popped from the queue is closer than anything left in it
+    struct Candidate
+    {
+        double m_distance;
+        Node const * m_pNode;
+        Rectangle const * m_pRectangle;
+
+        bool operator > ( Candidate const & _c ) const
+        {
+            return m_distance > _c.m_distance;
+        }
+    };
+
+    std::priority_queue< Candidate, std::vector< Candidate >, std::greater< Candidate > > queue;
+    queue.push( Candidate{ squaredDistance( m_root->m_bounds, _p ), m_root.get(), nullptr } );
+
+    while ( ! queue.empty() && static_cast< int >( result.size() ) < _count )
+    {
+        Candidate candidate = queue.top();
+        queue.pop();
+
+        if ( candidate.m_pRectangle )
+            result.push_back( * candidate.m_pRectangle );
+
+        else if ( candidate.m_pNode->m_isLeaf )
+        {
+            for ( Rectangle const & r : candidate.m_pNode->m_rectangles )
+                queue.push( Candidate{ squaredDistance( r, _p ), nullptr, & r } );
+        }
+
+        else
+        {
+            for ( auto const & pChild : candidate.m_pNode->m_children )
+                queue.push( Candidate{ squaredDistance( pChild->m_bounds, _p ), pChild.get(), nullptr } );
+        }
+    }
+
+    return result;
+}
+
+
+/*****************************************************************************/
+
+
+void RectangleIndex::updateBounds ( Node & _node )
+{
+    if ( _node.m_isLeaf )
+    {
+        _node.m_bounds = _node.m_rectangles.front();
+        for ( Rectangle const & r : _node.m_rectangles )
+            _node.m_bounds = unite( _node.m_bounds, r );
+    }
+    else
+    {
+        _node.m_bounds = _node.m_children.front()->m_bounds;
+        for ( auto const & pChild : _node.m_children )
+            _node.m_bounds = unite( _node.m_bounds, pChild->m_bounds );
+    }
+}
+
+
+/*****************************************************************************/
+
+
+std::unique_ptr< RectangleIndex::Node > RectangleIndex::insertInto ( Node & _node, Rectangle const & _r )
+{
+    _node.m_bounds = unite( _node.m_bounds, _r );
+
+    if ( _node.m_isLeaf )
+        _node.m_rectangles.push_back( _r );
+
+    else
+    {
+        // Least enlargement first, then the smaller area
+        Node * pBest = nullptr;
+        double bestEnlargement = 0.0, bestArea = 0.0;
+
+        for ( auto const & pChild : _node.m_children )
+        {
+            double area = pChild->m_bounds.getArea();
+            double enlargement = unite( pChild->m_bounds, _r ).getArea() - area;
+
+            if ( ! pBest || enlargement < bestEnlargement || ( enlargement == bestEnlargement && area < bestArea ) )
+            {
+                pBest = pChild.get();
+                bestEnlargement = enlargement;
+                bestArea = area;
+            }
+        }
+
+        std::unique_ptr< Node > pSibling = insertInto( * pBest, _r );
+        if ( pSibling )
+            _node.m_children.push_back( std::move( pSibling ) );
+    }
+
+    if ( _node.getEntriesCount() > MaxEntries )
+        return split( _node );
+
+    return nullptr;
+}
+
+
+/*****************************************************************************/
+
+
+std::unique_ptr< RectangleIndex::Node > RectangleIndex::split ( Node & _node )
+{
+    std::unique_ptr< Node > pSibling( new Node( _node.m_bounds, _node.m_isLeaf ) );
+
+    if ( _node.m_isLeaf )
+        pSibling->m_rectangles = splitHalves(
+                _node.m_rectangles, _node.m_bounds
+            ,    [] ( Rectangle const & _r ) -> Rectangle const & { return _r; }
+        );
+    else
+        pSibling->m_children = splitHalves(
+                _node.m_children, _node.m_bounds
+            ,    [] ( std::unique_ptr< Node > const & _pNode ) -> Rectangle const & { return _pNode->m_bounds; }
+        );
+
+    updateBounds( _node );
+    updateBounds( * pSibling );
+    return pSibling;
+}
+
+
+/*****************************************************************************/
+
+
+bool RectangleIndex::removeFrom ( Node & _node, Rectangle const & _r, std::vector< Rectangle > & _orphans )
+{
+    if ( _node.m_isLeaf )
+    {
+        auto it = std::find( _node.m_rectangles.begin(), _node.m_rectangles.end(), _r );
+        if ( it == _node.m_rectangles.end() )
+            return false;
+
+        _node.m_rectangles.erase( it );
+    }
+
+    else
+    {
+        auto it = _node.m_children.begin();
+        for ( ; it != _node.m_children.end(); ++it )
+            if ( ( * it )->m_bounds.intersects( _r ) && removeFrom( ** it, _r, _orphans ) )
+                break;
+
+        if ( it == _node.m_children.end() )
+            return false;
+
+        if ( ( * it )->getEntriesCount() < MinEntries )
+        {
+            collect( ** it, _orphans );
+            _node.m_children.erase( it );
+        }
+    }
+
+    if ( _node.getEntriesCount() )
+        updateBounds( _node );
+
+    return true;
+}
+
+
+/*****************************************************************************/
+
+
+void RectangleIndex::collect ( Node const & _node, std::vector< Rectangle > & _results )
+{
+    if ( _node.m_isLeaf )
+        _results.insert( _results.end(), _node.m_rectangles.begin(), _node.m_rectangles.end() );
+    else
+        for ( auto const & pChild : _node.m_children )
+            collect( * pChild, _results );
+}
+
+
+/*****************************************************************************/
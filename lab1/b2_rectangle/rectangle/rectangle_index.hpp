@@ -0,0 +1,142 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _RECTANGLE_INDEX_HPP_
+#define _RECTANGLE_INDEX_HPP_
+
+/*****************************************************************************/
+
+#include "rectangle.hpp"
+
+#include <vector>
+#include <memory>
+
+/*****************************************************************************/
+
+/*
+    R-tree over a large collection of rectangles.
+
+    Every node keeps the bounding rectangle of its subtree, so queries only
+    descend into nodes that may hold an answer. A collection given up front is
+    packed with Sort-Tile-Recursive loading: rectangles are sorted into vertical
+    slices by the x of their centers, each slice by the y, and then cut into
+    full nodes. Single insertions descend along the least enlargement and split
+    overflowing nodes in halves along their longer side; removals dissolve
+    underfull nodes and insert their rectangles again.
+
+    Removal matches rectangles with Rectangle::operator ==.
+*/
+
+class RectangleIndex
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*------------------------------------------------------------------*/
+
+    RectangleIndex ();
+
+    explicit RectangleIndex ( std::vector< Rectangle > _rectangles );
+
+/*------------------------------------------------------------------*/
+
+    int getRectanglesCount () const;
+
+    // Number of node levels, 0 for an empty index
+    int getHeight () const;
+
+    // Replaces the contents with a packed tree over _rectangles
+    void bulkLoad ( std::vector< Rectangle > _rectangles );
+
+    void insert ( Rectangle const & _r );
+
+    // Removes one stored rectangle equal to _r, returns false if there is none
+    bool remove ( Rectangle const & _r );
+
+    void clear ();
+
+/*------------------------------------------------------------------*/
+
+    std::vector< Rectangle > findContaining ( Point const & _p ) const;
+
+    std::vector< Rectangle > findIntersecting ( Rectangle const & _window ) const;
+
+    std::vector< Rectangle > findCoveredBy ( Rectangle const & _window ) const;
+
+    // Up to _count rectangles closest to _p, nearest first; rectangles containing _p are at distance 0
+    std::vector< Rectangle > findNearest ( Point const & _p, int _count ) const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+    struct Node
+    {
+        Node ( Rectangle const & _bounds, bool _isLeaf )
+            :    m_bounds( _bounds ), m_isLeaf( _isLeaf )
+        {}
+
+        int getEntriesCount () const
+        {
+            return static_cast< int >( m_isLeaf ? m_rectangles.size() : m_children.size() );
+        }
+
+        Rectangle m_bounds;
+
+        bool m_isLeaf;
+
+        std::vector< Rectangle > m_rectangles;
+
+        std::vector< std::unique_ptr< Node > > m_children;
+    };
+
+/*------------------------------------------------------------------*/
+
+    static void updateBounds ( Node & _node );
+
+    static std::unique_ptr< Node > insertInto ( Node & _node, Rectangle const & _r );
+
+    static std::unique_ptr< Node > split ( Node & _node );
+
+    static bool removeFrom ( Node & _node, Rectangle const & _r, std::vector< Rectangle > & _orphans );
+
+    static void collect ( Node const & _node, std::vector< Rectangle > & _results );
+
+/*------------------------------------------------------------------*/
+
+    static const int MaxEntries = 16;
+
+    static const int MinEntries = 6;
+
+    std::unique_ptr< Node > m_root;
+
+    int m_rectanglesCount;
+
+    int m_height;
+
+/*------------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline int RectangleIndex::getRectanglesCount () const
+{
+    return m_rectanglesCount;
+}
+
+
+inline int RectangleIndex::getHeight () const
+{
+    return m_height;
+}
+
+
+/*****************************************************************************/
+
+#endif //  _RECTANGLE_INDEX_HPP_
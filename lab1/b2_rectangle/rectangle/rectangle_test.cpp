@@ -5,6 +5,10 @@
 #include "testslib.hpp"
 
 #include "rectangle.hpp"
+#include "rectangle_index.hpp"
+
+#include <vector>
+#include <algorithm>
 
 /*****************************************************************************/
 
@@ -219,4 +223,168 @@ DECLARE_OOP_TEST( rectangle_test_covers )
 }
 
 
+/*****************************************************************************/
+
+
+std::vector< Rectangle > makeRandomRectangles ( int _count, unsigned _seed )
+{
+	std::vector< Rectangle > result;
+	unsigned state = _seed;
+	auto next = [ & ] () { state = state * 1103515245u + 12345u; return ( state >> 8 ) % 1000; };
+
+	for ( int i = 0; i < _count; ++i )
+	{
+		double x = next(), y = next();
+		result.push_back( Rectangle( Point( x, y ), next() % 40 + 1.0, next() % 40 + 1.0 ) );
+	}
+
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< Rectangle > sortedRectangles ( std::vector< Rectangle > _rectangles )
+{
+	std::sort(
+			_rectangles.begin(), _rectangles.end()
+		,	[] ( Rectangle const & _r1, Rectangle const & _r2 )
+			{
+				if ( _r1.getLeft() != _r2.getLeft() )
+					return _r1.getLeft() < _r2.getLeft();
+				if ( _r1.getTop() != _r2.getTop() )
+					return _r1.getTop() < _r2.getTop();
+				if ( _r1.getRight() != _r2.getRight() )
+					return _r1.getRight() < _r2.getRight();
+				return _r1.getBottom() < _r2.getBottom();
+			}
+	);
+	return _rectangles;
+}
+
+
+/*****************************************************************************/
+
+
+bool sameRectangles ( std::vector< Rectangle > const & _r1, std::vector< Rectangle > const & _r2 )
+{
+	return sortedRectangles( _r1 ) == sortedRectangles( _r2 );
+}
+
+
+/*****************************************************************************/
+
+
+void checkIndexQueries ( RectangleIndex const & _index, std::vector< Rectangle > const & _all )
+{
+	assert( _index.getRectanglesCount() == static_cast< int >( _all.size() ) );
+
+	for ( int i = 0; i < 20; ++i )
+	{
+		Point p( i * 47.0 + 3.5, 1000.0 - i * 43.0 );
+		Rectangle window( p, 120.0, 90.0 );
+
+		std::vector< Rectangle > containing, intersecting, covered;
+		for ( Rectangle const & r : _all )
+		{
+			if ( r.contains( p ) )
+				containing.push_back( r );
+			if ( r.intersects( window ) )
+				intersecting.push_back( r );
+			if ( window.covers( r ) )
+				covered.push_back( r );
+		}
+
+		assert( sameRectangles( _index.findContaining( p ), containing ) );
+		assert( sameRectangles( _index.findIntersecting( window ), intersecting ) );
+		assert( sameRectangles( _index.findCoveredBy( window ), covered ) );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( rectangle_index_test_bulk_load )
+{
+	std::vector< Rectangle > all = makeRandomRectangles( 5000, 1 );
+	RectangleIndex index( all );
+
+	// 5000 rectangles in nodes of 16 take 4 levels
+	assert( index.getHeight() == 4 );
+	checkIndexQueries( index, all );
+
+	index.clear();
+	assert( index.getRectanglesCount() == 0 );
+	assert( index.findContaining( Point( 500.0, 500.0 ) ).empty() );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( rectangle_index_test_insert_remove )
+{
+	std::vector< Rectangle > all = makeRandomRectangles( 3000, 2 );
+
+	RectangleIndex index;
+	for ( Rectangle const & r : all )
+		index.insert( r );
+
+	checkIndexQueries( index, all );
+	assert( index.getHeight() <= 5 );
+
+	// Remove every other rectangle
+	std::vector< Rectangle > kept;
+	for ( int i = 0; i < static_cast< int >( all.size() ); ++i )
+		if ( i % 2 )
+			kept.push_back( all[ i ] );
+		else
+			assert( index.remove( all[ i ] ) );
+
+	checkIndexQueries( index, kept );
+
+	assert( ! index.remove( Rectangle( Point( -10.0, -10.0 ), 1.0, 1.0 ) ) );
+
+	for ( Rectangle const & r : kept )
+		assert( index.remove( r ) );
+
+	assert( index.getRectanglesCount() == 0 );
+	assert( index.getHeight() == 0 );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( rectangle_index_test_nearest )
+{
+	std::vector< Rectangle > all;
+	for ( int i = 0; i < 100; ++i )
+		all.push_back( Rectangle( Point( i * 10.0, 1.0 ), 1.0, 1.0 ) );
+
+	RectangleIndex index( all );
+
+	std::vector< Rectangle > nearest = index.findNearest( Point( 52.0, 0.5 ), 3 );
+	assert( nearest.size() == 3 );
+	assert( nearest[ 0 ] == Rectangle( Point( 50.0, 1.0 ), 1.0, 1.0 ) );
+	assert( nearest[ 1 ] == Rectangle( Point( 60.0, 1.0 ), 1.0, 1.0 ) );
+	assert( nearest[ 2 ] == Rectangle( Point( 40.0, 1.0 ), 1.0, 1.0 ) );
+
+	assert( index.findNearest( Point( 0.0, 0.0 ), 0 ).empty() );
+	assert( index.findNearest( Point( 0.0, 0.0 ), 1000 ).size() == 100 );
+
+	try
+	{
+		index.findNearest( Point( 0.0, 0.0 ), -1 );
+		assert( ! "Exception expected" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Invalid neighbours count" ) );
+	}
+}
+
+
 /*****************************************************************************/
@@ -3,11 +3,262 @@
 #include "arithmetic_progression.hpp"
 
 #include <stdexcept>
+#include <climits>
 
 /*****************************************************************************/
 
+namespace
+{
 
-// TODO ...
+/*-----------------------------------------------------------------*/
+
+long long multiplyChecked ( long long _value1, long long _value2 )
+{
+	bool overflow;
+	if ( _value1 > 0 )
+		overflow = ( _value2 > 0 ) ? _value1 > LLONG_MAX / _value2 : _value2 < LLONG_MIN / _value1;
+	else if ( _value1 < 0 )
+		overflow = ( _value2 > 0 ) ? _value1 < LLONG_MIN / _value2 : _value2 < LLONG_MAX / _value1;
+	else
+		overflow = false;
+
+	if ( overflow )
+		throw std::overflow_error( "Progression overflow" );
+
+	return _value1 * _value2;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+}
+
+/*****************************************************************************/
+
+
+ArithmeticProgression::ArithmeticProgression ( int _initialValue, int _step )
+	:	m_initialValue( _initialValue ), m_step( _step )
+{
+}
+
+
+/*****************************************************************************/
+
+
+int ArithmeticProgression::getIthElement ( int _index ) const
+{
+	if ( _index < 0 )
+		throw std::logic_error( "Invalid index" );
+
+	long long element = getElement( _index );
+	if ( element < INT_MIN || element > INT_MAX )
+		throw std::overflow_error( "Progression overflow" );
+
+	return static_cast< int >( element );
+}
+
+
+/*****************************************************************************/
+
+
+void ArithmeticProgression::checkIndexRange ( int _loIndex, int _hiIndex ) const
+{
+	if ( _loIndex < 0 || _hiIndex < _loIndex )
+		throw std::logic_error( "Invalid index range" );
+}
+
+
+/*****************************************************************************/
+
+
+long long ArithmeticProgression::partialSum ( int _loIndex, int _hiIndex ) const
+{
+	checkIndexRange( _loIndex, _hiIndex );
+
+	long long nElements = static_cast< long long >( _hiIndex ) - _loIndex + 1;
+
+	// For an odd count the sum is count times the middle element. For an even one
+	// it is half the count times the sum of the two ends; whenever that pair sum
+	// overflows, so does the total, so the pair may be checked on its own
+	if ( nElements % 2 )
+		return multiplyChecked( nElements, getElement( _loIndex + static_cast< int >( nElements / 2 ) ) );
+
+	long long first = getElement( _loIndex ), last = getElement( _hiIndex );
+	if ( ( last > 0 && first > LLONG_MAX - last ) || ( last < 0 && first < LLONG_MIN - last ) )
+		throw std::overflow_error( "Progression overflow" );
+
+	return multiplyChecked( nElements / 2, first + last );
+}
+
+
+/*****************************************************************************/
+
+
+double ArithmeticProgression::partialAverage ( int _loIndex, int _hiIndex ) const
+{
+	checkIndexRange( _loIndex, _hiIndex );
+
+	return 0.5 * getElement( _loIndex ) + 0.5 * getElement( _hiIndex );
+}
+
+
+/*****************************************************************************/
+
+
+int ArithmeticProgression::writeValue ( long long _value, char * _buffer )
+{
+	char scratch[ MaxValueLength ];
+	char * end = scratch + MaxValueLength;
+	char * p = end;
+
+	unsigned long long magnitude = ( _value < 0 )
+		?	0ULL - static_cast< unsigned long long >( _value )
+		:	static_cast< unsigned long long >( _value );
+
+	do
+	{
+		* -- p = static_cast< char >( '0' + magnitude % 10 );
+		magnitude /= 10;
+	}
+	while ( magnitude );
+
+	if ( _value < 0 )
+		* -- p = '-';
+
+	int length = static_cast< int >( end - p );
+	for ( int i = 0; i < length; ++i )
+		_buffer[ i ] = p[ i ];
+
+	return length;
+}
+
+
+/*****************************************************************************/
+
+
+void ArithmeticProgression::display ( int _loIndex, int _hiIndex, std::ostream & _o ) const
+{
+	checkIndexRange( _loIndex, _hiIndex );
+
+	// Text is collected in chunks and handed to the stream once per chunk
+	const int ChunkSize = 4096;
+	char chunk[ ChunkSize ];
+	int length = 0;
+
+	long long element = getElement( _loIndex );
+	for ( int i = _loIndex; ; ++i, element += m_step )
+	{
+		if ( length + MaxValueLength + 1 > ChunkSize )
+		{
+			_o.write( chunk, length );
+			length = 0;
+		}
+
+		if ( i != _loIndex )
+			chunk[ length++ ] = ' ';
+
+		length += writeValue( element, chunk + length );
+
+		if ( i == _hiIndex )
+			break;
+	}
+
+	_o.write( chunk, length );
+}
+
+
+/*****************************************************************************/
+
+
+int ArithmeticProgression::format ( int _loIndex, int _hiIndex, char * _buffer, int _bufferSize ) const
+{
+	checkIndexRange( _loIndex, _hiIndex );
+
+	int length = 0;
+
+	long long element = getElement( _loIndex );
+	for ( int i = _loIndex; ; ++i, element += m_step )
+	{
+		char scratch[ MaxValueLength + 1 ];
+		int elementLength = 0;
+
+		if ( i != _loIndex )
+			scratch[ elementLength++ ] = ' ';
+
+		elementLength += writeValue( element, scratch + elementLength );
+
+		if ( length + elementLength >= _bufferSize )
+			throw std::logic_error( "Buffer too small" );
+
+		for ( int k = 0; k < elementLength; ++k )
+			_buffer[ length + k ] = scratch[ k ];
+		length += elementLength;
+
+		if ( i == _hiIndex )
+			break;
+	}
+
+	_buffer[ length ] = '\0';
+	return length;
+}
+
+
+/*****************************************************************************/
+
+
+bool ArithmeticProgression::matchesArray ( int const * _pData, int _count ) const
+{
+	if ( _count < 0 )
+		throw std::logic_error( "Invalid elements count" );
+
+	// Elements past the int range cannot match anything, and below it
+	// comparing modulo 2^32 is exact
+	long long nFitting = _count;
+	if ( m_step > 0 )
+		nFitting = ( INT_MAX - static_cast< long long >( m_initialValue ) ) / m_step + 1;
+	else if ( m_step < 0 )
+		nFitting = ( static_cast< long long >( m_initialValue ) - INT_MIN ) / -static_cast< long long >( m_step ) + 1;
+
+	if ( _count > nFitting )
+		return false;
+
+	// Blocks are compared without branches, which vectorizes, and the first
+	// mismatching block ends the scan
+	const int BlockSize = 64;
+	const unsigned step = static_cast< unsigned >( m_step );
+	unsigned expected = static_cast< unsigned >( m_initialValue );
+
+	int i = 0;
+	for ( ; i + BlockSize <= _count; i += BlockSize )
+	{
+		unsigned mismatch = 0;
+		for ( int k = 0; k < BlockSize; ++k )
+			mismatch |= static_cast< unsigned >( _pData[ i + k ] ) ^ ( expected + step * k );
+
+		if ( mismatch )
+			return false;
+
+		expected += step * BlockSize;
+	}
+
+	for ( ; i < _count; ++i, expected += step )
+		if ( static_cast< unsigned >( _pData[ i ] ) != expected )
+			return false;
+
+	return true;
+}
+
+
+/*****************************************************************************/
+
+
+ArithmeticProgression ArithmeticProgression::makeInverted () const
+{
+	if ( m_step == INT_MIN )
+		throw std::overflow_error( "Progression overflow" );
+
+	return ArithmeticProgression( m_initialValue, -m_step );
+}
 
 
 /*****************************************************************************/
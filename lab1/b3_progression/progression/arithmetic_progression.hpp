@@ -16,13 +16,131 @@ class ArithmeticProgression
 
 /*-----------------------------------------------------------------*/
 
-	// TODO ...
+public:
+
+/*------------------------------------------------------------------*/
+
+	ArithmeticProgression ( int _initialValue = 0, int _step = 1 );
+
+/*------------------------------------------------------------------*/
+
+	int getInitialValue () const;
+
+	int getStep () const;
+
+	// Throws std::overflow_error if the element does not fit into int
+	int getIthElement ( int _index ) const;
+
+/*------------------------------------------------------------------*/
+
+	// Closed forms over inclusive index ranges; the sum is exact or throws std::overflow_error
+	long long partialSum ( int _loIndex, int _hiIndex ) const;
+
+	double partialAverage ( int _loIndex, int _hiIndex ) const;
+
+/*------------------------------------------------------------------*/
+
+	// Space-separated elements of the inclusive index range
+	void display ( int _loIndex, int _hiIndex, std::ostream & _o = std::cout ) const;
+
+	// Same text as display, null-terminated; returns its length
+	int format ( int _loIndex, int _hiIndex, char * _buffer, int _bufferSize ) const;
+
+/*------------------------------------------------------------------*/
+
+	bool operator == ( ArithmeticProgression const & _p ) const;
+
+	bool operator != ( ArithmeticProgression const & _p ) const;
+
+/*------------------------------------------------------------------*/
+
+	// Whether _pData[ i ] is the i-th element for every i below _count
+	bool matchesArray ( int const * _pData, int _count ) const;
+
+	bool matchesArray ( std::initializer_list< int > _data ) const;
+
+	ArithmeticProgression makeInverted () const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	void checkIndexRange ( int _loIndex, int _hiIndex ) const;
+
+	long long getElement ( int _index ) const;
+
+	// Writes the decimal form of _value without a terminator, returns the number of characters
+	static int writeValue ( long long _value, char * _buffer );
+
+/*------------------------------------------------------------------*/
+
+	// Longest decimal form of an element, sign included
+	static const int MaxValueLength = 20;
+
+	int m_initialValue, m_step;
 
 /*------------------------------------------------------------------*/
 
 };
 
 
+/*****************************************************************************/
+
+
+inline int ArithmeticProgression::getInitialValue () const
+{
+	return m_initialValue;
+}
+
+
+/*****************************************************************************/
+
+
+inline int ArithmeticProgression::getStep () const
+{
+	return m_step;
+}
+
+
+/*****************************************************************************/
+
+
+inline long long ArithmeticProgression::getElement ( int _index ) const
+{
+	// At most 2^31 + 2^62 in magnitude, always representable
+	return m_initialValue + static_cast< long long >( m_step ) * _index;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool ArithmeticProgression::operator == ( ArithmeticProgression const & _p ) const
+{
+	return m_initialValue == _p.m_initialValue && m_step == _p.m_step;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool ArithmeticProgression::operator != ( ArithmeticProgression const & _p ) const
+{
+	return !( * this == _p );
+}
+
+
+/*****************************************************************************/
+
+
+inline bool ArithmeticProgression::matchesArray ( std::initializer_list< int > _data ) const
+{
+	return matchesArray( _data.begin(), static_cast< int >( _data.size() ) );
+}
+
+
 /*****************************************************************************/
 
 #endif //  _ARITHMETIC_PROGRESSION_HPP_
@@ -8,6 +8,8 @@
 #include "arithmetic_progression.hpp"
 
 #include <sstream>
+#include <vector>
+#include <climits>
 
 /*****************************************************************************/
 
@@ -237,4 +239,100 @@ DECLARE_OOP_TEST( progression_test_make_inverted )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( progression_test_partialSum_large )
+{
+    ArithmeticProgression p1( INT_MAX, INT_MAX );
+    assert( p1.partialSum( 0, 2 ) == 6LL * INT_MAX );
+    assert( p1.partialSum( INT_MAX - 1, INT_MAX ) == ( 2LL * INT_MAX + 1 ) * INT_MAX );
+    assert( equalDoubles( p1.partialAverage( 0, INT_MAX ), ( INT_MAX + 2.0 ) / 2 * INT_MAX ) );
+
+    ArithmeticProgression p2( INT_MIN, -1 );
+    assert( p2.partialSum( 0, 0 ) == INT_MIN );
+    assert( p2.partialSum( 0, 1 ) == 2LL * INT_MIN - 1 );
+
+    try
+    {
+        p1.partialSum( 0, INT_MAX );
+        assert( ! "Exception must have been thrown by partialSum" );
+    }
+    catch ( std::exception & e )
+    {
+        assert( ! strcmp( e.what(), "Progression overflow" ) );
+    }
+
+    try
+    {
+        p1.getIthElement( 1 );
+        assert( ! "Exception must have been thrown by getIthElement" );
+    }
+    catch ( std::exception & e )
+    {
+        assert( ! strcmp( e.what(), "Progression overflow" ) );
+    }
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( progression_test_matches_long_array )
+{
+    ArithmeticProgression p( -5000, 3 );
+
+    std::vector< int > data;
+    for ( int i = 0; i < 100000; ++i )
+        data.push_back( p.getIthElement( i ) );
+
+    assert( p.matchesArray( data.data(), static_cast< int >( data.size() ) ) );
+    assert( p.matchesArray( data.data(), 77 ) );
+
+    data[ 99999 ] += 1;
+    assert( ! p.matchesArray( data.data(), static_cast< int >( data.size() ) ) );
+    assert( p.matchesArray( data.data(), 99999 ) );
+
+    data[ 70 ] -= 1;
+    assert( ! p.matchesArray( data.data(), 77 ) );
+
+    // The element after INT_MAX wraps around to INT_MIN, but must not match it
+    ArithmeticProgression p2( INT_MAX - 1, 1 );
+    const int wrapped[] = { INT_MAX - 1, INT_MAX, INT_MIN };
+    assert( p2.matchesArray( wrapped, 2 ) );
+    assert( ! p2.matchesArray( wrapped, 3 ) );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( progression_test_format )
+{
+    ArithmeticProgression p( 2, -3 ); // 2 -1 -4 -7
+    char buffer[ 16 ];
+
+    assert( p.format( 0, 3, buffer, sizeof( buffer ) ) == 10 );
+    assert( ! strcmp( buffer, "2 -1 -4 -7" ) );
+
+    try
+    {
+        p.format( 0, 3, buffer, 10 );
+        assert( ! "Exception must have been thrown by format" );
+    }
+    catch ( std::exception & e )
+    {
+        assert( ! strcmp( e.what(), "Buffer too small" ) );
+    }
+
+    // Longer than a single output chunk
+    std::ostringstream o;
+    ArithmeticProgression p2( 1000000 );
+    p2.display( 0, 9999, o );
+    assert( o.str().size() == 10000 * 8 - 1 );
+    assert( o.str().substr( 0, 15 ) == "1000000 1000001" );
+    assert( o.str().substr( o.str().size() - 7 ) == "1009999" );
+}
+
+
 /*****************************************************************************/
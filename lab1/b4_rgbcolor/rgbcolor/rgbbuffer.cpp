@@ -0,0 +1,356 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "rgbbuffer.hpp"
+
+#include <stdexcept>
+
+// The AVX2 kernels are compiled on x86 whatever the project's target
+// instruction set, and are chosen at run time when the processor has AVX2
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+	#include <intrin.h>
+	#include <immintrin.h>
+	#define RGBBUFFER_AVX2_KERNELS
+	#define AVX2_TARGET
+#elif defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+	#include <immintrin.h>
+	#define RGBBUFFER_AVX2_KERNELS
+	#define AVX2_TARGET __attribute__(( target( "avx2" ) ))
+#endif
+
+/*****************************************************************************/
+
+#if defined( RGBBUFFER_AVX2_KERNELS )
+
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+bool detectAvx2 ()
+{
+#if defined( _MSC_VER )
+	int info[ 4 ];
+	__cpuid( info, 0 );
+	if ( info[ 0 ] < 7 )
+		return false;
+
+	// The system must also save the upper halves of the registers
+	__cpuid( info, 1 );
+	const int osxsaveAndAvx = ( 1 << 27 ) | ( 1 << 28 );
+	if ( ( info[ 2 ] & osxsaveAndAvx ) != osxsaveAndAvx || ( _xgetbv( 0 ) & 6 ) != 6 )
+		return false;
+
+	__cpuidex( info, 7, 0 );
+	return ( info[ 1 ] & ( 1 << 5 ) ) != 0;
+#else
+	return __builtin_cpu_supports( "avx2" ) != 0;
+#endif
+}
+
+
+/*-----------------------------------------------------------------*/
+
+bool canUseAvx2 ()
+{
+	static const bool s_canUseAvx2 = detectAvx2();
+	return s_canUseAvx2;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+// Each kernel processes whole blocks and returns the number of pixels done
+
+AVX2_TARGET
+int invertAvx2 ( unsigned int * _pPixels, int _nPixels )
+{
+	const __m256i allChannels = _mm256_set1_epi32( 0xFFFFFF );
+
+	int i = 0;
+	for ( ; i + 8 <= _nPixels; i += 8 )
+	{
+		__m256i * pBlock = reinterpret_cast< __m256i * >( _pPixels + i );
+		_mm256_storeu_si256( pBlock, _mm256_xor_si256( _mm256_loadu_si256( pBlock ), allChannels ) );
+	}
+
+	_mm256_zeroupper();
+	return i;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+AVX2_TARGET
+int convertToCMYKAvx2 (
+		unsigned int const * _pPixels
+	,	int _nPixels
+	,	double * _pCyan
+	,	double * _pMagenta
+	,	double * _pYellow
+	,	double * _pBlack
+)
+{
+	// Four pixels per step, widened to doubles so that the arithmetic
+	// is the same IEEE sequence as in RGBColor
+	const __m128i channelMask = _mm_set1_epi32( 0xFF );
+	const __m256d zero = _mm256_setzero_pd();
+	const __m256d one = _mm256_set1_pd( 1.0 );
+	const __m256d maxChannel = _mm256_set1_pd( 255.0 );
+
+	int i = 0;
+	for ( ; i + 4 <= _nPixels; i += 4 )
+	{
+		__m128i pixels = _mm_loadu_si128( reinterpret_cast< __m128i const * >( _pPixels + i ) );
+		__m128i red = _mm_and_si128( _mm_srli_epi32( pixels, 16 ), channelMask );
+		__m128i green = _mm_and_si128( _mm_srli_epi32( pixels, 8 ), channelMask );
+		__m128i blue = _mm_and_si128( pixels, channelMask );
+		__m128i maxComponent = _mm_max_epi32( _mm_max_epi32( red, green ), blue );
+
+		__m256d max = _mm256_cvtepi32_pd( maxComponent );
+		__m256d isBlack = _mm256_cmp_pd( max, zero, _CMP_EQ_OQ );
+
+		__m256d cyan = _mm256_div_pd( _mm256_cvtepi32_pd( _mm_sub_epi32( maxComponent, red ) ), max );
+		__m256d magenta = _mm256_div_pd( _mm256_cvtepi32_pd( _mm_sub_epi32( maxComponent, green ) ), max );
+		__m256d yellow = _mm256_div_pd( _mm256_cvtepi32_pd( _mm_sub_epi32( maxComponent, blue ) ), max );
+
+		_mm256_storeu_pd( _pCyan + i, _mm256_blendv_pd( cyan, zero, isBlack ) );
+		_mm256_storeu_pd( _pMagenta + i, _mm256_blendv_pd( magenta, zero, isBlack ) );
+		_mm256_storeu_pd( _pYellow + i, _mm256_blendv_pd( yellow, zero, isBlack ) );
+		_mm256_storeu_pd( _pBlack + i, _mm256_sub_pd( one, _mm256_div_pd( max, maxChannel ) ) );
+	}
+
+	_mm256_zeroupper();
+	return i;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+AVX2_TARGET
+int packAvx2 (
+		unsigned char const * _pRed
+	,	unsigned char const * _pGreen
+	,	unsigned char const * _pBlue
+	,	unsigned int * _pPixels
+	,	int _nPixels
+)
+{
+	int i = 0;
+	for ( ; i + 8 <= _nPixels; i += 8 )
+	{
+		__m256i red = _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast< __m128i const * >( _pRed + i ) ) );
+		__m256i green = _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast< __m128i const * >( _pGreen + i ) ) );
+		__m256i blue = _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast< __m128i const * >( _pBlue + i ) ) );
+
+		__m256i pixels = _mm256_or_si256(
+				_mm256_or_si256( _mm256_slli_epi32( red, 16 ), _mm256_slli_epi32( green, 8 ) )
+			,	blue
+		);
+
+		_mm256_storeu_si256( reinterpret_cast< __m256i * >( _pPixels + i ), pixels );
+	}
+
+	_mm256_zeroupper();
+	return i;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+AVX2_TARGET
+int unpackAvx2 (
+		unsigned int const * _pPixels
+	,	int _nPixels
+	,	unsigned char * _pRed
+	,	unsigned char * _pGreen
+	,	unsigned char * _pBlue
+)
+{
+	// Within each 128-bit lane gather red bytes into dword 0, green into 1, blue into 2,
+	// then interleave the lanes so every channel's 8 bytes become one 64-bit half
+	const __m256i channelShuffle = _mm256_setr_epi8(
+			2, 6, 10, 14,  1, 5, 9, 13,  0, 4, 8, 12,  -1, -1, -1, -1
+		,	2, 6, 10, 14,  1, 5, 9, 13,  0, 4, 8, 12,  -1, -1, -1, -1
+	);
+	const __m256i laneInterleave = _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+
+	int i = 0;
+	for ( ; i + 8 <= _nPixels; i += 8 )
+	{
+		__m256i pixels = _mm256_loadu_si256( reinterpret_cast< __m256i const * >( _pPixels + i ) );
+		__m256i channels = _mm256_permutevar8x32_epi32( _mm256_shuffle_epi8( pixels, channelShuffle ), laneInterleave );
+
+		__m128i redGreen = _mm256_castsi256_si128( channels );
+		__m128i blue = _mm256_extracti128_si256( channels, 1 );
+
+		_mm_storel_epi64( reinterpret_cast< __m128i * >( _pRed + i ), redGreen );
+		_mm_storel_epi64( reinterpret_cast< __m128i * >( _pGreen + i ), _mm_unpackhi_epi64( redGreen, redGreen ) );
+		_mm_storel_epi64( reinterpret_cast< __m128i * >( _pBlue + i ), blue );
+	}
+
+	_mm256_zeroupper();
+	return i;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+}
+
+#endif
+
+/*****************************************************************************/
+
+
+RGBBuffer::RGBBuffer ( int _pixelsCount )
+{
+	if ( _pixelsCount < 0 )
+		throw std::logic_error( "Invalid pixels count" );
+
+	m_pixels.resize( _pixelsCount, 0 );
+}
+
+
+/*****************************************************************************/
+
+
+RGBBuffer::RGBBuffer ( unsigned int const * _pPackedPixels, int _pixelsCount )
+{
+	if ( _pixelsCount < 0 )
+		throw std::logic_error( "Invalid pixels count" );
+
+	unsigned int unusedBits = 0;
+	for ( int i = 0; i < _pixelsCount; ++i )
+		unusedBits |= _pPackedPixels[ i ];
+
+	if ( unusedBits > 0xFFFFFFu )
+		throw std::logic_error( "Invalid packed color" );
+
+	m_pixels.assign( _pPackedPixels, _pPackedPixels + _pixelsCount );
+}
+
+
+/*****************************************************************************/
+
+
+RGBColor RGBBuffer::getPixel ( int _index ) const
+{
+	if ( _index < 0 || _index >= getPixelsCount() )
+		throw std::logic_error( "Pixel index out of range" );
+
+	return RGBColor( m_pixels[ _index ] );
+}
+
+
+/*****************************************************************************/
+
+
+void RGBBuffer::setPixel ( int _index, RGBColor _c )
+{
+	if ( _index < 0 || _index >= getPixelsCount() )
+		throw std::logic_error( "Pixel index out of range" );
+
+	m_pixels[ _index ] = _c.getPackedRGB();
+}
+
+
+/*****************************************************************************/
+
+
+void RGBBuffer::invert ()
+{
+	unsigned int * pPixels = m_pixels.data();
+	const int nPixels = getPixelsCount();
+	int i = 0;
+
+#if defined( RGBBUFFER_AVX2_KERNELS )
+	if ( canUseAvx2() )
+		i = invertAvx2( pPixels, nPixels );
+#endif
+
+	for ( ; i < nPixels; ++i )
+		pPixels[ i ] ^= 0xFFFFFFu;
+}
+
+
+/*****************************************************************************/
+
+
+void RGBBuffer::convertToCMYK (
+		double * _pCyan
+	,	double * _pMagenta
+	,	double * _pYellow
+	,	double * _pBlack
+) const
+{
+	unsigned int const * pPixels = m_pixels.data();
+	const int nPixels = getPixelsCount();
+	int i = 0;
+
+#if defined( RGBBUFFER_AVX2_KERNELS )
+	if ( canUseAvx2() )
+		i = convertToCMYKAvx2( pPixels, nPixels, _pCyan, _pMagenta, _pYellow, _pBlack );
+#endif
+
+	for ( ; i < nPixels; ++i )
+	{
+		RGBColor c( pPixels[ i ] );
+		_pCyan[ i ] = c.getCyanColor();
+		_pMagenta[ i ] = c.getMagentaColor();
+		_pYellow[ i ] = c.getYellowColor();
+		_pBlack[ i ] = c.getBlackKey();
+	}
+}
+
+
+/*****************************************************************************/
+
+
+void RGBBuffer::pack (
+		unsigned char const * _pRed
+	,	unsigned char const * _pGreen
+	,	unsigned char const * _pBlue
+)
+{
+	unsigned int * pPixels = m_pixels.data();
+	const int nPixels = getPixelsCount();
+	int i = 0;
+
+#if defined( RGBBUFFER_AVX2_KERNELS )
+	if ( canUseAvx2() )
+		i = packAvx2( _pRed, _pGreen, _pBlue, pPixels, nPixels );
+#endif
+
+	for ( ; i < nPixels; ++i )
+		pPixels[ i ] = ( static_cast< unsigned int >( _pRed[ i ] ) << 16 ) | ( _pGreen[ i ] << 8 ) | _pBlue[ i ];
+}
+
+
+/*****************************************************************************/
+
+
+void RGBBuffer::unpack (
+		unsigned char * _pRed
+	,	unsigned char * _pGreen
+	,	unsigned char * _pBlue
+) const
+{
+	unsigned int const * pPixels = m_pixels.data();
+	const int nPixels = getPixelsCount();
+	int i = 0;
+
+#if defined( RGBBUFFER_AVX2_KERNELS )
+	if ( canUseAvx2() )
+		i = unpackAvx2( pPixels, nPixels, _pRed, _pGreen, _pBlue );
+#endif
+
+	for ( ; i < nPixels; ++i )
+	{
+		_pRed[ i ] = static_cast< unsigned char >( pPixels[ i ] >> 16 );
+		_pGreen[ i ] = static_cast< unsigned char >( pPixels[ i ] >> 8 );
+		_pBlue[ i ] = static_cast< unsigned char >( pPixels[ i ] );
+	}
+}
+
+
+/*****************************************************************************/
@@ -0,0 +1,105 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _RGBBUFFER_HPP_
+#define _RGBBUFFER_HPP_
+
+/*****************************************************************************/
+
+#include "rgbcolor.hpp"
+
+#include <vector>
+
+/*****************************************************************************/
+
+/*
+	Image-sized array of packed 0x00RRGGBB pixels with whole-buffer kernels.
+
+	On x86 the kernels are built with AVX2 regardless of the project's target
+	instruction set, and are used when the processor reports AVX2 support at
+	run time; elsewhere, and on older processors, plain loops run instead.
+	Both paths produce exactly the values of the corresponding RGBColor methods.
+*/
+
+class RGBBuffer
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*------------------------------------------------------------------*/
+
+	// All pixels black
+	explicit RGBBuffer ( int _pixelsCount );
+
+	RGBBuffer ( unsigned int const * _pPackedPixels, int _pixelsCount );
+
+/*------------------------------------------------------------------*/
+
+	int getPixelsCount () const;
+
+	RGBColor getPixel ( int _index ) const;
+
+	void setPixel ( int _index, RGBColor _c );
+
+	unsigned int const * getPackedData () const;
+
+/*------------------------------------------------------------------*/
+
+	void invert ();
+
+	// Each output array receives getPixelsCount() values
+	void convertToCMYK (
+			double * _pCyan
+		,	double * _pMagenta
+		,	double * _pYellow
+		,	double * _pBlack
+	) const;
+
+	// Fills the buffer from separate 8-bit channel planes
+	void pack (
+			unsigned char const * _pRed
+		,	unsigned char const * _pGreen
+		,	unsigned char const * _pBlue
+	);
+
+	void unpack (
+			unsigned char * _pRed
+		,	unsigned char * _pGreen
+		,	unsigned char * _pBlue
+	) const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	std::vector< unsigned int > m_pixels;
+
+/*------------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline int RGBBuffer::getPixelsCount () const
+{
+	return static_cast< int >( m_pixels.size() );
+}
+
+
+/*****************************************************************************/
+
+
+inline unsigned int const * RGBBuffer::getPackedData () const
+{
+	return m_pixels.data();
+}
+
+
+/*****************************************************************************/
+
+#endif //  _RGBBUFFER_HPP_
@@ -2,8 +2,68 @@
 
 #include "rgbcolor.hpp"
 
+#include <stdexcept>
+#include <iomanip>
+
+/*****************************************************************************/
+
+
+RGBColor::RGBColor ( int _red, int _green, int _blue )
+{
+	if ( _red < 0 || _red > 255 || _green < 0 || _green > 255 || _blue < 0 || _blue > 255 )
+		throw std::logic_error( "Invalid color component" );
+
+	m_red = static_cast< unsigned char >( _red );
+	m_green = static_cast< unsigned char >( _green );
+	m_blue = static_cast< unsigned char >( _blue );
+}
+
+
+/*****************************************************************************/
+
+
+RGBColor::RGBColor ( unsigned int _packedRGB )
+{
+	if ( _packedRGB > 0xFFFFFFu )
+		throw std::logic_error( "Invalid packed color" );
+
+	m_red = static_cast< unsigned char >( _packedRGB >> 16 );
+	m_green = static_cast< unsigned char >( _packedRGB >> 8 );
+	m_blue = static_cast< unsigned char >( _packedRGB );
+}
+
+
+/*****************************************************************************/
+
+
+RGBColor & RGBColor::operator += ( RGBColor _c )
+{
+	int red = m_red + _c.m_red;
+	int green = m_green + _c.m_green;
+	int blue = m_blue + _c.m_blue;
+
+	m_red = static_cast< unsigned char >( red > 255 ? 255 : red );
+	m_green = static_cast< unsigned char >( green > 255 ? 255 : green );
+	m_blue = static_cast< unsigned char >( blue > 255 ? 255 : blue );
+
+	return * this;
+}
+
+
 /*****************************************************************************/
 
-// TODO ...
+
+std::ostream & operator << ( std::ostream & _o, RGBColor _c )
+{
+	std::ios::fmtflags flags = _o.flags();
+	char fill = _o.fill();
+
+	_o << '#' << std::uppercase << std::hex << std::setfill( '0' ) << std::setw( 6 ) << _c.getPackedRGB();
+
+	_o.flags( flags );
+	_o.fill( fill );
+	return _o;
+}
+
 
 /*****************************************************************************/
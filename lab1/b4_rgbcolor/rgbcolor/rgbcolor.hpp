@@ -14,13 +14,201 @@ class RGBColor
 
 /*-----------------------------------------------------------------*/
 
-    // TODO ...
+public:
+
+/*------------------------------------------------------------------*/
+
+	RGBColor ( int _red, int _green, int _blue );
+
+	// 0x00RRGGBB
+	explicit RGBColor ( unsigned int _packedRGB );
+
+/*------------------------------------------------------------------*/
+
+	int getRed () const;
+
+	int getGreen () const;
+
+	int getBlue () const;
+
+	unsigned int getPackedRGB () const;
+
+/*------------------------------------------------------------------*/
+
+	// CMYK components in [0, 1]: K = 1 - max / 255, C = ( max - R ) / max, etc.
+	double getCyanColor () const;
+
+	double getMagentaColor () const;
+
+	double getYellowColor () const;
+
+	double getBlackKey () const;
+
+/*------------------------------------------------------------------*/
+
+	RGBColor getInvertedColor () const;
+
+	bool operator == ( RGBColor _c ) const;
+	bool operator != ( RGBColor _c ) const;
+
+	// Channels saturate at 255
+	RGBColor operator + ( RGBColor _c ) const;
+	RGBColor & operator += ( RGBColor _c );
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	int getMaxComponent () const;
+
+	double getComplementRatio ( int _component ) const;
+
+/*------------------------------------------------------------------*/
+
+	unsigned char m_red, m_green, m_blue;
 
 /*------------------------------------------------------------------*/
 
 };
 
 
+/*****************************************************************************/
+
+
+inline int RGBColor::getRed () const
+{
+	return m_red;
+}
+
+
+/*****************************************************************************/
+
+
+inline int RGBColor::getGreen () const
+{
+	return m_green;
+}
+
+
+/*****************************************************************************/
+
+
+inline int RGBColor::getBlue () const
+{
+	return m_blue;
+}
+
+
+/*****************************************************************************/
+
+
+inline unsigned int RGBColor::getPackedRGB () const
+{
+	return ( static_cast< unsigned int >( m_red ) << 16 ) | ( m_green << 8 ) | m_blue;
+}
+
+
+/*****************************************************************************/
+
+
+inline int RGBColor::getMaxComponent () const
+{
+	int result = ( m_red > m_green ) ? m_red : m_green;
+	return ( result > m_blue ) ? result : m_blue;
+}
+
+
+/*****************************************************************************/
+
+
+inline double RGBColor::getComplementRatio ( int _component ) const
+{
+	// RGBBuffer::convertToCMYK performs exactly these operations
+	int maxComponent = getMaxComponent();
+	return maxComponent ? ( maxComponent - _component ) / static_cast< double >( maxComponent ) : 0.0;
+}
+
+
+/*****************************************************************************/
+
+
+inline double RGBColor::getCyanColor () const
+{
+	return getComplementRatio( m_red );
+}
+
+
+/*****************************************************************************/
+
+
+inline double RGBColor::getMagentaColor () const
+{
+	return getComplementRatio( m_green );
+}
+
+
+/*****************************************************************************/
+
+
+inline double RGBColor::getYellowColor () const
+{
+	return getComplementRatio( m_blue );
+}
+
+
+/*****************************************************************************/
+
+
+inline double RGBColor::getBlackKey () const
+{
+	return 1.0 - getMaxComponent() / 255.0;
+}
+
+
+/*****************************************************************************/
+
+
+inline RGBColor RGBColor::getInvertedColor () const
+{
+	return RGBColor( getPackedRGB() ^ 0xFFFFFFu );
+}
+
+
+/*****************************************************************************/
+
+
+inline bool RGBColor::operator == ( RGBColor _c ) const
+{
+	return getPackedRGB() == _c.getPackedRGB();
+}
+
+
+/*****************************************************************************/
+
+
+inline bool RGBColor::operator != ( RGBColor _c ) const
+{
+	return !( * this == _c );
+}
+
+
+/*****************************************************************************/
+
+
+inline RGBColor RGBColor::operator + ( RGBColor _c ) const
+{
+	RGBColor result( * this );
+	result += _c;
+	return result;
+}
+
+
+/*****************************************************************************/
+
+std::ostream & operator << ( std::ostream & _o, RGBColor _c );
+
 /*****************************************************************************/
 
 #endif //  _RGBCOLOR_HPP_
@@ -6,6 +6,7 @@
 #include "utils.hpp"
 
 #include "rgbcolor.hpp"
+#include "rgbbuffer.hpp"
 
 #include <sstream>
 
@@ -281,4 +282,81 @@ DECLARE_OOP_TEST ( rgb_test_stream_output )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( rgb_buffer_test_cmyk_matches_colors )
+{
+	std::vector< unsigned int > pixels = { 0x000000, 0xFFFFFF, 0xFF0000, 0x00FF00, 0x0000FF, 0x326496 };
+	for ( unsigned int i = 0; i < 1001; ++i )
+		pixels.push_back( ( i * 2654435761u ) & 0xFFFFFF );
+
+	RGBBuffer buffer( pixels.data(), ( int ) pixels.size() );
+	assert( buffer.getPixelsCount() == ( int ) pixels.size() );
+
+	std::vector< double > cyan( pixels.size() ), magenta( pixels.size() ), yellow( pixels.size() ), black( pixels.size() );
+	buffer.convertToCMYK( cyan.data(), magenta.data(), yellow.data(), black.data() );
+
+	for ( size_t i = 0; i < pixels.size(); ++i )
+	{
+		RGBColor c( pixels[ i ] );
+		assert( cyan[ i ] == c.getCyanColor() );
+		assert( magenta[ i ] == c.getMagentaColor() );
+		assert( yellow[ i ] == c.getYellowColor() );
+		assert( black[ i ] == c.getBlackKey() );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( rgb_buffer_test_invert_pack_unpack )
+{
+	const int nPixels = 37;
+
+	std::vector< unsigned char > red( nPixels ), green( nPixels ), blue( nPixels );
+	for ( int i = 0; i < nPixels; ++i )
+	{
+		red[ i ] = ( unsigned char )( i * 7 );
+		green[ i ] = ( unsigned char )( 255 - i );
+		blue[ i ] = ( unsigned char )( i * i );
+	}
+
+	RGBBuffer buffer( nPixels );
+	assert( buffer.getPixel( 3 ) == RGBColor( 0, 0, 0 ) );
+
+	buffer.pack( red.data(), green.data(), blue.data() );
+	for ( int i = 0; i < nPixels; ++i )
+		assert( buffer.getPixel( i ) == RGBColor( red[ i ], green[ i ], blue[ i ] ) );
+
+	buffer.invert();
+	for ( int i = 0; i < nPixels; ++i )
+		assert( buffer.getPixel( i ) == RGBColor( red[ i ], green[ i ], blue[ i ] ).getInvertedColor() );
+
+	buffer.invert();
+	buffer.setPixel( 5, RGBColor( 1, 2, 3 ) );
+	red[ 5 ] = 1;
+	green[ 5 ] = 2;
+	blue[ 5 ] = 3;
+
+	std::vector< unsigned char > red2( nPixels ), green2( nPixels ), blue2( nPixels );
+	buffer.unpack( red2.data(), green2.data(), blue2.data() );
+	assert( red2 == red );
+	assert( green2 == green );
+	assert( blue2 == blue );
+
+	unsigned int bad[] = { 0x123456, 0x01000000 };
+	try
+	{
+		RGBBuffer b( bad, 2 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Invalid packed color" ) );
+	}
+}
+
+
 /*****************************************************************************/
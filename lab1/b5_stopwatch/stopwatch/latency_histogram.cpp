@@ -0,0 +1,188 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "latency_histogram.hpp"
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <climits>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+/*****************************************************************************/
+
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+// Position of the highest set bit of a positive value
+int highestBit ( unsigned long long _value )
+{
+#if defined( _MSC_VER ) && defined( _M_X64 )
+	unsigned long index;
+	_BitScanReverse64( & index, _value );
+	return static_cast< int >( index );
+#elif defined( __GNUC__ )
+	return 63 - __builtin_clzll( _value );
+#else
+	int index = 0;
+	while ( _value >>= 1 )
+		++index;
+	return index;
+#endif
+}
+
+
+/*-----------------------------------------------------------------*/
+
+}
+
+/*****************************************************************************/
+
+
+LatencyHistogram::LatencyHistogram ()
+	:	m_counts( BucketsCount )
+{
+	reset();
+}
+
+
+/*****************************************************************************/
+
+
+int LatencyHistogram::getBucketIndex ( long long _value )
+{
+	if ( _value < SubBucketsCount )
+		return static_cast< int >( _value );
+
+	// _value >> shift lies within [ HalfSubBucketsCount, SubBucketsCount )
+	int shift = highestBit( _value ) - ( SubBucketBits - 1 );
+	return shift * HalfSubBucketsCount + static_cast< int >( _value >> shift );
+}
+
+
+/*****************************************************************************/
+
+
+long long LatencyHistogram::getBucketHighValue ( int _index )
+{
+	if ( _index < SubBucketsCount )
+		return _index;
+
+	int shift = _index / HalfSubBucketsCount - 1;
+	long long subBucket = _index % HalfSubBucketsCount + HalfSubBucketsCount;
+	return ( ( subBucket + 1 ) << shift ) - 1;
+}
+
+
+/*****************************************************************************/
+
+
+void LatencyHistogram::recordMany ( long long _nanoseconds, long long _times )
+{
+	if ( _nanoseconds < 0 )
+		throw std::logic_error( "Invalid duration" );
+
+	if ( _times <= 0 )
+		return;
+
+	m_counts[ getBucketIndex( _nanoseconds ) ] += _times;
+
+	m_totalCount += _times;
+	m_sum += static_cast< double >( _nanoseconds ) * _times;
+	m_min = std::min( m_min, _nanoseconds );
+	m_max = std::max( m_max, _nanoseconds );
+}
+
+
+/*****************************************************************************/
+
+
+void LatencyHistogram::merge ( LatencyHistogram const & _h )
+{
+	if ( ! _h.m_totalCount )
+		return;
+
+	for ( int i = 0; i < BucketsCount; ++i )
+		m_counts[ i ] += _h.m_counts[ i ];
+
+	m_totalCount += _h.m_totalCount;
+	m_sum += _h.m_sum;
+	m_min = std::min( m_min, _h.m_min );
+	m_max = std::max( m_max, _h.m_max );
+}
+
+
+/*****************************************************************************/
+
+
+void LatencyHistogram::reset ()
+{
+	std::fill( m_counts.begin(), m_counts.end(), 0 );
+	m_totalCount = 0;
+	m_sum = 0.0;
+	m_min = LLONG_MAX;
+	m_max = 0;
+}
+
+
+/*****************************************************************************/
+
+
+long long LatencyHistogram::getMin () const
+{
+	return m_totalCount ? m_min : 0;
+}
+
+
+/*****************************************************************************/
+
+
+long long LatencyHistogram::getMax () const
+{
+	return m_max;
+}
+
+
+/*****************************************************************************/
+
+
+double LatencyHistogram::getMean () const
+{
+	return m_totalCount ? m_sum / m_totalCount : 0.0;
+}
+
+
+/*****************************************************************************/
+
+
+long long LatencyHistogram::getValueAtPercentile ( double _percentile ) const
+{
+	if ( !( _percentile >= 0.0 && _percentile <= 100.0 ) )
+		throw std::logic_error( "Invalid percentile" );
+
+	if ( ! m_totalCount )
+		return 0;
+
+	// The ends are known exactly
+	if ( _percentile == 0.0 )
+		return m_min;
+
+	long long target = static_cast< long long >( std::ceil( _percentile / 100.0 * m_totalCount ) );
+
+	long long accumulated = 0;
+	for ( int i = 0; i < BucketsCount; ++i )
+	{
+		accumulated += m_counts[ i ];
+		if ( accumulated >= target )
+			return std::max( std::min( getBucketHighValue( i ), m_max ), m_min );
+	}
+
+	return m_max;
+}
+
+
+/*****************************************************************************/
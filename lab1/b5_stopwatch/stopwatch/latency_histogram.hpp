@@ -0,0 +1,110 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _LATENCY_HISTOGRAM_HPP_
+#define _LATENCY_HISTOGRAM_HPP_
+
+/*****************************************************************************/
+
+#include <vector>
+
+/*****************************************************************************/
+
+/*
+	Counts of non-negative durations in nanoseconds, HDR-style.
+
+	Values below 2^SubBucketBits get a bucket each. Above that, every power of
+	two range is cut into 2^(SubBucketBits-1) equal buckets, so a bucket is never
+	wider than 1/64 of the values it holds. Recording is a bit scan, a shift and
+	an increment; percentile queries walk the fixed bucket array.
+*/
+
+class LatencyHistogram
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*------------------------------------------------------------------*/
+
+	LatencyHistogram ();
+
+/*------------------------------------------------------------------*/
+
+	void record ( long long _nanoseconds );
+
+	void recordMany ( long long _nanoseconds, long long _times );
+
+	void merge ( LatencyHistogram const & _h );
+
+	void reset ();
+
+/*------------------------------------------------------------------*/
+
+	long long getCount () const;
+
+	long long getMin () const;
+
+	long long getMax () const;
+
+	double getMean () const;
+
+	// Smallest recorded value v such that _percentile % of the records are not above v,
+	// within the bucket precision
+	long long getValueAtPercentile ( double _percentile ) const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	static int getBucketIndex ( long long _value );
+
+	static long long getBucketHighValue ( int _index );
+
+/*------------------------------------------------------------------*/
+
+	static const int SubBucketBits = 7;
+
+	static const int SubBucketsCount = 1 << SubBucketBits;
+
+	static const int HalfSubBucketsCount = SubBucketsCount / 2;
+
+	// Enough for any 63-bit value
+	static const int BucketsCount = ( 64 - SubBucketBits ) * HalfSubBucketsCount + SubBucketsCount;
+
+	std::vector< long long > m_counts;
+
+	long long m_totalCount;
+
+	long long m_min, m_max;
+
+	double m_sum;
+
+/*------------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline void LatencyHistogram::record ( long long _nanoseconds )
+{
+	recordMany( _nanoseconds, 1 );
+}
+
+
+/*****************************************************************************/
+
+
+inline long long LatencyHistogram::getCount () const
+{
+	return m_totalCount;
+}
+
+
+/*****************************************************************************/
+
+#endif //  _LATENCY_HISTOGRAM_HPP_
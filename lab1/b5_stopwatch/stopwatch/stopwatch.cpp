@@ -3,11 +3,326 @@
 #include "stopwatch.hpp"
 
 #include <stdexcept>
+#include <chrono>
+#include <atomic>
+
+#if defined( _M_X64 ) || defined( _M_IX86 )
+#include <intrin.h>
+#define STOPWATCH_HAS_TSC
+#elif defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#include <cpuid.h>
+#define STOPWATCH_HAS_TSC
+#endif
+
+/*****************************************************************************/
+
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+#if defined( STOPWATCH_HAS_TSC )
+
+// Set once the counter is calibrated, stays null when it cannot be used
+std::atomic< Stopwatch::TickCalibration const * > s_pCalibration( nullptr );
+
+
+/*-----------------------------------------------------------------*/
+
+
+long long readRawTimestampCounter ()
+{
+	return static_cast< long long >( __rdtsc() );
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+// An invariant counter ticks at a constant rate in every power state
+bool hasInvariantTimestampCounter ()
+{
+	const unsigned int invariantTscLeaf = 0x80000007;
+	const unsigned int invariantTscBit = 1u << 8;
+
+#if defined( _MSC_VER )
+	int info[ 4 ];
+	__cpuid( info, 0x80000000 );
+	if ( static_cast< unsigned int >( info[ 0 ] ) < invariantTscLeaf )
+		return false;
+
+	__cpuid( info, invariantTscLeaf );
+	return ( static_cast< unsigned int >( info[ 3 ] ) & invariantTscBit ) != 0;
+#else
+	unsigned int eax, ebx, ecx, edx;
+	if ( ! __get_cpuid( invariantTscLeaf, & eax, & ebx, & ecx, & edx ) )
+		return false;
+
+	return ( edx & invariantTscBit ) != 0;
+#endif
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+Stopwatch::TickCalibration const * createCalibration ()
+{
+	if ( ! hasInvariantTimestampCounter() )
+		return nullptr;
+
+	// A couple of milliseconds of steady_clock time
+	static const Stopwatch::TickCalibration s_calibration =
+		Stopwatch::calibrateTicks( & readRawTimestampCounter, & Stopwatch::readSteadyClock, 2000000 );
+
+	return & s_calibration;
+}
+
+#endif
+
+/*-----------------------------------------------------------------*/
+
+}
+
+/*****************************************************************************/
+
+
+long long Stopwatch::readSteadyClock ()
+{
+	return std::chrono::duration_cast< std::chrono::nanoseconds >(
+		std::chrono::steady_clock::now().time_since_epoch()
+	).count();
+}
+
+
+/*****************************************************************************/
+
+
+long long Stopwatch::readTimestampCounter ()
+{
+#if defined( STOPWATCH_HAS_TSC )
+	Stopwatch::TickCalibration const * pCalibration = s_pCalibration.load( std::memory_order_acquire );
+	if ( pCalibration )
+		return pCalibration->toNanoseconds( readRawTimestampCounter() );
+#endif
+
+	return readSteadyClock();
+}
+
+
+/*****************************************************************************/
+
+
+Stopwatch::TickCalibration Stopwatch::calibrateTicks (
+		TimeSource _ticks
+	,	TimeSource _reference
+	,	long long _intervalNanoseconds
+)
+{
+	TickCalibration result;
+	result.m_baseNanoseconds = _reference();
+	result.m_baseTicks = _ticks();
+
+	long long nanoseconds;
+	do
+		nanoseconds = _reference();
+	while ( nanoseconds - result.m_baseNanoseconds < _intervalNanoseconds );
+
+	const long long ticks = _ticks();
+
+	result.m_nanosecondsPerTick =
+			static_cast< double >( nanoseconds - result.m_baseNanoseconds )
+		/	static_cast< double >( ticks - result.m_baseTicks );
+
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+long long Stopwatch::TickCalibration::toNanoseconds ( long long _ticks ) const
+{
+	// Ticks are counted from the calibration point to keep the product precise
+	return m_baseNanoseconds + static_cast< long long >(
+		static_cast< double >( _ticks - m_baseTicks ) * m_nanosecondsPerTick
+	);
+}
+
+
+/*****************************************************************************/
+
+
+void Stopwatch::calibrateTimestampCounter ()
+{
+#if defined( STOPWATCH_HAS_TSC )
+	// The measurement runs once per process, whichever thread gets here first
+	static Stopwatch::TickCalibration const * const s_pResult = createCalibration();
+	s_pCalibration.store( s_pResult, std::memory_order_release );
+#endif
+}
+
+
+/*****************************************************************************/
+
+
+Stopwatch::TimeSource Stopwatch::prepareTimeSource ( TimeSource _source )
+{
+	if ( _source == & Stopwatch::readTimestampCounter )
+		calibrateTimestampCounter();
+
+	return _source;
+}
+
+
+/*****************************************************************************/
+
+
+Stopwatch::Stopwatch ( TimeSource _source )
+	:	m_source( prepareTimeSource( _source ) )
+{
+	reset();
+}
+
+
+/*****************************************************************************/
+
+
+void Stopwatch::pause ()
+{
+	if ( m_paused )
+		throw std::logic_error( "Stopwatch is paused already" );
+
+	m_accumulated += m_source() - m_resumedAt;
+	m_paused = true;
+}
+
+
+/*****************************************************************************/
+
+
+void Stopwatch::resume ()
+{
+	if ( ! m_paused )
+		throw std::logic_error( "Stopwatch is not paused" );
+
+	m_resumedAt = m_source();
+	m_paused = false;
+}
+
+
+/*****************************************************************************/
+
+
+void Stopwatch::reset ()
+{
+	m_accumulated = 0;
+	m_resumedAt = 0;
+	m_lapStartedAt = 0;
+	m_paused = true;
+}
+
+
+/*****************************************************************************/
+
+
+int Stopwatch::getElapsedHours () const
+{
+	return getElapsed() / 3600000;
+}
+
+
+/*****************************************************************************/
+
+
+int Stopwatch::getElapsedMinutes () const
+{
+	return getElapsed() / 60000 % 60;
+}
+
+
+/*****************************************************************************/
+
+
+int Stopwatch::getElapsedSeconds () const
+{
+	return getElapsed() / 1000 % 60;
+}
+
+
+/*****************************************************************************/
+
+
+void Stopwatch::display ( std::ostream & _o ) const
+{
+	int elapsed = getElapsed();
+
+	_o << elapsed / 3600000 << ':' << elapsed / 60000 % 60 << ':' << elapsed / 1000 % 60;
+}
+
+
+/*****************************************************************************/
+
+
+long long Stopwatch::recordLap ( LatencyHistogram & _h )
+{
+	long long elapsed = getElapsedNanoseconds();
+	long long lap = elapsed - m_lapStartedAt;
+
+	// Moving the elapsed time back with -= may leave a lap start in the future
+	if ( lap < 0 )
+		lap = 0;
+
+	_h.record( lap );
+	m_lapStartedAt = elapsed;
+	return lap;
+}
+
+
+/*****************************************************************************/
+
+
+Stopwatch & Stopwatch::operator += ( int _milliseconds )
+{
+	long long accumulated = m_accumulated + _milliseconds * 1000000LL;
+	if ( accumulated + ( m_paused ? 0 : m_source() - m_resumedAt ) < 0 )
+		throw std::logic_error( "Negative elapsed time" );
+
+	m_accumulated = accumulated;
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+Stopwatch & Stopwatch::operator -= ( int _milliseconds )
+{
+	return * this += -_milliseconds;
+}
+
+
+/*****************************************************************************/
+
+
+Stopwatch Stopwatch::operator + ( int _milliseconds ) const
+{
+	Stopwatch result( * this );
+	result += _milliseconds;
+	return result;
+}
+
 
 /*****************************************************************************/
 
 
-	// TODO ...
+Stopwatch Stopwatch::operator - ( int _milliseconds ) const
+{
+	Stopwatch result( * this );
+	result -= _milliseconds;
+	return result;
+}
 
 
 /*****************************************************************************/
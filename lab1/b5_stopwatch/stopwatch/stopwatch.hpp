@@ -5,24 +5,219 @@
 
 /*****************************************************************************/
 
-#include <ctime>
+#include "latency_histogram.hpp"
+
 #include <iostream>
 
 /*****************************************************************************/
 
+/*
+	Measures time through a time source returning monotonic nanoseconds.
+
+	The default source is std::chrono::steady_clock. readTimestampCounter reads
+	the processor time stamp counter and is cheaper per call. The counter is
+	calibrated against steady_clock by calibrateTimestampCounter, which
+	stopwatches and timers using it call when they are created, so the
+	measurement never falls into a timed interval. Until then, and on
+	processors without an invariant counter or off x86, it reads steady_clock
+	instead.
+
+	Tests substitute fake sources to control time, for stopwatches as well as
+	for calibrateTicks, which does the measurement.
+*/
 
 class Stopwatch
 {
 
 /*-----------------------------------------------------------------*/
 
-	// TODO ...
+public:
+
+/*------------------------------------------------------------------*/
+
+	typedef long long ( * TimeSource ) ();
+
+	static long long readSteadyClock ();
+
+	static long long readTimestampCounter ();
+
+	// Maps ticks of a counter onto the nanoseconds of a reference source
+	struct TickCalibration
+	{
+		long long m_baseTicks;
+
+		long long m_baseNanoseconds;
+
+		double m_nanosecondsPerTick;
+
+		long long toNanoseconds ( long long _ticks ) const;
+	};
+
+	// Reads both sources until _intervalNanoseconds of the reference pass
+	static TickCalibration calibrateTicks (
+			TimeSource _ticks
+		,	TimeSource _reference
+		,	long long _intervalNanoseconds
+	);
+
+	// Takes a couple of milliseconds the first time, does nothing afterwards
+	static void calibrateTimestampCounter ();
+
+	// Calibrates the source if it needs calibration
+	static TimeSource prepareTimeSource ( TimeSource _source );
+
+/*------------------------------------------------------------------*/
+
+	explicit Stopwatch ( TimeSource _source = & Stopwatch::readSteadyClock );
+
+/*------------------------------------------------------------------*/
+
+	bool isPaused () const;
+
+	void pause ();
+
+	void resume ();
+
+	void reset ();
+
+/*------------------------------------------------------------------*/
+
+	// Milliseconds
+	int getElapsed () const;
+
+	long long getElapsedNanoseconds () const;
+
+	int getElapsedHours () const;
+
+	int getElapsedMinutes () const;
+
+	int getElapsedSeconds () const;
+
+	// "H:M:S"
+	void display ( std::ostream & _o ) const;
+
+/*------------------------------------------------------------------*/
+
+	// Records the time since the previous lap, or since the start, and returns it in nanoseconds
+	long long recordLap ( LatencyHistogram & _h );
+
+/*------------------------------------------------------------------*/
+
+	// Adjust the elapsed time by milliseconds
+	Stopwatch & operator += ( int _milliseconds );
+
+	Stopwatch & operator -= ( int _milliseconds );
+
+	Stopwatch operator + ( int _milliseconds ) const;
+
+	Stopwatch operator - ( int _milliseconds ) const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	TimeSource m_source;
+
+	long long m_accumulated;
+
+	long long m_resumedAt;
+
+	long long m_lapStartedAt;
+
+	bool m_paused;
+
+/*------------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+// Records the lifetime of the object into a histogram
+class ScopedTimer
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*------------------------------------------------------------------*/
+
+	explicit ScopedTimer ( LatencyHistogram & _h, Stopwatch::TimeSource _source = & Stopwatch::readSteadyClock );
+
+	~ScopedTimer ();
+
+	ScopedTimer ( ScopedTimer const & ) = delete;
+
+	ScopedTimer & operator = ( ScopedTimer const & ) = delete;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	LatencyHistogram & m_histogram;
+
+	Stopwatch::TimeSource m_source;
+
+	long long m_startedAt;
 
 /*------------------------------------------------------------------*/
 
 };
 
 
+/*****************************************************************************/
+
+
+inline bool Stopwatch::isPaused () const
+{
+	return m_paused;
+}
+
+
+/*****************************************************************************/
+
+
+inline long long Stopwatch::getElapsedNanoseconds () const
+{
+	return m_paused ? m_accumulated : m_accumulated + ( m_source() - m_resumedAt );
+}
+
+
+/*****************************************************************************/
+
+
+inline int Stopwatch::getElapsed () const
+{
+	return static_cast< int >( getElapsedNanoseconds() / 1000000 );
+}
+
+
+/*****************************************************************************/
+
+
+inline ScopedTimer::ScopedTimer ( LatencyHistogram & _h, Stopwatch::TimeSource _source )
+	:	m_histogram( _h ), m_source( Stopwatch::prepareTimeSource( _source ) ), m_startedAt( m_source() )
+{
+}
+
+
+/*****************************************************************************/
+
+
+inline ScopedTimer::~ScopedTimer ()
+{
+	// A counter read on another core may lag slightly behind the start
+	long long duration = m_source() - m_startedAt;
+	m_histogram.record( duration > 0 ? duration : 0 );
+}
+
+
 /*****************************************************************************/
 
 #endif //  _STOPWATCH_HPP_
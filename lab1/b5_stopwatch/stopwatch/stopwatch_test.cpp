@@ -3,18 +3,36 @@
 /*****************************************************************************/
 
 #include "testslib.hpp"
+#include "utils.hpp"
 
 #include "stopwatch.hpp"
 
-#include <windows.h>
 #include <sstream>
 
+/*****************************************************************************/
+
+// Time stands still until a test moves it forward
+static long long s_fakeClockNanoseconds = 0;
+
+
+long long readFakeClock ()
+{
+	return s_fakeClockNanoseconds;
+}
+
+
+void sleepFakeClock ( int _milliseconds )
+{
+	s_fakeClockNanoseconds += _milliseconds * 1000000LL;
+}
+
+
 /*****************************************************************************/
 
 
 DECLARE_OOP_TEST( stopwatch_test_constructor )
 {
-	Stopwatch s;
+	Stopwatch s( & readFakeClock );
 	assert( s.isPaused() );
 	assert( s.getElapsed() == 0 );
 }
@@ -25,9 +43,9 @@ DECLARE_OOP_TEST( stopwatch_test_constructor )
 
 DECLARE_OOP_TEST( stopwatch_test_after_second )
 {
-	Stopwatch s;
+	Stopwatch s( & readFakeClock );
 	s.resume();
-	::Sleep( 1000 );
+	sleepFakeClock( 1000 );
 	assert( abs( s.getElapsed() - 1000 ) < 100 );
 }
 
@@ -37,8 +55,8 @@ DECLARE_OOP_TEST( stopwatch_test_after_second )
 
 DECLARE_OOP_TEST( stopwatch_test_paused_after_second )
 {
-	Stopwatch s;
-	::Sleep( 1000 );
+	Stopwatch s( & readFakeClock );
+	sleepFakeClock( 1000 );
 	assert( s.getElapsed() == 0 );
 }
 
@@ -48,11 +66,11 @@ DECLARE_OOP_TEST( stopwatch_test_paused_after_second )
 
 DECLARE_OOP_TEST( stopwatch_test_second_pause_another_second )
 {
-	Stopwatch s;
+	Stopwatch s( & readFakeClock );
 	s.resume();
-	::Sleep( 1000 );
+	sleepFakeClock( 1000 );
 	s.pause();
-	::Sleep( 1000 );
+	sleepFakeClock( 1000 );
 	assert( abs( s.getElapsed() - 1000 ) < 100 );
 }
 
@@ -62,13 +80,13 @@ DECLARE_OOP_TEST( stopwatch_test_second_pause_another_second )
 
 DECLARE_OOP_TEST( stopwatch_test_zero_and_paused_after_reset )
 {
-	Stopwatch s;
+	Stopwatch s( & readFakeClock );
 	s.resume();
-	::Sleep( 1000 );
+	sleepFakeClock( 1000 );
 	s.reset();
 	assert( s.getElapsed() == 0 );
 	assert( s.isPaused() );
-	::Sleep( 1000 );
+	sleepFakeClock( 1000 );
 	assert( s.getElapsed() == 0 );
 	assert( s.isPaused() );
 }
@@ -79,13 +97,13 @@ DECLARE_OOP_TEST( stopwatch_test_zero_and_paused_after_reset )
 
 DECLARE_OOP_TEST( stopwatch_test_wait_pause_wait_resume )
 {
-	Stopwatch s;
+	Stopwatch s( & readFakeClock );
 	s.resume();
-	::Sleep( 1000 );
+	sleepFakeClock( 1000 );
 	s.pause();
-	::Sleep( 1000 );
+	sleepFakeClock( 1000 );
 	s.resume();
-	::Sleep( 1000 );
+	sleepFakeClock( 1000 );
 	assert( abs( s.getElapsed() - 2000 ) < 100 );
 	assert( ! s.isPaused() );
 }
@@ -98,7 +116,7 @@ DECLARE_OOP_TEST( stopwatch_test_cannot_pause_paused )
 {
 	try
 	{
-		Stopwatch s;
+		Stopwatch s( & readFakeClock );
 		s.pause();
 		assert( !"Exception must have been thrown" );
 	}
@@ -114,7 +132,7 @@ DECLARE_OOP_TEST( stopwatch_test_cannot_pause_paused )
 
 DECLARE_OOP_TEST( stopwatch_test_cannot_resume_not_paused )
 {
-	Stopwatch s;
+	Stopwatch s( & readFakeClock );
 	s.resume();
 
 	try
@@ -134,9 +152,9 @@ DECLARE_OOP_TEST( stopwatch_test_cannot_resume_not_paused )
 
 DECLARE_OOP_TEST( stopwatch_test_get_elapsed_unit_methods )
 {
-	Stopwatch s;
+	Stopwatch s( & readFakeClock );
 	s.resume();
-	::Sleep( 2100 );
+	sleepFakeClock( 2100 );
 	s.pause();
 
 	assert( s.getElapsedHours() == 0 );
@@ -167,7 +185,7 @@ DECLARE_OOP_TEST( stopwatch_test_get_elapsed_unit_methods )
 
 DECLARE_OOP_TEST( stopwatch_test_display )
 {
-	Stopwatch s;
+	Stopwatch s( & readFakeClock );
 	s += 3600000;
 	s +=  120000;
 	s +=    5500;
@@ -183,7 +201,7 @@ DECLARE_OOP_TEST( stopwatch_test_display )
 
 DECLARE_OOP_TEST( stopwatch_test_increments_decrements )
 {
-	Stopwatch s;
+	Stopwatch s( & readFakeClock );
 	s += 1000;
 
 	Stopwatch s2 = s + 1000;
@@ -201,4 +219,149 @@ DECLARE_OOP_TEST( stopwatch_test_increments_decrements )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( stopwatch_test_laps_histogram )
+{
+	LatencyHistogram h;
+
+	Stopwatch s( & readFakeClock );
+	s.resume();
+
+	for ( int i = 1; i <= 100; ++i )
+	{
+		sleepFakeClock( i );
+		assert( s.recordLap( h ) == i * 1000000LL );
+	}
+
+	assert( h.getCount() == 100 );
+	assert( h.getMin() == 1000000 );
+	assert( h.getMax() == 100000000 );
+	assert( equalDoubles( h.getMean(), 50500000.0 ) );
+
+	// Within the 1/64 bucket precision
+	assert( abs( static_cast< int >( h.getValueAtPercentile( 50.0 ) / 1000 ) - 50000 ) < 50000 / 64 );
+	assert( abs( static_cast< int >( h.getValueAtPercentile( 99.0 ) / 1000 ) - 99000 ) < 99000 / 64 );
+	assert( h.getValueAtPercentile( 100.0 ) == 100000000 );
+	assert( h.getValueAtPercentile( 0.0 ) == 1000000 );
+
+	try
+	{
+		h.getValueAtPercentile( 101.0 );
+		assert( !"Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Invalid percentile" ) );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( stopwatch_test_histogram_small_values_exact )
+{
+	LatencyHistogram h1, h2;
+	for ( int i = 0; i < 100; ++i )
+		h1.record( i );
+	h2.recordMany( 127, 100 );
+
+	h1.merge( h2 );
+	assert( h1.getCount() == 200 );
+	assert( h1.getValueAtPercentile( 25.0 ) == 49 );
+	assert( h1.getValueAtPercentile( 75.0 ) == 127 );
+
+	h1.reset();
+	assert( h1.getCount() == 0 );
+	assert( h1.getValueAtPercentile( 50.0 ) == 0 );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( stopwatch_test_scoped_timer )
+{
+	LatencyHistogram h;
+
+	for ( int i = 0; i < 3; ++i )
+	{
+		ScopedTimer timer( h, & readFakeClock );
+		sleepFakeClock( 5 );
+	}
+
+	assert( h.getCount() == 3 );
+	assert( h.getMin() == 5000000 );
+	assert( h.getMax() == 5000000 );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( stopwatch_test_real_clocks )
+{
+	// Real time depends on the load of the machine, so only its order is checked
+	Stopwatch s1;
+	Stopwatch s2( & Stopwatch::readTimestampCounter );
+	s1.resume();
+	s2.resume();
+
+	long long steady1 = Stopwatch::readSteadyClock();
+	long long counter1 = Stopwatch::readTimestampCounter();
+	long long steady2 = Stopwatch::readSteadyClock();
+	long long counter2 = Stopwatch::readTimestampCounter();
+	assert( steady2 >= steady1 );
+	assert( counter2 >= counter1 );
+
+	s1.pause();
+	s2.pause();
+	assert( s1.getElapsedNanoseconds() >= 0 );
+	assert( s2.getElapsedNanoseconds() >= 0 );
+}
+
+
+/*****************************************************************************/
+
+
+// Ticks four times per nanosecond of the fake clock, from an arbitrary base
+long long readFakeTicks ()
+{
+	return 1000 + 4 * s_fakeClockNanoseconds;
+}
+
+
+// Every reading of the reference moves the fake clock by 100 microseconds
+long long readAdvancingFakeClock ()
+{
+	s_fakeClockNanoseconds += 100000;
+	return s_fakeClockNanoseconds;
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( stopwatch_test_calibrate_ticks )
+{
+	const long long start = s_fakeClockNanoseconds;
+
+	Stopwatch::TickCalibration c = Stopwatch::calibrateTicks( & readFakeTicks, & readAdvancingFakeClock, 2000000 );
+
+	// The reference was read until the interval passed, and no longer
+	assert( s_fakeClockNanoseconds - start == 2100000 );
+	assert( c.m_baseNanoseconds == start + 100000 );
+	assert( c.m_baseTicks == readFakeTicks() - 4 * 2000000 );
+
+	// Converted ticks follow the reference
+	assert( c.toNanoseconds( c.m_baseTicks ) == c.m_baseNanoseconds );
+	assert( c.toNanoseconds( readFakeTicks() ) == s_fakeClockNanoseconds );
+
+	sleepFakeClock( 5 );
+	assert( c.toNanoseconds( readFakeTicks() ) == s_fakeClockNanoseconds );
+}
+
+
 /*****************************************************************************/
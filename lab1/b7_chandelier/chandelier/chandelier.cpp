@@ -3,11 +3,205 @@
 #include "chandelier.hpp"
 
 #include <stdexcept>
+#include <algorithm>
 
 /*****************************************************************************/
 
 
-// TODO ...
+Chandelier::Chandelier ( int _slotsCount )
+	:	m_slotsCount( _slotsCount ), m_mode( Power_Off )
+{
+	if ( _slotsCount <= 0 )
+		throw std::logic_error( "Non-positive number of slots" );
+
+	m_pSlotPowers = new int[ m_slotsCount ]();
+
+	std::fill( m_modeTotals, m_modeTotals + PowerModesCount, 0LL );
+}
+
+
+/*****************************************************************************/
+
+
+Chandelier::Chandelier ( Chandelier const & _c )
+	:	m_slotsCount( _c.m_slotsCount ), m_mode( _c.m_mode )
+{
+	m_pSlotPowers = new int[ m_slotsCount ];
+	std::copy( _c.m_pSlotPowers, _c.m_pSlotPowers + m_slotsCount, m_pSlotPowers );
+
+	std::copy( _c.m_modeTotals, _c.m_modeTotals + PowerModesCount, m_modeTotals );
+}
+
+
+/*****************************************************************************/
+
+
+Chandelier::Chandelier ( Chandelier && _c )
+	:	m_slotsCount( _c.m_slotsCount ), m_pSlotPowers( _c.m_pSlotPowers ), m_mode( _c.m_mode )
+{
+	std::copy( _c.m_modeTotals, _c.m_modeTotals + PowerModesCount, m_modeTotals );
+
+	_c.m_slotsCount = 0;
+	_c.m_pSlotPowers = nullptr;
+}
+
+
+/*****************************************************************************/
+
+
+Chandelier::~Chandelier ()
+{
+	delete[] m_pSlotPowers;
+}
+
+
+/*****************************************************************************/
+
+
+Chandelier & Chandelier::operator = ( Chandelier const & _c )
+{
+	if ( & _c == this )
+		return * this;
+
+	Chandelier copy( _c );
+	return * this = std::move( copy );
+}
+
+
+/*****************************************************************************/
+
+
+Chandelier & Chandelier::operator = ( Chandelier && _c )
+{
+	if ( & _c == this )
+		return * this;
+
+	std::swap( m_slotsCount, _c.m_slotsCount );
+	std::swap( m_pSlotPowers, _c.m_pSlotPowers );
+	std::swap( m_mode, _c.m_mode );
+	std::swap_ranges( m_modeTotals, m_modeTotals + PowerModesCount, _c.m_modeTotals );
+
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+int Chandelier::getLitSlotsCount ( PowerMode _mode ) const
+{
+	switch ( _mode )
+	{
+		case Power_Full:
+			return m_slotsCount;
+
+		case Power_Half:
+			return m_slotsCount / 2;
+
+		case Power_Third:
+			return m_slotsCount / 3;
+
+		default:
+			return 0;
+	}
+}
+
+
+/*****************************************************************************/
+
+
+int Chandelier::getSlotPower ( int _slotIndex ) const
+{
+	if ( _slotIndex < 0 || _slotIndex >= m_slotsCount )
+		throw std::logic_error( "Out of range" );
+
+	return m_pSlotPowers[ _slotIndex ];
+}
+
+
+/*****************************************************************************/
+
+
+void Chandelier::setSlotPower ( int _slotIndex, int _power )
+{
+	setSlotPowers( _slotIndex, & _power, 1 );
+}
+
+
+/*****************************************************************************/
+
+
+long long Chandelier::replacePowers ( int _firstSlotIndex, int _lastSlotIndex, int const * _pPowers )
+{
+	long long change = 0;
+	for ( int i = _firstSlotIndex; i < _lastSlotIndex; ++i )
+	{
+		change += static_cast< long long >( _pPowers[ i - _firstSlotIndex ] ) - m_pSlotPowers[ i ];
+		m_pSlotPowers[ i ] = _pPowers[ i - _firstSlotIndex ];
+	}
+
+	return change;
+}
+
+
+/*****************************************************************************/
+
+
+void Chandelier::setSlotPowers ( int _firstSlotIndex, int const * _pPowers, int _count )
+{
+	if ( _firstSlotIndex < 0 || _count < 0 || _count > m_slotsCount - _firstSlotIndex )
+		throw std::logic_error( "Out of range" );
+
+	int minPower = 0;
+	for ( int i = 0; i < _count; ++i )
+		minPower = std::min( minPower, _pPowers[ i ] );
+
+	if ( minPower < 0 )
+		throw std::logic_error( "Negative power" );
+
+	// The range is cut at the ends of the third and of the half, so every piece
+	// changes the totals of the same set of modes
+	const int lastSlotIndex = _firstSlotIndex + _count;
+	const int thirdEnd = std::max( std::min( getLitSlotsCount( Power_Third ), lastSlotIndex ), _firstSlotIndex );
+	const int halfEnd = std::max( std::min( getLitSlotsCount( Power_Half ), lastSlotIndex ), thirdEnd );
+
+	long long thirdChange = replacePowers( _firstSlotIndex, thirdEnd, _pPowers );
+	long long halfChange = thirdChange + replacePowers( thirdEnd, halfEnd, _pPowers + ( thirdEnd - _firstSlotIndex ) );
+	long long fullChange = halfChange + replacePowers( halfEnd, lastSlotIndex, _pPowers + ( halfEnd - _firstSlotIndex ) );
+
+	m_modeTotals[ Power_Third ] += thirdChange;
+	m_modeTotals[ Power_Half ] += halfChange;
+	m_modeTotals[ Power_Full ] += fullChange;
+}
+
+
+/*****************************************************************************/
+
+
+std::ostream & operator << ( std::ostream & _o, Chandelier const & _c )
+{
+	_o << '(';
+
+	if ( _c.getPowerMode() != Chandelier::Power_Off )
+	{
+		bool first = true;
+		for ( int i = 0; i < _c.getSlotsCount(); ++i )
+		{
+			int power = _c.getSlotPower( i );
+			if ( ! power )
+				continue;
+
+			if ( ! first )
+				_o << '-';
+
+			_o << power;
+			first = false;
+		}
+	}
+
+	_o << ')';
+	return _o;
+}
 
 
 /*****************************************************************************/
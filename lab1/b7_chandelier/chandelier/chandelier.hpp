@@ -9,6 +9,14 @@
 
 /*****************************************************************************/
 
+/*
+	Slots with lamp powers and a mode deciding which of them are lit: all,
+	the first half, or the first third of the slots.
+
+	The lit sets of the modes are nested prefixes, so the chandelier keeps the
+	total power of every mode up to date on each slot change. Total power
+	queries and mode switches take constant time regardless of the slots count.
+*/
 
 class Chandelier
 {
@@ -29,13 +37,119 @@ public:
 
 /*------------------------------------------------------------------*/
 
-	// TODO ...
+	explicit Chandelier ( int _slotsCount );
+
+	Chandelier ( Chandelier const & _c );
+
+	Chandelier ( Chandelier && _c );
+
+	~Chandelier ();
+
+	Chandelier & operator = ( Chandelier const & _c );
+
+	Chandelier & operator = ( Chandelier && _c );
+
+/*------------------------------------------------------------------*/
+
+	int getSlotsCount () const;
+
+	int getSlotPower ( int _slotIndex ) const;
+
+	void setSlotPower ( int _slotIndex, int _power );
+
+	// Assigns _count powers to the slots starting from _firstSlotIndex;
+	// nothing changes unless the whole range and all the powers are valid
+	void setSlotPowers ( int _firstSlotIndex, int const * _pPowers, int _count );
+
+/*------------------------------------------------------------------*/
+
+	PowerMode getPowerMode () const;
+
+	void setPowerMode ( PowerMode _mode );
+
+	int getLitSlotsCount () const;
+
+	long long getTotalPower () const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	int getLitSlotsCount ( PowerMode _mode ) const;
+
+	// Writes powers into [ _firstSlotIndex, _lastSlotIndex ) and returns the change of their sum
+	long long replacePowers ( int _firstSlotIndex, int _lastSlotIndex, int const * _pPowers );
+
+/*------------------------------------------------------------------*/
+
+	static const int PowerModesCount = 4;
+
+	int m_slotsCount;
+
+	int * m_pSlotPowers;
+
+	PowerMode m_mode;
+
+	long long m_modeTotals[ PowerModesCount ];
 
 /*------------------------------------------------------------------*/
 
 };
 
 
+/*****************************************************************************/
+
+
+std::ostream & operator << ( std::ostream & _o, Chandelier const & _c );
+
+
+/*****************************************************************************/
+
+
+inline int Chandelier::getSlotsCount () const
+{
+	return m_slotsCount;
+}
+
+
+/*****************************************************************************/
+
+
+inline Chandelier::PowerMode Chandelier::getPowerMode () const
+{
+	return m_mode;
+}
+
+
+/*****************************************************************************/
+
+
+inline void Chandelier::setPowerMode ( PowerMode _mode )
+{
+	m_mode = _mode;
+}
+
+
+/*****************************************************************************/
+
+
+inline int Chandelier::getLitSlotsCount () const
+{
+	return getLitSlotsCount( m_mode );
+}
+
+
+/*****************************************************************************/
+
+
+inline long long Chandelier::getTotalPower () const
+{
+	return m_modeTotals[ m_mode ];
+}
+
+
 /*****************************************************************************/
 
 #endif //  _CHANDELIER_HPP_
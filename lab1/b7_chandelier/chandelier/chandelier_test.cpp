@@ -7,6 +7,7 @@
 #include "chandelier.hpp"
 
 #include <sstream>
+#include <vector>
 
 /*****************************************************************************/
 
@@ -316,4 +317,82 @@ DECLARE_OOP_TEST( chandelier_test_copy_move_assignment )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( chandelier_test_set_slot_powers )
+{
+	const int nSlots = 100000;
+	Chandelier c( nSlots );
+
+	std::vector< int > powers( nSlots );
+	for ( int i = 0; i < nSlots; ++i )
+		powers[ i ] = i % 7 * 10;
+
+	c.setSlotPowers( 0, powers.data(), nSlots );
+
+	// Overwrite a range crossing the ends of the third and of the half
+	std::vector< int > patch( 50000, 25 );
+	c.setSlotPowers( 20000, patch.data(), static_cast< int >( patch.size() ) );
+	std::fill( powers.begin() + 20000, powers.begin() + 70000, 25 );
+
+	const Chandelier::PowerMode modes[] = { Chandelier::Power_Third, Chandelier::Power_Full, Chandelier::Power_Off, Chandelier::Power_Half };
+	for ( Chandelier::PowerMode mode : modes )
+	{
+		c.setPowerMode( mode );
+
+		long long expected = 0;
+		for ( int i = 0; i < c.getLitSlotsCount(); ++i )
+			expected += powers[ i ];
+
+		assert( c.getTotalPower() == expected );
+	}
+
+	assert( c.getSlotPower( 19999 ) == 19999 % 7 * 10 );
+	assert( c.getSlotPower( 20000 ) == 25 );
+	assert( c.getSlotPower( 69999 ) == 25 );
+	assert( c.getSlotPower( 70000 ) == 70000 % 7 * 10 );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( chandelier_test_set_slot_powers_wrong )
+{
+	Chandelier c( 4 );
+	c.setPowerMode( Chandelier::Power_Full );
+	c.setSlotPower( 3, 40 );
+
+	const int powers[] = { 10, 20, -30 };
+
+	try
+	{
+		c.setSlotPowers( 0, powers, 3 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Negative power" ) );
+	}
+
+	try
+	{
+		c.setSlotPowers( 2, powers, 3 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Out of range" ) );
+	}
+
+	// Nothing has changed
+	assert( c.getSlotPower( 0 ) == 0 );
+	assert( c.getTotalPower() == 40 );
+
+	c.setSlotPowers( 1, powers, 2 );
+	assert( c.getTotalPower() == 70 );
+}
+
+
 /*****************************************************************************/
@@ -0,0 +1,123 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "calendar_queue.hpp"
+
+#include <stdexcept>
+#include <algorithm>
+
+/*****************************************************************************/
+
+
+CalendarQueue::CalendarQueue ()
+	:	m_buckets( MinBucketsCount ), m_size( 0 ), m_bucketWidth( 1 )
+	,	m_lastTime( 0 ), m_currentBucket( 0 ), m_bucketTop( 1 )
+{
+}
+
+
+/*****************************************************************************/
+
+
+void CalendarQueue::insert ( Event const & _e )
+{
+	std::vector< Event > & bucket = m_buckets[ getBucket( _e.m_time ) ];
+
+	// Buckets hold a few events each, so a linear search beats a binary one
+	auto it = bucket.begin();
+	while ( it != bucket.end() && _e < * it )
+		++it;
+
+	bucket.insert( it, _e );
+}
+
+
+/*****************************************************************************/
+
+
+void CalendarQueue::push ( Event const & _e )
+{
+	if ( _e.m_time < m_lastTime )
+		throw std::logic_error( "Event in the past" );
+
+	insert( _e );
+
+	if ( ++ m_size > 2 * static_cast< int >( m_buckets.size() ) )
+		resize( 2 * static_cast< int >( m_buckets.size() ) );
+}
+
+
+/*****************************************************************************/
+
+
+CalendarQueue::Event CalendarQueue::pop ()
+{
+	if ( ! m_size )
+		throw std::logic_error( "Queue is empty" );
+
+	const int bucketsCount = static_cast< int >( m_buckets.size() );
+
+	// Walk the days of the current year looking for an event due in its own day
+	int bucket = m_currentBucket;
+	long long bucketTop = m_bucketTop;
+	int nVisited = 0;
+	while ( nVisited < bucketsCount
+		&& ( m_buckets[ bucket ].empty() || m_buckets[ bucket ].back().m_time >= bucketTop ) )
+	{
+		bucket = ( bucket + 1 ) % bucketsCount;
+		bucketTop += m_bucketWidth;
+		++ nVisited;
+	}
+
+	// Nothing due within a year: jump straight to the earliest event
+	if ( nVisited == bucketsCount )
+	{
+		bucket = -1;
+		for ( int i = 0; i < bucketsCount; ++i )
+			if ( ! m_buckets[ i ].empty() && ( bucket == -1 || m_buckets[ i ].back() < m_buckets[ bucket ].back() ) )
+				bucket = i;
+
+		bucketTop = ( m_buckets[ bucket ].back().m_time / m_bucketWidth + 1 ) * m_bucketWidth;
+	}
+
+	Event result = m_buckets[ bucket ].back();
+	m_buckets[ bucket ].pop_back();
+	-- m_size;
+
+	m_currentBucket = bucket;
+	m_bucketTop = bucketTop;
+	m_lastTime = result.m_time;
+
+	if ( bucketsCount > MinBucketsCount && m_size < bucketsCount / 2 )
+		resize( bucketsCount / 2 );
+
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+void CalendarQueue::resize ( int _bucketsCount )
+{
+	std::vector< Event > events;
+	events.reserve( m_size );
+	for ( std::vector< Event > const & bucket : m_buckets )
+		events.insert( events.end(), bucket.begin(), bucket.end() );
+
+	// A day spans about three average gaps between pending events
+	long long maxTime = m_lastTime;
+	for ( Event const & e : events )
+		maxTime = std::max( maxTime, e.m_time );
+
+	m_bucketWidth = events.empty() ? 1 : std::max( 1LL, 3 * ( maxTime - m_lastTime ) / static_cast< long long >( events.size() ) );
+
+	m_buckets.assign( _bucketsCount, std::vector< Event >() );
+	for ( Event const & e : events )
+		insert( e );
+
+	m_currentBucket = getBucket( m_lastTime );
+	m_bucketTop = ( m_lastTime / m_bucketWidth + 1 ) * m_bucketWidth;
+}
+
+
+/*****************************************************************************/
@@ -0,0 +1,135 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _CALENDAR_QUEUE_HPP_
+#define _CALENDAR_QUEUE_HPP_
+
+/*****************************************************************************/
+
+#include <vector>
+
+/*****************************************************************************/
+
+/*
+	Pending events of a discrete-event simulation, ordered by time.
+
+	Events are spread over a ring of buckets ("days" of a "year"), each bucket
+	covering a fixed span of time and kept sorted. Popping the earliest event
+	scans forward from the current day, so both operations take constant time
+	on average, unlike the logarithmic cost of a binary heap. The bucket count
+	and span are recomputed whenever the number of events doubles or halves.
+
+	Events never go back in time: an event may not precede the last one popped.
+	Simultaneous events come out ordered by machine and kind, which keeps runs
+	reproducible.
+*/
+
+class CalendarQueue
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*------------------------------------------------------------------*/
+
+	struct Event
+	{
+		long long m_time;
+		int m_machine;
+		int m_kind;
+
+		bool operator < ( Event const & _e ) const;
+	};
+
+/*------------------------------------------------------------------*/
+
+	CalendarQueue ();
+
+	int getSize () const;
+
+	bool isEmpty () const;
+
+	void push ( Event const & _e );
+
+	Event pop ();
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	int getBucket ( long long _time ) const;
+
+	void insert ( Event const & _e );
+
+	void resize ( int _bucketsCount );
+
+/*------------------------------------------------------------------*/
+
+	static const int MinBucketsCount = 16;
+
+	// Each bucket is sorted latest first, so its earliest event is at the back
+	std::vector< std::vector< Event > > m_buckets;
+
+	int m_size;
+
+	long long m_bucketWidth;
+
+	long long m_lastTime;
+
+	int m_currentBucket;
+
+	// End of the span covered by the current bucket in the current year
+	long long m_bucketTop;
+
+/*------------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline bool CalendarQueue::Event::operator < ( Event const & _e ) const
+{
+	if ( m_time != _e.m_time )
+		return m_time < _e.m_time;
+
+	if ( m_machine != _e.m_machine )
+		return m_machine < _e.m_machine;
+
+	return m_kind < _e.m_kind;
+}
+
+
+/*****************************************************************************/
+
+
+inline int CalendarQueue::getSize () const
+{
+	return m_size;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool CalendarQueue::isEmpty () const
+{
+	return m_size == 0;
+}
+
+
+/*****************************************************************************/
+
+
+inline int CalendarQueue::getBucket ( long long _time ) const
+{
+	return static_cast< int >( ( _time / m_bucketWidth ) % m_buckets.size() );
+}
+
+
+/*****************************************************************************/
+
+#endif //  _CALENDAR_QUEUE_HPP_
@@ -0,0 +1,270 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "coffee_fleet_simulator.hpp"
+
+#include <stdexcept>
+#include <thread>
+#include <exception>
+#include <cmath>
+
+/*****************************************************************************/
+
+
+bool CoffeeFleetSimulator::MachineMetrics::operator == ( MachineMetrics const & _m ) const
+{
+	return m_ordersServed == _m.m_ordersServed
+		&& m_ordersLost == _m.m_ordersLost
+		&& m_stockOutsCount == _m.m_stockOutsCount
+		&& m_stockOutTime == _m.m_stockOutTime
+		&& m_waterLoaded == _m.m_waterLoaded
+		&& m_beansLoaded == _m.m_beansLoaded;
+}
+
+
+/*****************************************************************************/
+
+
+CoffeeFleetSimulator::CoffeeFleetSimulator ( Settings const & _settings )
+	:	m_settings( _settings ), m_eventsCount( 0 )
+{
+	if ( _settings.m_machinesCount <= 0
+		|| _settings.m_maxBeansWeight <= 0 || _settings.m_maxWaterVolume <= 0 || _settings.m_wastePortions <= 0
+		|| _settings.m_meanOrderInterval <= 0 || _settings.m_refillInterval <= 0 || _settings.m_cleaningInterval <= 0
+		|| _settings.m_duration <= 0
+	)
+		throw std::logic_error( "Incorrect simulation parameters" );
+
+	m_metrics.resize( _settings.m_machinesCount, MachineMetrics() );
+}
+
+
+/*****************************************************************************/
+
+
+unsigned long long CoffeeFleetSimulator::nextRandom ( unsigned long long & _state )
+{
+	// SplitMix64: fast, and equally distributed for any seed, including nearby ones
+	unsigned long long z = ( _state += 0x9E3779B97F4A7C15ull );
+	z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+	z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+	return z ^ ( z >> 31 );
+}
+
+
+/*****************************************************************************/
+
+
+double CoffeeFleetSimulator::nextUniform ( unsigned long long & _state )
+{
+	// 53 random bits in [0, 1)
+	return ( nextRandom( _state ) >> 11 ) * ( 1.0 / 9007199254740992.0 );
+}
+
+
+/*****************************************************************************/
+
+
+void CoffeeFleetSimulator::run ( int _threadsCount )
+{
+	if ( _threadsCount <= 0 )
+		throw std::logic_error( "Incorrect threads count" );
+
+	const int machinesCount = m_settings.m_machinesCount;
+	if ( _threadsCount > machinesCount )
+		_threadsCount = machinesCount;
+
+	m_metrics.assign( machinesCount, MachineMetrics() );
+
+	// Partitions are disjoint, so threads write their own metrics without locking.
+	// Errors are kept per partition, as an exception leaving a thread would terminate
+	std::vector< long long > eventsCounts( _threadsCount );
+	std::vector< std::exception_ptr > errors( _threadsCount );
+
+	auto simulate = [ this, _threadsCount, machinesCount, & eventsCounts, & errors ] ( int _partition )
+	{
+		try
+		{
+			eventsCounts[ _partition ] = simulatePartition(
+				static_cast< int >( static_cast< long long >( machinesCount ) * _partition / _threadsCount ),
+				static_cast< int >( static_cast< long long >( machinesCount ) * ( _partition + 1 ) / _threadsCount )
+			);
+		}
+		catch ( ... )
+		{
+			errors[ _partition ] = std::current_exception();
+		}
+	};
+
+	std::vector< std::thread > threads;
+	try
+	{
+		for ( int i = 1; i < _threadsCount; ++i )
+			threads.emplace_back( simulate, i );
+
+		simulate( 0 );
+	}
+	catch ( ... )
+	{
+		// A thread could not be started; the ones running are still joined
+		errors[ 0 ] = std::current_exception();
+	}
+
+	for ( std::thread & t : threads )
+		t.join();
+
+	for ( std::exception_ptr const & error : errors )
+		if ( error )
+			std::rethrow_exception( error );
+
+	m_eventsCount = 0;
+	for ( long long count : eventsCounts )
+		m_eventsCount += count;
+}
+
+
+/*****************************************************************************/
+
+
+long long CoffeeFleetSimulator::simulatePartition ( int _firstMachine, int _lastMachine )
+{
+	const int machinesCount = _lastMachine - _firstMachine;
+
+	std::vector< CoffeeMachine > machines;
+	machines.reserve( machinesCount );
+
+	std::vector< unsigned long long > randomStates( machinesCount );
+	std::vector< long long > stockOutStarts( machinesCount, -1 );
+
+	CalendarQueue queue;
+
+	auto nextOrderTime = [ & ] ( int _local, long long _now ) -> long long
+	{
+		// Exponential intervals: orders arrive as a Poisson stream
+		double interval = -std::log( 1.0 - nextUniform( randomStates[ _local ] ) ) * m_settings.m_meanOrderInterval;
+		return _now + 1 + static_cast< long long >( interval );
+	};
+
+	for ( int i = 0; i < machinesCount; ++i )
+	{
+		const int machine = _firstMachine + i;
+
+		machines.emplace_back( m_settings.m_maxBeansWeight, m_settings.m_maxWaterVolume, m_settings.m_wastePortions );
+		machines.back().loadWater();
+		machines.back().loadBeans();
+
+		unsigned long long & state = randomStates[ i ];
+		state = m_settings.m_seed ^ ( 0xD1B54A32D192ED03ull * ( machine + 1 ) );
+
+		queue.push( CalendarQueue::Event{ nextOrderTime( i, 0 ), machine, Event_Order } );
+		queue.push( CalendarQueue::Event{
+			static_cast< long long >( nextUniform( state ) * m_settings.m_refillInterval ), machine, Event_Refill
+		} );
+		queue.push( CalendarQueue::Event{
+			static_cast< long long >( nextUniform( state ) * m_settings.m_cleaningInterval ), machine, Event_Cleaning
+		} );
+	}
+
+	long long eventsCount = 0;
+	while ( ! queue.isEmpty() )
+	{
+		const CalendarQueue::Event e = queue.pop();
+		if ( e.m_time >= m_settings.m_duration )
+			break;
+
+		++ eventsCount;
+
+		const int local = e.m_machine - _firstMachine;
+		CoffeeMachine & machine = machines[ local ];
+		MachineMetrics & metrics = m_metrics[ e.m_machine ];
+
+		bool canServe;
+		switch ( e.m_kind )
+		{
+			case Event_Order:
+			{
+				const unsigned long long choice = nextRandom( randomStates[ local ] );
+				const CoffeeMachine::Recipe recipe = static_cast< CoffeeMachine::Recipe >( choice % 2 );
+				const CoffeeMachine::Strength strength = static_cast< CoffeeMachine::Strength >( ( choice >> 1 ) % 3 );
+
+				canServe = machine.makeCoffee( recipe, strength );
+				if ( canServe )
+					++ metrics.m_ordersServed;
+				else
+					++ metrics.m_ordersLost;
+
+				queue.push( CalendarQueue::Event{ nextOrderTime( local, e.m_time ), e.m_machine, Event_Order } );
+				break;
+			}
+
+			case Event_Refill:
+				metrics.m_waterLoaded += machine.loadWater();
+				metrics.m_beansLoaded += machine.loadBeans();
+				canServe = static_cast< bool >( machine );
+
+				queue.push( CalendarQueue::Event{ e.m_time + m_settings.m_refillInterval, e.m_machine, Event_Refill } );
+				break;
+
+			case Event_Cleaning:
+				machine.cleanWaste();
+				machine.washMachine();
+				canServe = static_cast< bool >( machine );
+
+				queue.push( CalendarQueue::Event{ e.m_time + m_settings.m_cleaningInterval, e.m_machine, Event_Cleaning } );
+				break;
+
+			default:
+				throw std::logic_error( "Unknown event" );
+		}
+
+		long long & stockOutStart = stockOutStarts[ local ];
+		if ( ! canServe && e.m_kind == Event_Order && stockOutStart == -1 )
+		{
+			stockOutStart = e.m_time;
+			++ metrics.m_stockOutsCount;
+		}
+		else if ( canServe && stockOutStart != -1 )
+		{
+			metrics.m_stockOutTime += e.m_time - stockOutStart;
+			stockOutStart = -1;
+		}
+	}
+
+	for ( int i = 0; i < machinesCount; ++i )
+		if ( stockOutStarts[ i ] != -1 )
+			m_metrics[ _firstMachine + i ].m_stockOutTime += m_settings.m_duration - stockOutStarts[ i ];
+
+	return eventsCount;
+}
+
+
+/*****************************************************************************/
+
+
+CoffeeFleetSimulator::MachineMetrics const & CoffeeFleetSimulator::getMetrics ( int _machine ) const
+{
+	if ( _machine < 0 || _machine >= m_settings.m_machinesCount )
+		throw std::logic_error( "Machine index out of range" );
+
+	return m_metrics[ _machine ];
+}
+
+
+/*****************************************************************************/
+
+
+double CoffeeFleetSimulator::getThroughput ( int _machine ) const
+{
+	return getMetrics( _machine ).m_ordersServed * 3600.0 / m_settings.m_duration;
+}
+
+
+/*****************************************************************************/
+
+
+double CoffeeFleetSimulator::getStockOutRatio ( int _machine ) const
+{
+	return static_cast< double >( getMetrics( _machine ).m_stockOutTime ) / m_settings.m_duration;
+}
+
+
+/*****************************************************************************/
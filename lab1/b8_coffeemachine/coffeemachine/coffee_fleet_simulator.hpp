@@ -0,0 +1,139 @@
+// (C) 2013-2015, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _COFFEE_FLEET_SIMULATOR_HPP_
+#define _COFFEE_FLEET_SIMULATOR_HPP_
+
+/*****************************************************************************/
+
+#include "coffeemachine.hpp"
+#include "calendar_queue.hpp"
+
+#include <vector>
+
+/*****************************************************************************/
+
+/*
+	Discrete-event simulation of a fleet of identical coffee machines.
+
+	Every machine receives orders at random intervals, is refilled with water
+	and beans on a fixed round, and has its waste cleaned and gets washed on
+	another round. Rounds start at a random offset per machine. Orders pick
+	a random recipe and strength; an order the machine cannot make is lost.
+
+	Machines do not affect each other, so the fleet is split into contiguous
+	partitions simulated by separate threads, each with its own calendar queue.
+	Every machine draws from its own random stream seeded from the fleet seed
+	and its index, so the results depend on the seed only, not on the number
+	of threads.
+
+	Time is measured in whole seconds.
+*/
+
+class CoffeeFleetSimulator
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*------------------------------------------------------------------*/
+
+	struct Settings
+	{
+		int m_machinesCount;
+
+		int m_maxBeansWeight, m_maxWaterVolume, m_wastePortions;
+
+		int m_meanOrderInterval;
+		int m_refillInterval;
+		int m_cleaningInterval;
+
+		long long m_duration;
+
+		unsigned long long m_seed;
+	};
+
+	struct MachineMetrics
+	{
+		int m_ordersServed;
+		int m_ordersLost;
+
+		// A stock-out starts with a lost order and ends when the machine can serve again
+		int m_stockOutsCount;
+		long long m_stockOutTime;
+
+		long long m_waterLoaded;
+		long long m_beansLoaded;
+
+		bool operator == ( MachineMetrics const & _m ) const;
+	};
+
+/*------------------------------------------------------------------*/
+
+	explicit CoffeeFleetSimulator ( Settings const & _settings );
+
+	Settings const & getSettings () const;
+
+	// Rethrows the first error of a partition once all the threads are joined
+	void run ( int _threadsCount );
+
+/*------------------------------------------------------------------*/
+
+	long long getEventsCount () const;
+
+	MachineMetrics const & getMetrics ( int _machine ) const;
+
+	// Orders served per hour of simulated time
+	double getThroughput ( int _machine ) const;
+
+	// Share of simulated time the machine spent out of stock
+	double getStockOutRatio ( int _machine ) const;
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	enum EventKind { Event_Order, Event_Refill, Event_Cleaning };
+
+	static unsigned long long nextRandom ( unsigned long long & _state );
+
+	static double nextUniform ( unsigned long long & _state );
+
+	long long simulatePartition ( int _firstMachine, int _lastMachine );
+
+/*------------------------------------------------------------------*/
+
+	const Settings m_settings;
+
+	std::vector< MachineMetrics > m_metrics;
+
+	long long m_eventsCount;
+
+/*------------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline CoffeeFleetSimulator::Settings const & CoffeeFleetSimulator::getSettings () const
+{
+	return m_settings;
+}
+
+
+/*****************************************************************************/
+
+
+inline long long CoffeeFleetSimulator::getEventsCount () const
+{
+	return m_eventsCount;
+}
+
+
+/*****************************************************************************/
+
+#endif //  _COFFEE_FLEET_SIMULATOR_HPP_
@@ -6,6 +6,105 @@
 
 /*****************************************************************************/
 
-// TODO ...
+
+const int CoffeeMachine::WATER_FOR_ESPRESSO;
+const int CoffeeMachine::WATER_FOR_AMERICANO;
+const int CoffeeMachine::WATER_FOR_WASHING;
+const int CoffeeMachine::BEANS_FOR_LIGHT;
+const int CoffeeMachine::BEANS_FOR_MEDIUM;
+const int CoffeeMachine::BEANS_FOR_STRONG;
+
+
+/*****************************************************************************/
+
+
+CoffeeMachine::CoffeeMachine ( int _maxBeansWeight, int _maxWaterVolume, int _wastePortions )
+	:	m_maxBeansWeight( _maxBeansWeight ), m_maxWaterVolume( _maxWaterVolume ), m_wastePortions( _wastePortions )
+	,	m_beansWeight( 0 ), m_waterVolume( 0 ), m_usedWastePortions( 0 )
+{
+	if ( _maxBeansWeight <= 0 || _maxWaterVolume <= 0 || _wastePortions <= 0 )
+		throw std::logic_error( "Incorrect initial parameters" );
+}
+
+
+/*****************************************************************************/
+
+
+int CoffeeMachine::getWaterForRecipe ( Recipe _recipe )
+{
+	return ( _recipe == Espresso ) ? WATER_FOR_ESPRESSO : WATER_FOR_AMERICANO;
+}
+
+
+/*****************************************************************************/
+
+
+int CoffeeMachine::getBeansForStrength ( Strength _strength )
+{
+	switch ( _strength )
+	{
+		case Light:
+			return BEANS_FOR_LIGHT;
+
+		case Medium:
+			return BEANS_FOR_MEDIUM;
+
+		case Strong:
+			return BEANS_FOR_STRONG;
+
+		default:
+			throw std::logic_error( "Unknown strength" );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+int CoffeeMachine::loadWater ()
+{
+	int added = m_maxWaterVolume - m_waterVolume;
+	m_waterVolume = m_maxWaterVolume;
+	return added;
+}
+
+
+/*****************************************************************************/
+
+
+int CoffeeMachine::loadBeans ()
+{
+	int added = m_maxBeansWeight - m_beansWeight;
+	m_beansWeight = m_maxBeansWeight;
+	return added;
+}
+
+
+/*****************************************************************************/
+
+
+bool CoffeeMachine::makeCoffee ( Recipe _recipe, Strength _strength )
+{
+	const int water = getWaterForRecipe( _recipe );
+	const int beans = getBeansForStrength( _strength );
+
+	if ( m_waterVolume < water || m_beansWeight < beans || m_usedWastePortions == m_wastePortions )
+		return false;
+
+	m_waterVolume -= water;
+	m_beansWeight -= beans;
+	++ m_usedWastePortions;
+	return true;
+}
+
+
+/*****************************************************************************/
+
+
+void CoffeeMachine::washMachine ()
+{
+	m_waterVolume = ( m_waterVolume > WATER_FOR_WASHING ) ? m_waterVolume - WATER_FOR_WASHING : 0;
+}
+
 
 /*****************************************************************************/
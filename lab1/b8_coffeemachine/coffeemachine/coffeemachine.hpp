@@ -25,13 +25,100 @@ public:
 
 /*------------------------------------------------------------------*/
 
-	// TODO ...
+	CoffeeMachine ( int _maxBeansWeight, int _maxWaterVolume, int _wastePortions );
+
+/*------------------------------------------------------------------*/
+
+	int getBeansWeight () const;
+
+	int getWaterVolume () const;
+
+	int getFreeWastePortions () const;
+
+	// Whether the weakest espresso can be made right now
+	explicit operator bool () const;
+
+/*------------------------------------------------------------------*/
+
+	// Fill up to the maximum; return the amount added
+	int loadWater ();
+
+	int loadBeans ();
+
+	bool makeCoffee ( Recipe _recipe, Strength _strength );
+
+	void cleanWaste ();
+
+	void washMachine ();
+
+/*------------------------------------------------------------------*/
+
+	static int getWaterForRecipe ( Recipe _recipe );
+
+	static int getBeansForStrength ( Strength _strength );
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	int m_maxBeansWeight, m_maxWaterVolume, m_wastePortions;
+
+	int m_beansWeight, m_waterVolume, m_usedWastePortions;
 
 /*------------------------------------------------------------------*/
 
 };
 
 
+/*****************************************************************************/
+
+
+inline int CoffeeMachine::getBeansWeight () const
+{
+	return m_beansWeight;
+}
+
+
+/*****************************************************************************/
+
+
+inline int CoffeeMachine::getWaterVolume () const
+{
+	return m_waterVolume;
+}
+
+
+/*****************************************************************************/
+
+
+inline int CoffeeMachine::getFreeWastePortions () const
+{
+	return m_wastePortions - m_usedWastePortions;
+}
+
+
+/*****************************************************************************/
+
+
+inline CoffeeMachine::operator bool () const
+{
+	return m_beansWeight >= BEANS_FOR_LIGHT
+		&& m_waterVolume >= WATER_FOR_ESPRESSO
+		&& m_usedWastePortions < m_wastePortions;
+}
+
+
+/*****************************************************************************/
+
+
+inline void CoffeeMachine::cleanWaste ()
+{
+	m_usedWastePortions = 0;
+}
+
+
 /*****************************************************************************/
 
 #endif //  _COFFEEMACHINE_HPP_
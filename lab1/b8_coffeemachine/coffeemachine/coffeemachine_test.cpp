@@ -5,6 +5,8 @@
 #include "testslib.hpp"
 
 #include "coffeemachine.hpp"
+#include "calendar_queue.hpp"
+#include "coffee_fleet_simulator.hpp"
 
 /*****************************************************************************/
 
@@ -273,4 +275,152 @@ DECLARE_OOP_TEST( coffee_test_correct_resource_uses )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( coffee_test_calendar_queue_order )
+{
+	CalendarQueue q;
+	std::vector< CalendarQueue::Event > popped;
+
+	// Interleave pushes and pops, as a simulation does, with gaps of varying scale
+	unsigned state = 12345;
+	long long now = 0;
+	int nPushed = 0;
+	for ( int round = 0; round < 2000; ++round )
+	{
+		for ( int i = 0; i < 3; ++i )
+		{
+			state = state * 1103515245u + 12345u;
+			long long delay = ( round % 500 < 250 ) ? ( state >> 16 ) % 50 : ( state >> 8 ) % 100000;
+			q.push( CalendarQueue::Event{ now + delay, static_cast< int >( state % 7 ), i } );
+			++ nPushed;
+		}
+
+		for ( int i = 0; i < 2; ++i )
+		{
+			popped.push_back( q.pop() );
+			now = popped.back().m_time;
+		}
+	}
+
+	while ( ! q.isEmpty() )
+		popped.push_back( q.pop() );
+
+	assert( static_cast< int >( popped.size() ) == nPushed );
+	for ( int i = 1; i < nPushed; ++i )
+		assert( popped[ i - 1 ].m_time <= popped[ i ].m_time );
+
+	try
+	{
+		q.pop();
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Queue is empty" ) );
+	}
+
+	try
+	{
+		q.push( CalendarQueue::Event{ now - 1, 0, 0 } );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Event in the past" ) );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( coffee_test_fleet_simulation_is_deterministic )
+{
+	CoffeeFleetSimulator::Settings settings;
+	settings.m_machinesCount = 37;
+	settings.m_maxBeansWeight = 300;
+	settings.m_maxWaterVolume = 2000;
+	settings.m_wastePortions = 16;
+	settings.m_meanOrderInterval = 600;
+	settings.m_refillInterval = 4 * 3600;
+	settings.m_cleaningInterval = 6 * 3600;
+	settings.m_duration = 7 * 24 * 3600;
+	settings.m_seed = 2015;
+
+	CoffeeFleetSimulator single( settings );
+	single.run( 1 );
+
+	CoffeeFleetSimulator parallel( settings );
+	parallel.run( 4 );
+
+	assert( single.getEventsCount() == parallel.getEventsCount() );
+
+	int nStockOuts = 0;
+	for ( int i = 0; i < settings.m_machinesCount; ++i )
+	{
+		CoffeeFleetSimulator::MachineMetrics const & m = single.getMetrics( i );
+		assert( m == parallel.getMetrics( i ) );
+
+		assert( m.m_ordersServed > 0 );
+		assert( m.m_stockOutTime <= settings.m_duration );
+		assert( single.getThroughput( i ) <= 6.0 * 3600 / settings.m_meanOrderInterval );
+		assert( single.getStockOutRatio( i ) >= 0.0 && single.getStockOutRatio( i ) <= 1.0 );
+
+		nStockOuts += m.m_stockOutsCount;
+	}
+
+	// Sixteen waste portions last about three hours of orders, shorter than the cleaning round
+	assert( nStockOuts > 0 );
+
+	settings.m_seed = 2016;
+	CoffeeFleetSimulator other( settings );
+	other.run( 2 );
+	assert( other.getEventsCount() != single.getEventsCount() );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( coffee_test_fleet_simulation_wrong_parameters )
+{
+	CoffeeFleetSimulator::Settings settings = { 10, 300, 2000, 16, 600, 3600, 3600, 0, 1 };
+
+	try
+	{
+		CoffeeFleetSimulator s( settings );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Incorrect simulation parameters" ) );
+	}
+
+	settings.m_duration = 3600;
+	CoffeeFleetSimulator s( settings );
+
+	try
+	{
+		s.run( 0 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Incorrect threads count" ) );
+	}
+
+	try
+	{
+		s.getMetrics( 10 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Machine index out of range" ) );
+	}
+}
+
+
 /*****************************************************************************/
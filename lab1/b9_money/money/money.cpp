@@ -3,10 +3,343 @@
 #include "money.hpp"
 
 #include <stdexcept>
+#include <climits>
+#include <cmath>
 
 /*****************************************************************************/
 
-// TODO ...
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+// Values below 2^54 cents in magnitude cannot overflow when 256 of them are summed
+const int SumBlockSize = 256;
+const int SafeMagnitudeBits = 54;
+
+/*-----------------------------------------------------------------*/
+
+
+long long addCents ( long long _a, long long _b )
+{
+	long long result = static_cast< long long >(
+		static_cast< unsigned long long >( _a ) + static_cast< unsigned long long >( _b )
+	);
+
+	// Overflow happened only if both operands have a sign different from the result
+	if ( ( ( _a ^ result ) & ( _b ^ result ) ) < 0 )
+		throw std::overflow_error( "Money overflow" );
+
+	return result;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+void throwInvalidCents ()
+{
+	throw std::logic_error( "Invalid cents" );
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+void throwIncorrectFormat ()
+{
+	throw std::logic_error( "Incorrect money format" );
+}
+
+
+/*-----------------------------------------------------------------*/
+
+
+bool isDigit ( char _c )
+{
+	return _c >= '0' && _c <= '9';
+}
+
+
+/*-----------------------------------------------------------------*/
+
+}
+
+/*****************************************************************************/
+
+
+Money::Money ( long long _dollars, int _cents )
+{
+	if ( _cents < 0 || _cents > 99 )
+		throwInvalidCents();
+
+	// Leaves room for 99 cents on either side
+	if ( _dollars > ( LLONG_MAX - 99 ) / 100 || _dollars < ( LLONG_MIN + 99 ) / 100 )
+		throw std::overflow_error( "Money overflow" );
+
+	m_totalCents = ( _dollars < 0 ) ? _dollars * 100 - _cents : _dollars * 100 + _cents;
+}
+
+
+/*****************************************************************************/
+
+
+Money::Money ( double _amount )
+{
+	// Rounding to a tenth of a cent first absorbs binary representation errors,
+	// the remaining fraction of a cent is then truncated
+	double tenthsOfCents = std::round( _amount * 1000.0 );
+	if ( ! ( std::fabs( tenthsOfCents ) < 9.0e18 ) )
+		throw std::overflow_error( "Money overflow" );
+
+	m_totalCents = static_cast< long long >( tenthsOfCents ) / 10;
+}
+
+
+/*****************************************************************************/
+
+
+Money::Money ( const char * _amount )
+{
+	const char * p = _amount;
+
+	bool negative = ( * p == '-' );
+	if ( negative )
+		++ p;
+
+	if ( ! isDigit( * p ) )
+		throwIncorrectFormat();
+
+	long long dollars = 0;
+	while ( isDigit( * p ) )
+	{
+		if ( dollars > ( LLONG_MAX / 100 - 9 ) / 10 )
+			throwIncorrectFormat();
+
+		dollars = dollars * 10 + ( * p ++ - '0' );
+	}
+
+	if ( * p ++ != '.' )
+		throwIncorrectFormat();
+
+	bool negativeCents = ( * p == '-' );
+	if ( negativeCents )
+		++ p;
+
+	if ( ! isDigit( * p ) )
+		throwIncorrectFormat();
+
+	int cents = 0, nCentDigits = 0;
+	while ( isDigit( * p ) )
+	{
+		if ( nCentDigits < 3 )
+			cents = cents * 10 + ( * p - '0' );
+		++ nCentDigits;
+		++ p;
+	}
+
+	if ( * p != '\0' )
+		throwIncorrectFormat();
+
+	if ( negativeCents || nCentDigits > 2 )
+		throwInvalidCents();
+
+	if ( nCentDigits == 1 )
+		cents *= 10;
+
+	m_totalCents = dollars * 100 + cents;
+	if ( negative )
+		m_totalCents = - m_totalCents;
+}
+
+
+/*****************************************************************************/
+
+
+int Money::format ( char * _buffer, int _bufferSize ) const
+{
+	// Digits are produced right to left into a scratch area, then copied once
+	char scratch[ MaxStringLength ];
+	char * end = scratch + MaxStringLength;
+	char * p = end;
+
+	unsigned long long magnitude = ( m_totalCents < 0 )
+		?	0ULL - static_cast< unsigned long long >( m_totalCents )
+		:	static_cast< unsigned long long >( m_totalCents );
+
+	unsigned cents = static_cast< unsigned >( magnitude % 100 );
+	unsigned long long dollars = magnitude / 100;
+
+	* -- p = static_cast< char >( '0' + cents % 10 );
+	* -- p = static_cast< char >( '0' + cents / 10 );
+	* -- p = '.';
+
+	do
+	{
+		* -- p = static_cast< char >( '0' + dollars % 10 );
+		dollars /= 10;
+	}
+	while ( dollars );
+
+	if ( m_totalCents < 0 )
+		* -- p = '-';
+
+	int length = static_cast< int >( end - p );
+	if ( length >= _bufferSize )
+		throw std::logic_error( "Buffer too small" );
+
+	for ( int i = 0; i < length; ++i )
+		_buffer[ i ] = p[ i ];
+	_buffer[ length ] = '\0';
+
+	return length;
+}
+
+
+/*****************************************************************************/
+
+
+const char * Money::asString () const
+{
+	static thread_local char s_buffer[ MaxStringLength ];
+	format( s_buffer, MaxStringLength );
+	return s_buffer;
+}
+
+
+/*****************************************************************************/
+
+
+Money & Money::operator += ( Money _m )
+{
+	m_totalCents = addCents( m_totalCents, _m.m_totalCents );
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+Money & Money::operator -= ( Money _m )
+{
+	if ( _m.m_totalCents == LLONG_MIN )
+		throw std::overflow_error( "Money overflow" );
+
+	m_totalCents = addCents( m_totalCents, - _m.m_totalCents );
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+Money & Money::operator *= ( int _factor )
+{
+	if ( _factor != 0 )
+	{
+		long long limit = LLONG_MAX / ( _factor < 0 ? - static_cast< long long >( _factor ) : _factor );
+		if ( m_totalCents > limit || m_totalCents < - limit )
+			throw std::overflow_error( "Money overflow" );
+	}
+
+	m_totalCents *= _factor;
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+Money & Money::operator /= ( int _divisor )
+{
+	if ( _divisor == 0 )
+		throw std::logic_error( "Division by zero" );
+
+	if ( _divisor == -1 && m_totalCents == LLONG_MIN )
+		throw std::overflow_error( "Money overflow" );
+
+	m_totalCents /= _divisor;
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+Money Money::sum ( Money const * _pValues, int _count )
+{
+	long long total = 0;
+
+	for ( int blockStart = 0; blockStart < _count; blockStart += SumBlockSize )
+	{
+		int blockEnd = ( _count - blockStart > SumBlockSize ) ? blockStart + SumBlockSize : _count;
+
+		// Branch-free pass the compiler vectorizes: wrapping sum plus an OR of magnitudes
+		unsigned long long blockSum = 0, magnitudeBits = 0;
+		for ( int i = blockStart; i < blockEnd; ++i )
+		{
+			long long cents = _pValues[ i ].m_totalCents;
+			blockSum += static_cast< unsigned long long >( cents );
+			magnitudeBits |= static_cast< unsigned long long >( cents ^ ( cents >> 63 ) );
+		}
+
+		if ( ( magnitudeBits >> SafeMagnitudeBits ) == 0 )
+			total = addCents( total, static_cast< long long >( blockSum ) );
+
+		else
+			for ( int i = blockStart; i < blockEnd; ++i )
+				total = addCents( total, _pValues[ i ].m_totalCents );
+	}
+
+	return fromTotalCents( total );
+}
+
+
+/*****************************************************************************/
+
+
+Money Money::min ( Money const * _pValues, int _count )
+{
+	if ( _count <= 0 )
+		throw std::logic_error( "Empty money range" );
+
+	long long result = _pValues[ 0 ].m_totalCents;
+	for ( int i = 1; i < _count; ++i )
+	{
+		long long cents = _pValues[ i ].m_totalCents;
+		result = ( cents < result ) ? cents : result;
+	}
+
+	return fromTotalCents( result );
+}
+
+
+/*****************************************************************************/
+
+
+Money Money::max ( Money const * _pValues, int _count )
+{
+	if ( _count <= 0 )
+		throw std::logic_error( "Empty money range" );
+
+	long long result = _pValues[ 0 ].m_totalCents;
+	for ( int i = 1; i < _count; ++i )
+	{
+		long long cents = _pValues[ i ].m_totalCents;
+		result = ( cents > result ) ? cents : result;
+	}
+
+	return fromTotalCents( result );
+}
+
+
+/*****************************************************************************/
+
+
+Money operator "" _USD ( long double _amount )
+{
+	return Money( static_cast< double >( _amount ) );
+}
 
 
 /*****************************************************************************/
@@ -11,13 +11,208 @@ class Money
 
 /*-----------------------------------------------------------------*/
 
-	// TODO ...
+public:
+
+/*------------------------------------------------------------------*/
+
+	// Enough for the sign, 17 dollar digits, the point, 2 cents and '\0'
+	static const int MaxStringLength = 24;
+
+/*------------------------------------------------------------------*/
+
+	Money ();
+
+	Money ( long long _dollars, int _cents );
+
+	Money ( double _amount );
+
+	Money ( const char * _amount );
+
+	static Money fromTotalCents ( long long _totalCents );
+
+/*------------------------------------------------------------------*/
+
+	long long getDollars () const;
+
+	int getCents () const;
+
+	long long getTotalCents () const;
+
+/*------------------------------------------------------------------*/
+
+	// Writes "[-]D.CC" into the caller's buffer, returns the length without '\0'
+	int format ( char * _buffer, int _bufferSize ) const;
+
+	// Points to a per-thread buffer, valid until the next call on this thread
+	const char * asString () const;
+
+/*------------------------------------------------------------------*/
+
+	bool operator == ( Money _m ) const;
+	bool operator != ( Money _m ) const;
+	bool operator < ( Money _m ) const;
+	bool operator <= ( Money _m ) const;
+	bool operator > ( Money _m ) const;
+	bool operator >= ( Money _m ) const;
+
+	Money operator + ( Money _m ) const;
+	Money operator - ( Money _m ) const;
+	Money & operator += ( Money _m );
+	Money & operator -= ( Money _m );
+
+	Money operator * ( int _factor ) const;
+	Money operator / ( int _divisor ) const;
+	Money & operator *= ( int _factor );
+	Money & operator /= ( int _divisor );
+
+/*------------------------------------------------------------------*/
+
+	// Column kernels over contiguous arrays of values
+	static Money sum ( Money const * _pValues, int _count );
+
+	static Money min ( Money const * _pValues, int _count );
+
+	static Money max ( Money const * _pValues, int _count );
+
+/*------------------------------------------------------------------*/
+
+private:
+
+/*------------------------------------------------------------------*/
+
+	long long m_totalCents;
 
 /*------------------------------------------------------------------*/
 
 };
 
 
+/*****************************************************************************/
+
+
+inline Money::Money ()
+	:	m_totalCents( 0 )
+{
+}
+
+
+/*****************************************************************************/
+
+
+inline Money Money::fromTotalCents ( long long _totalCents )
+{
+	Money result;
+	result.m_totalCents = _totalCents;
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+inline long long Money::getDollars () const
+{
+	return m_totalCents / 100;
+}
+
+
+/*****************************************************************************/
+
+
+inline int Money::getCents () const
+{
+	int cents = static_cast< int >( m_totalCents % 100 );
+	return ( cents < 0 ) ? - cents : cents;
+}
+
+
+/*****************************************************************************/
+
+
+inline long long Money::getTotalCents () const
+{
+	return m_totalCents;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Money::operator == ( Money _m ) const
+{
+	return m_totalCents == _m.m_totalCents;
+}
+
+
+inline bool Money::operator != ( Money _m ) const
+{
+	return m_totalCents != _m.m_totalCents;
+}
+
+
+inline bool Money::operator < ( Money _m ) const
+{
+	return m_totalCents < _m.m_totalCents;
+}
+
+
+inline bool Money::operator <= ( Money _m ) const
+{
+	return m_totalCents <= _m.m_totalCents;
+}
+
+
+inline bool Money::operator > ( Money _m ) const
+{
+	return m_totalCents > _m.m_totalCents;
+}
+
+
+inline bool Money::operator >= ( Money _m ) const
+{
+	return m_totalCents >= _m.m_totalCents;
+}
+
+
+/*****************************************************************************/
+
+
+inline Money Money::operator + ( Money _m ) const
+{
+	Money result( * this );
+	result += _m;
+	return result;
+}
+
+
+inline Money Money::operator - ( Money _m ) const
+{
+	Money result( * this );
+	result -= _m;
+	return result;
+}
+
+
+inline Money Money::operator * ( int _factor ) const
+{
+	Money result( * this );
+	result *= _factor;
+	return result;
+}
+
+
+inline Money Money::operator / ( int _divisor ) const
+{
+	Money result( * this );
+	result /= _divisor;
+	return result;
+}
+
+
+/*****************************************************************************/
+
+Money operator "" _USD ( long double _amount );
+
 /*****************************************************************************/
 
 #endif //  _MONEY_HPP_
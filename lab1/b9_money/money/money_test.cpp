@@ -6,6 +6,8 @@
 
 #include "money.hpp"
 
+#include <climits>
+
 /*****************************************************************************/
 
 
@@ -391,4 +393,131 @@ DECLARE_OOP_TEST( money_test_using_literals )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( money_test_format_to_buffer )
+{
+	char buffer[ Money::MaxStringLength ];
+
+	assert( Money( 1234, 5 ).format( buffer, sizeof( buffer ) ) == 7 );
+	assert( ! strcmp( buffer, "1234.05" ) );
+
+	assert( Money( -2, 35 ).format( buffer, sizeof( buffer ) ) == 5 );
+	assert( ! strcmp( buffer, "-2.35" ) );
+
+	assert( Money( "-0.35" ).format( buffer, sizeof( buffer ) ) == 5 );
+	assert( ! strcmp( buffer, "-0.35" ) );
+
+	try
+	{
+		Money( 1234, 5 ).format( buffer, 7 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Buffer too small" ) );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( money_test_column_sum_min_max )
+{
+	std::vector< Money > column;
+	for ( int i = 0; i < 1000; ++i )
+		column.push_back( Money( i % 7 == 0 ? -i : i, i % 100 ) );
+
+	Money expected;
+	for ( Money m : column )
+		expected += m;
+
+	assert( Money::sum( column.data(), ( int ) column.size() ) == expected );
+	assert( Money::sum( column.data(), 0 ) == Money() );
+
+	assert( Money::min( column.data(), ( int ) column.size() ) == Money( -994, 94 ) );
+	assert( Money::max( column.data(), ( int ) column.size() ) == Money( 999, 99 ) );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( money_test_overflow )
+{
+	Money huge = Money::fromTotalCents( 9000000000000000000LL );
+
+	try
+	{
+		huge += huge;
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Money overflow" ) );
+	}
+
+	try
+	{
+		Money column[] = { huge, Money( 1, 0 ), huge };
+		Money::sum( column, 3 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Money overflow" ) );
+	}
+
+	try
+	{
+		huge *= 2;
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Money overflow" ) );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( money_test_constructor_concrete_range )
+{
+	const long long maxDollars = ( LLONG_MAX - 99 ) / 100;
+	const long long minDollars = ( LLONG_MIN + 99 ) / 100;
+
+	Money m1( maxDollars, 99 );
+	assert( m1.getDollars() == maxDollars );
+	assert( m1.getCents() == 99 );
+
+	Money m2( minDollars, 99 );
+	assert( m2.getDollars() == minDollars );
+	assert( m2.getCents() == 99 );
+
+	try
+	{
+		Money m( maxDollars + 1, 0 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Money overflow" ) );
+	}
+
+	try
+	{
+		Money m( minDollars - 1, 0 );
+		assert( ! "Exception must have been thrown" );
+	}
+	catch ( std::exception & e )
+	{
+		assert( ! strcmp( e.what(), "Money overflow" ) );
+	}
+}
+
+
 /*****************************************************************************/
@@ -17,6 +17,9 @@ namespace Messages
 	const char * const UnregistrationDateInFuture = "Unregistering in future";
 	const char * const PreviousRegistrationLaterThanCurrent = "Previous unregistration record at later date than current registration";
 	const char * const UnregisteringEarlierThanRegistered = "Unregistering earlier than registered";
+	const char * const BadRegistrationRecordIndex = "Bad registration record index";
+	const char * const BadPassportIndex = "Bad passport index";
+	const char * const BadDateRange = "Bad date range";
 }
 
 /*****************************************************************************/
@@ -3,10 +3,237 @@
 #include "passport.hpp"
 #include "messages.hpp"
 
+#include <stdexcept>
+#include <algorithm>
+
+/*****************************************************************************/
+
+
+const int Passport::OpenRunKey;
+
+
+/*****************************************************************************/
+
+
+Passport::RegistrationRecord::RegistrationRecord ( std::string const & _address, Date _date, bool _isRegistration )
+	:	m_address( _address ), m_date( _date ), m_isRegistration( _isRegistration )
+{
+}
+
+
+/*****************************************************************************/
+
+
+bool Passport::RegistrationRecord::operator == ( RegistrationRecord const & _r ) const
+{
+	return m_address == _r.m_address && m_date == _r.m_date && m_isRegistration == _r.m_isRegistration;
+}
+
+
+/*****************************************************************************/
+
+
+bool Passport::RegistrationRecord::operator != ( RegistrationRecord const & _r ) const
+{
+	return !( * this == _r );
+}
+
+
+/*****************************************************************************/
+
+
+bool Passport::isValidPassportId ( std::string const & _passportId )
+{
+	// Two capital letters followed by six digits
+	bool idValid = _passportId.length() == 8;
+	for ( int i = 0; idValid && i < 8; ++i )
+		idValid = ( i < 2 )
+			?	_passportId[ i ] >= 'A' && _passportId[ i ] <= 'Z'
+			:	_passportId[ i ] >= '0' && _passportId[ i ] <= '9';
+
+	return idValid;
+}
+
+
+/*****************************************************************************/
+
+
+Passport::Passport ( std::string const & _passportId, Date _issued, std::string const & _ownerFullName )
+	:	m_passportId( _passportId ), m_issued( _issued ), m_ownerFullName( _ownerFullName )
+{
+	if ( ! isValidPassportId( _passportId ) )
+		throw std::logic_error( Messages::BadPassportId );
+
+	if ( _issued > Date() )
+		throw std::logic_error( Messages::PassportIssuedInFuture );
+
+	if ( _ownerFullName.empty() )
+		throw std::logic_error( Messages::OwnerEmptyName );
+}
+
+
+/*****************************************************************************/
+
+
+void Passport::registerAt ( std::string const & _address, int _dateKey, int _todayKey )
+{
+	if ( isCurrentlyRegistered() )
+		throw std::logic_error( Messages::CurrentRegistrationStillActive );
+
+	if ( _dateKey < getDateKey( m_issued ) )
+		throw std::logic_error( Messages::RegistrationDateBeforePassportIssue );
+
+	if ( _dateKey > _todayKey )
+		throw std::logic_error( Messages::RegistrationDateInFuture );
+
+	if ( ! m_unregisteredKeys.empty() && _dateKey < m_unregisteredKeys.back() )
+		throw std::logic_error( Messages::PreviousRegistrationLaterThanCurrent );
+
+	m_registeredKeys.push_back( _dateKey );
+	m_unregisteredKeys.push_back( OpenRunKey );
+	m_addresses.push_back( _address );
+}
+
+
+/*****************************************************************************/
+
+
+void Passport::unregisterAt ( int _dateKey, int _todayKey )
+{
+	if ( ! isCurrentlyRegistered() )
+		throw std::logic_error( Messages::NoCurrentRegistration );
+
+	if ( _dateKey > _todayKey )
+		throw std::logic_error( Messages::UnregistrationDateInFuture );
+
+	if ( _dateKey < m_registeredKeys.back() )
+		throw std::logic_error( Messages::UnregisteringEarlierThanRegistered );
+
+	m_unregisteredKeys.back() = _dateKey;
+}
+
+
+/*****************************************************************************/
+
+
+void Passport::trackRegistration ( std::string const & _address, Date _date )
+{
+	registerAt( _address, getDateKey( _date ), getDateKey( Date() ) );
+}
+
+
+/*****************************************************************************/
+
+
+void Passport::trackUnregistration ( Date _date )
+{
+	unregisterAt( getDateKey( _date ), getDateKey( Date() ) );
+}
+
+
+/*****************************************************************************/
+
+
+void Passport::trackRegistrations ( RegistrationRecord const * _pRecords, int _count )
+{
+	const int todayKey = getDateKey( Date() );
+
+	// Runs are only appended, and at most the last one gets closed,
+	// so undoing a failed import is truncating and reopening
+	const int nRunsBefore = getRunsCount();
+	const bool wasRegistered = isCurrentlyRegistered();
+
+	int nRegistrations = 0;
+	for ( int i = 0; i < _count; ++i )
+		nRegistrations += _pRecords[ i ].m_isRegistration;
+
+	m_registeredKeys.reserve( nRunsBefore + nRegistrations );
+	m_unregisteredKeys.reserve( nRunsBefore + nRegistrations );
+	m_addresses.reserve( nRunsBefore + nRegistrations );
+
+	try
+	{
+		for ( int i = 0; i < _count; ++i )
+		{
+			RegistrationRecord const & record = _pRecords[ i ];
+			if ( record.m_isRegistration )
+				registerAt( record.m_address, getDateKey( record.m_date ), todayKey );
+			else
+				unregisterAt( getDateKey( record.m_date ), todayKey );
+		}
+	}
+	catch ( ... )
+	{
+		m_registeredKeys.resize( nRunsBefore );
+		m_unregisteredKeys.resize( nRunsBefore );
+		m_addresses.resize( nRunsBefore );
+
+		if ( wasRegistered )
+			m_unregisteredKeys.back() = OpenRunKey;
+
+		throw;
+	}
+}
+
+
+/*****************************************************************************/
+
+
+Passport::RegistrationRecord Passport::getRegistrationRecord ( int _index ) const
+{
+	if ( _index < 0 || _index >= getTotalRegistrationRecordsCount() )
+		throw std::logic_error( Messages::BadRegistrationRecordIndex );
+
+	const int run = _index / 2;
+	if ( _index % 2 )
+		return RegistrationRecord( m_addresses[ run ], getKeyDate( m_unregisteredKeys[ run ] ), false );
+	else
+		return RegistrationRecord( m_addresses[ run ], getKeyDate( m_registeredKeys[ run ] ), true );
+}
+
+
+/*****************************************************************************/
+
+
+Passport::RegistrationRecord Passport::getCurrentRegistration () const
+{
+	if ( ! isCurrentlyRegistered() )
+		throw std::logic_error( Messages::NoCurrentRegistration );
+
+	return RegistrationRecord( m_addresses.back(), getKeyDate( m_registeredKeys.back() ), true );
+}
+
+
+/*****************************************************************************/
+
+
+std::string const & Passport::getAddressAt ( Date _date ) const
+{
+	static const std::string s_noAddress;
+
+	// The last run registered on or before the date; on the same day,
+	// a later registration replaces an unregistration
+	const int dateKey = getDateKey( _date );
+	const int run = static_cast< int >(
+		std::upper_bound( m_registeredKeys.begin(), m_registeredKeys.end(), dateKey ) - m_registeredKeys.begin()
+	) - 1;
+
+	if ( run < 0 || dateKey >= m_unregisteredKeys[ run ] )
+		return s_noAddress;
+
+	return m_addresses[ run ];
+}
+
+
 /*****************************************************************************/
 
 
-// TODO ...
+bool Passport::isCohabitantWith ( Passport const & _other ) const
+{
+	return isCurrentlyRegistered()
+		&& _other.isCurrentlyRegistered()
+		&& m_addresses.back() == _other.m_addresses.back();
+}
 
 
 /*****************************************************************************/
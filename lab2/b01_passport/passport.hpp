@@ -8,9 +8,23 @@
 #include "date.hpp"
 
 #include <string>
+#include <vector>
+#include <climits>
 
 /*****************************************************************************/
 
+/*
+	Registration history is kept as runs: each run is one address with the dates
+	it was registered and unregistered. Runs only ever get appended, and their
+	registration dates never decrease, so the history is an array sorted by date.
+	Dates are stored as packed integer keys in parallel arrays, which keeps the
+	binary search of getAddressAt within a compact array of ints.
+
+	Only the last run may still be open; its unregistration key lies past any
+	date, so lookups need no special case for it. Registration records are not
+	stored, but derived from the runs: a run yields a registration and, when
+	closed, an unregistration.
+*/
 
 class Passport
 {
@@ -28,7 +42,7 @@ public:
 		const bool m_isRegistration;
 
 		RegistrationRecord ( std::string const & _address, Date _date, bool _isRegistration );
-		
+
 		bool operator == ( RegistrationRecord  const & _r ) const;
 
 		bool operator != ( RegistrationRecord const & _r ) const;
@@ -36,7 +50,40 @@ public:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: public members
+	Passport ( std::string const & _passportId, Date _issued, std::string const & _ownerFullName );
+
+	std::string const & getPassportId () const;
+
+	Date getIssued () const;
+
+	std::string const & getOwnerFullName () const;
+
+/*-----------------------------------------------------------------*/
+
+	void trackRegistration ( std::string const & _address, Date _date );
+
+	void trackUnregistration ( Date _date );
+
+	// Tracks _count records in order; on error none of them is kept
+	void trackRegistrations ( RegistrationRecord const * _pRecords, int _count );
+
+/*-----------------------------------------------------------------*/
+
+	int getTotalRegistrationRecordsCount () const;
+
+	RegistrationRecord getRegistrationRecord ( int _index ) const;
+
+	bool isCurrentlyRegistered () const;
+
+	RegistrationRecord getCurrentRegistration () const;
+
+	// Empty when not registered at that date
+	std::string const & getAddressAt ( Date _date ) const;
+
+	bool isCohabitantWith ( Passport const & _other ) const;
+
+	template< typename _Callback >
+	void forEachRegistration ( _Callback _callback ) const;
 
 /*-----------------------------------------------------------------*/
 
@@ -44,7 +91,36 @@ private:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: private members
+	// The registry indexes the runs directly
+	friend class PassportRegistry;
+
+	static bool isValidPassportId ( std::string const & _passportId );
+
+	static int getDateKey ( Date _date );
+
+	static Date getKeyDate ( int _key );
+
+	int getRunsCount () const;
+
+	void registerAt ( std::string const & _address, int _dateKey, int _todayKey );
+
+	void unregisterAt ( int _dateKey, int _todayKey );
+
+/*-----------------------------------------------------------------*/
+
+	const std::string m_passportId;
+
+	const Date m_issued;
+
+	const std::string m_ownerFullName;
+
+	std::vector< int > m_registeredKeys;
+
+	std::vector< int > m_unregisteredKeys;
+
+	std::vector< std::string > m_addresses;
+
+	static const int OpenRunKey = INT_MAX;
 
 /*-----------------------------------------------------------------*/
 
@@ -53,7 +129,97 @@ private:
 
 /*****************************************************************************/
 
-// TODO: inline methods implementation
+
+inline std::string const & Passport::getPassportId () const
+{
+	return m_passportId;
+}
+
+
+/*****************************************************************************/
+
+
+inline Date Passport::getIssued () const
+{
+	return m_issued;
+}
+
+
+/*****************************************************************************/
+
+
+inline std::string const & Passport::getOwnerFullName () const
+{
+	return m_ownerFullName;
+}
+
+
+/*****************************************************************************/
+
+
+inline int Passport::getRunsCount () const
+{
+	return static_cast< int >( m_registeredKeys.size() );
+}
+
+
+/*****************************************************************************/
+
+
+inline int Passport::getTotalRegistrationRecordsCount () const
+{
+	return 2 * getRunsCount() - ( isCurrentlyRegistered() ? 1 : 0 );
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Passport::isCurrentlyRegistered () const
+{
+	return ! m_unregisteredKeys.empty() && m_unregisteredKeys.back() == OpenRunKey;
+}
+
+
+/*****************************************************************************/
+
+
+inline int Passport::getDateKey ( Date _date )
+{
+	// Run bounds are compared on every lookup, so dates are kept as ints:
+	// the year above 4 bits of month and 5 bits of day, undone by getKeyDate
+	return ( _date.getYear() * 16 + _date.getMonth() ) * 32 + _date.getDay();
+}
+
+
+/*****************************************************************************/
+
+
+inline Date Passport::getKeyDate ( int _key )
+{
+	return Date( _key / 512, _key / 32 % 16, _key % 32 );
+}
+
+
+/*****************************************************************************/
+
+
+template< typename _Callback >
+void Passport::forEachRegistration ( _Callback _callback ) const
+{
+	const int nRuns = getRunsCount();
+	for ( int i = 0; i < nRuns; ++i )
+	{
+		const bool stillOpen = m_unregisteredKeys[ i ] == OpenRunKey;
+		_callback(
+				getKeyDate( m_registeredKeys[ i ] )
+			,	stillOpen ? Date() : getKeyDate( m_unregisteredKeys[ i ] )
+			,	m_addresses[ i ]
+			,	stillOpen
+		);
+	}
+}
+
 
 /*****************************************************************************/
 
@@ -0,0 +1,298 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "passport_registry.hpp"
+#include "messages.hpp"
+
+#include <stdexcept>
+#include <algorithm>
+
+/*****************************************************************************/
+
+
+const int PassportRegistry::BlockSize;
+
+
+/*****************************************************************************/
+
+
+PassportRegistry::PassportRegistry ()
+	:	m_runOffsets( 1, 0 ), m_indexValid( true ), m_addressOffsets( 1, 0 )
+{
+}
+
+
+/*****************************************************************************/
+
+
+int PassportRegistry::getPassportIdKey ( std::string const & _passportId )
+{
+	// Two letters and six digits, as checked by the passport
+	int key = ( _passportId[ 0 ] - 'A' ) * 26 + ( _passportId[ 1 ] - 'A' );
+	for ( int i = 2; i < 8; ++i )
+		key = key * 10 + ( _passportId[ i ] - '0' );
+
+	return key;
+}
+
+
+/*****************************************************************************/
+
+
+int PassportRegistry::internAddress ( std::string const & _address )
+{
+	const int nextId = static_cast< int >( m_addressIds.size() );
+	return m_addressIds.emplace( _address, nextId ).first->second;
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< PassportRegistry::Run > PassportRegistry::copyRuns ( Passport const & _passport )
+{
+	const int nRuns = _passport.getRunsCount();
+
+	std::vector< Run > runs;
+	runs.reserve( nRuns );
+	for ( int i = 0; i < nRuns; ++i )
+		runs.push_back( Run{
+				internAddress( _passport.m_addresses[ i ] )
+			,	_passport.m_registeredKeys[ i ]
+			,	_passport.m_unregisteredKeys[ i ]
+		} );
+
+	return runs;
+}
+
+
+/*****************************************************************************/
+
+
+int PassportRegistry::addPassport ( Passport const & _passport )
+{
+	const std::vector< Run > runs = copyRuns( _passport );
+
+	const int index = getPassportsCount();
+	m_passports.push_back( & _passport );
+
+	m_runs.insert( m_runs.end(), runs.begin(), runs.end() );
+	m_runOffsets.push_back( static_cast< int >( m_runs.size() ) );
+	m_indexValid = false;
+
+	return index;
+}
+
+
+/*****************************************************************************/
+
+
+void PassportRegistry::updatePassport ( int _index )
+{
+	checkPassportIndex( _index );
+
+	const std::vector< Run > runs = copyRuns( * m_passports[ _index ] );
+
+	const int begin = m_runOffsets[ _index ];
+	const int end = m_runOffsets[ _index + 1 ];
+	const int common = std::min( end - begin, static_cast< int >( runs.size() ) );
+
+	// Usually a run was closed or added at the end, so the runs are mostly overwritten in place
+	std::copy( runs.begin(), runs.begin() + common, m_runs.begin() + begin );
+	m_runs.erase( m_runs.begin() + begin + common, m_runs.begin() + end );
+	m_runs.insert( m_runs.begin() + begin + common, runs.begin() + common, runs.end() );
+
+	const int shift = static_cast< int >( runs.size() ) - ( end - begin );
+	for ( int i = _index + 1; i < static_cast< int >( m_runOffsets.size() ); ++i )
+		m_runOffsets[ i ] += shift;
+
+	m_indexValid = false;
+}
+
+
+/*****************************************************************************/
+
+
+void PassportRegistry::checkPassportIndex ( int _index ) const
+{
+	if ( _index < 0 || _index >= getPassportsCount() )
+		throw std::logic_error( Messages::BadPassportIndex );
+}
+
+
+/*****************************************************************************/
+
+
+Passport const & PassportRegistry::getPassport ( int _index ) const
+{
+	checkPassportIndex( _index );
+
+	return * m_passports[ _index ];
+}
+
+
+/*****************************************************************************/
+
+
+int PassportRegistry::getRunPassport ( int _run ) const
+{
+	return static_cast< int >(
+		std::upper_bound( m_runOffsets.begin(), m_runOffsets.end(), _run ) - m_runOffsets.begin()
+	) - 1;
+}
+
+
+/*****************************************************************************/
+
+
+void PassportRegistry::updateIndex () const
+{
+	if ( m_indexValid )
+		return;
+
+	const int nRuns = static_cast< int >( m_runs.size() );
+	const int nAddresses = getAddressesCount();
+
+	// Counting sort groups the runs by address, then each group is sorted by date
+	m_addressOffsets.assign( nAddresses + 1, 0 );
+	for ( Run const & run : m_runs )
+		++ m_addressOffsets[ run.m_address + 1 ];
+
+	for ( int i = 0; i < nAddresses; ++i )
+		m_addressOffsets[ i + 1 ] += m_addressOffsets[ i ];
+
+	std::vector< int > nextPositions( m_addressOffsets.begin(), m_addressOffsets.end() - 1 );
+	m_addressRuns.resize( nRuns );
+	for ( int i = 0; i < nRuns; ++i )
+		m_addressRuns[ nextPositions[ m_runs[ i ].m_address ]++ ] = i;
+
+	for ( int i = 0; i < nAddresses; ++i )
+		std::sort(
+				m_addressRuns.begin() + m_addressOffsets[ i ]
+			,	m_addressRuns.begin() + m_addressOffsets[ i + 1 ]
+			,	[ this ] ( int _run1, int _run2 )
+				{
+					return m_runs[ _run1 ].m_registeredKey < m_runs[ _run2 ].m_registeredKey;
+				}
+		);
+
+	m_blockLatestUnregistered.assign( ( nRuns + BlockSize - 1 ) / BlockSize, INT_MIN );
+	for ( int i = 0; i < nRuns; ++i )
+	{
+		int & latest = m_blockLatestUnregistered[ i / BlockSize ];
+		latest = std::max( latest, m_runs[ m_addressRuns[ i ] ].m_unregisteredKey );
+	}
+
+	const int nPassports = getPassportsCount();
+	m_passportIds.resize( nPassports );
+	for ( int i = 0; i < nPassports; ++i )
+		m_passportIds[ i ] = std::make_pair( getPassportIdKey( m_passports[ i ]->getPassportId() ), i );
+
+	std::sort( m_passportIds.begin(), m_passportIds.end() );
+
+	m_indexValid = true;
+}
+
+
+/*****************************************************************************/
+
+
+int PassportRegistry::findPassport ( std::string const & _passportId ) const
+{
+	if ( ! Passport::isValidPassportId( _passportId ) )
+		return -1;
+
+	updateIndex();
+
+	const int key = getPassportIdKey( _passportId );
+	auto it = std::lower_bound( m_passportIds.begin(), m_passportIds.end(), std::make_pair( key, 0 ) );
+	if ( it == m_passportIds.end() || it->first != key )
+		return -1;
+
+	return it->second;
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< int > PassportRegistry::findCohabitants ( int _index, Date _from, Date _to ) const
+{
+	checkPassportIndex( _index );
+
+	if ( _from > _to )
+		throw std::logic_error( Messages::BadDateRange );
+
+	updateIndex();
+
+	const int fromKey = Passport::getDateKey( _from );
+	const int pastToKey = Passport::getDateKey( _to ) + 1;
+
+	// The parts of the passport's runs within the period, from the start day up to,
+	// not including, the end day, sorted by address and start
+	std::vector< Run > periods;
+	for ( int i = m_runOffsets[ _index ]; i < m_runOffsets[ _index + 1 ]; ++i )
+	{
+		Run const & run = m_runs[ i ];
+		const int start = std::max( run.m_registeredKey, fromKey );
+		const int end = std::min( run.m_unregisteredKey, pastToKey );
+		if ( start < end )
+			periods.push_back( Run{ run.m_address, start, end } );
+	}
+
+	std::sort(
+			periods.begin()
+		,	periods.end()
+		,	[] ( Run const & _period1, Run const & _period2 )
+			{
+				return _period1.m_address < _period2.m_address
+					|| ( _period1.m_address == _period2.m_address && _period1.m_registeredKey < _period2.m_registeredKey );
+			}
+	);
+
+	std::vector< int > result;
+
+	const int nPeriods = static_cast< int >( periods.size() );
+	for ( int addressBegin = 0, addressEnd; addressBegin < nPeriods; addressBegin = addressEnd )
+	{
+		const int address = periods[ addressBegin ].m_address;
+
+		addressEnd = addressBegin + 1;
+		while ( addressEnd < nPeriods && periods[ addressEnd ].m_address == address )
+			++ addressEnd;
+
+		int period = addressBegin;
+		const int groupEnd = m_addressOffsets[ address + 1 ];
+		int position = m_addressOffsets[ address ];
+		while ( position < groupEnd )
+		{
+			// Later periods start later, so a block ended before this one is of no use to them either
+			if ( position % BlockSize == 0 && m_blockLatestUnregistered[ position / BlockSize ] <= periods[ period ].m_registeredKey )
+			{
+				position += BlockSize;
+				continue;
+			}
+
+			const int otherRun = m_addressRuns[ position++ ];
+			Run const & other = m_runs[ otherRun ];
+
+			// Runs come by registration date, so periods over by now are over for the rest
+			while ( period < addressEnd && periods[ period ].m_unregisteredKey <= other.m_registeredKey )
+				++ period;
+
+			if ( period == addressEnd )
+				break;
+
+			if ( other.m_unregisteredKey > periods[ period ].m_registeredKey && other.m_unregisteredKey > other.m_registeredKey )
+				result.push_back( getRunPassport( otherRun ) );
+		}
+	}
+
+	std::sort( result.begin(), result.end() );
+	result.erase( std::unique( result.begin(), result.end() ), result.end() );
+	result.erase( std::remove( result.begin(), result.end(), _index ), result.end() );
+
+	return result;
+}
+
+
+/*****************************************************************************/
@@ -0,0 +1,150 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _PASSPORT_REGISTRY_HPP_
+#define _PASSPORT_REGISTRY_HPP_
+
+/*****************************************************************************/
+
+#include "passport.hpp"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/*****************************************************************************/
+
+/*
+	Indexes the registration histories of a population of passports by address.
+
+	Every distinct address string is stored once and referred to by a number.
+	A passport's history is copied when it is added, as runs of (address,
+	registered, unregistered) packed into three ints; passports themselves are
+	only referenced and must outlive the registry. A history changed later,
+	including a still open run being closed, is seen after updatePassport.
+
+	Runs are also indexed by address: run numbers grouped by address and sorted
+	by registration date, with the latest unregistration of every block of runs
+	kept aside. Looking for cohabitants sorts the passport's own periods at
+	each address by start and sweeps that address's runs once against all of
+	them: periods already over are dropped as the registration dates grow,
+	whole blocks of runs that ended before the current period are skipped, and
+	the sweep stops when the last period is passed.
+
+	The index is rebuilt on the first query after passports were added or updated.
+*/
+
+class PassportRegistry
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*-----------------------------------------------------------------*/
+
+	PassportRegistry ();
+
+	PassportRegistry ( PassportRegistry const & ) = delete;
+
+	PassportRegistry & operator = ( PassportRegistry const & ) = delete;
+
+/*-----------------------------------------------------------------*/
+
+	// Returns the index of the passport within the registry
+	int addPassport ( Passport const & _passport );
+
+	// Copies the history of the passport again after it has changed
+	void updatePassport ( int _index );
+
+	int getPassportsCount () const;
+
+	Passport const & getPassport ( int _index ) const;
+
+	// -1 when there is no such passport
+	int findPassport ( std::string const & _passportId ) const;
+
+	int getAddressesCount () const;
+
+/*-----------------------------------------------------------------*/
+
+	// Other passports registered at the same address as the given one
+	// on at least one day between the two dates, inclusive; sorted by index
+	std::vector< int > findCohabitants ( int _index, Date _from, Date _to ) const;
+
+/*-----------------------------------------------------------------*/
+
+private:
+
+/*-----------------------------------------------------------------*/
+
+	struct Run
+	{
+		int m_address;
+		int m_registeredKey;
+		int m_unregisteredKey;
+	};
+
+	static int getPassportIdKey ( std::string const & _passportId );
+
+	int internAddress ( std::string const & _address );
+
+	std::vector< Run > copyRuns ( Passport const & _passport );
+
+	int getRunPassport ( int _run ) const;
+
+	void checkPassportIndex ( int _index ) const;
+
+	void updateIndex () const;
+
+/*-----------------------------------------------------------------*/
+
+	static const int BlockSize = 32;
+
+	std::unordered_map< std::string, int > m_addressIds;
+
+	std::vector< Passport const * > m_passports;
+
+	// Runs of passport i are m_runs[ m_runOffsets[ i ] ] up to m_runOffsets[ i + 1 ]
+	std::vector< Run > m_runs;
+
+	std::vector< int > m_runOffsets;
+
+	// Built on demand
+
+	mutable bool m_indexValid;
+
+	mutable std::vector< int > m_addressRuns;
+
+	mutable std::vector< int > m_addressOffsets;
+
+	mutable std::vector< int > m_blockLatestUnregistered;
+
+	// Packed passport IDs with passport indices, sorted
+	mutable std::vector< std::pair< int, int > > m_passportIds;
+
+/*-----------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline int PassportRegistry::getPassportsCount () const
+{
+	return static_cast< int >( m_passports.size() );
+}
+
+
+/*****************************************************************************/
+
+
+inline int PassportRegistry::getAddressesCount () const
+{
+	return static_cast< int >( m_addressIds.size() );
+}
+
+
+/*****************************************************************************/
+
+#endif // _PASSPORT_REGISTRY_HPP_
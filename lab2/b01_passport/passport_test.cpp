@@ -5,6 +5,7 @@
 #include "testslib.hpp"
 
 #include "passport.hpp"
+#include "passport_registry.hpp"
 #include "messages.hpp"
 
 /*****************************************************************************/
@@ -595,3 +596,267 @@ DECLARE_OOP_TEST ( test_PassportIsCohabitant_SameAddressInPast_Fails )
 /*****************************************************************************/
 
 
+
+
+DECLARE_OOP_TEST ( test_PassportBadRegistrationRecordIndex )
+{
+	Passport p( "AB123456", Date( 2010, 1, 1 ), "Ivan Ivanov" );
+	p.trackRegistration( "Sumskaya 1", Date( 2011, 1, 1 ) );
+
+	ASSERT_THROWS( p.getRegistrationRecord( 1 ), Messages::BadRegistrationRecordIndex )
+	ASSERT_THROWS( p.getRegistrationRecord( -1 ), Messages::BadRegistrationRecordIndex )
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_PassportBulkRegistrations )
+{
+	std::vector< Passport::RegistrationRecord > records;
+	for ( int year = 1990; year < 2010; ++year )
+	{
+		std::string address = "Sumskaya " + std::to_string( year );
+		records.push_back( Passport::RegistrationRecord( address, Date( year, 3, 1 ), true ) );
+		records.push_back( Passport::RegistrationRecord( address, Date( year, 9, 1 ), false ) );
+	}
+	records.push_back( Passport::RegistrationRecord( "Pushkinskaya 1", Date( 2010, 1, 1 ), true ) );
+
+	Passport p( "AB123456", Date( 1990, 1, 1 ), "Ivan Ivanov" );
+	p.trackRegistrations( records.data(), static_cast< int >( records.size() ) );
+
+	assert( p.getTotalRegistrationRecordsCount() == 41 );
+	for ( int i = 0; i < 41; ++i )
+		assert( p.getRegistrationRecord( i ) == records[ i ] );
+
+	assert( p.getCurrentRegistration() == records.back() );
+
+	assert( p.getAddressAt( Date( 1995, 3, 1 ) ) == "Sumskaya 1995" );
+	assert( p.getAddressAt( Date( 1995, 8, 31 ) ) == "Sumskaya 1995" );
+	assert( p.getAddressAt( Date( 1995, 9, 1 ) ) == "" );
+	assert( p.getAddressAt( Date( 1996, 2, 29 ) ) == "" );
+	assert( p.getAddressAt( Date( 1989, 12, 31 ) ) == "" );
+	assert( p.getAddressAt( Date( 2009, 5, 5 ) ) == "Sumskaya 2009" );
+	assert( p.getAddressAt( Date() ) == "Pushkinskaya 1" );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_PassportBulkRegistrations_FailureKeepsHistory )
+{
+	Passport p( "AB123456", Date( 2010, 1, 1 ), "Ivan Ivanov" );
+	p.trackRegistration( "Sumskaya 1", Date( 2011, 1, 1 ) );
+
+	Passport::RegistrationRecord records[] = {
+			Passport::RegistrationRecord( "Sumskaya 1", Date( 2012, 1, 1 ), false )
+		,	Passport::RegistrationRecord( "Pushkinskaya 1", Date( 2012, 2, 1 ), true )
+		,	Passport::RegistrationRecord( "Pushkinskaya 1", Date( 2012, 1, 31 ), false )
+	};
+
+	ASSERT_THROWS(
+			p.trackRegistrations( records, 3 )
+		,	Messages::UnregisteringEarlierThanRegistered
+	)
+
+	assert( p.getTotalRegistrationRecordsCount() == 1 );
+	assert( p.getCurrentRegistration() == Passport::RegistrationRecord( "Sumskaya 1", Date( 2011, 1, 1 ), true ) );
+	assert( p.getAddressAt( Date( 2012, 6, 1 ) ) == "Sumskaya 1" );
+
+	p.trackRegistrations( records, 2 );
+	assert( p.getTotalRegistrationRecordsCount() == 3 );
+	assert( p.getAddressAt( Date( 2012, 1, 15 ) ) == "" );
+	assert( p.getAddressAt( Date( 2012, 6, 1 ) ) == "Pushkinskaya 1" );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_PassportRegistryFindsPassports )
+{
+	Passport p1( "AB123456", Date( 2010, 1, 1 ), "Ivan Ivanov" );
+	Passport p2( "CD123456", Date( 2011, 1, 1 ), "Elena Ivanova" );
+	p1.trackRegistration( "Sumskaya 1", Date( 2012, 12, 1 ) );
+	p2.trackRegistration( "Sumskaya 1", Date( 2013, 1, 1 ) );
+
+	PassportRegistry registry;
+	assert( registry.addPassport( p1 ) == 0 );
+	assert( registry.addPassport( p2 ) == 1 );
+
+	assert( registry.getPassportsCount() == 2 );
+	assert( registry.getAddressesCount() == 1 );
+	assert( & registry.getPassport( 1 ) == & p2 );
+
+	assert( registry.findPassport( "CD123456" ) == 1 );
+	assert( registry.findPassport( "AB123456" ) == 0 );
+	assert( registry.findPassport( "AB123457" ) == -1 );
+	assert( registry.findPassport( "Fignia" ) == -1 );
+
+	ASSERT_THROWS( registry.getPassport( 2 ), Messages::BadPassportIndex )
+	ASSERT_THROWS(
+			registry.findCohabitants( 0, Date( 2015, 1, 1 ), Date( 2014, 1, 1 ) )
+		,	Messages::BadDateRange
+	)
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_PassportRegistryCohabitantsOverPeriod )
+{
+	Passport p1( "AB123456", Date( 2010, 1, 1 ), "Ivan Ivanov" );
+	p1.trackRegistration( "Sumskaya 1", Date( 2011, 1, 1 ) );
+	p1.trackUnregistration( Date( 2013, 1, 1 ) );
+	p1.trackRegistration( "Pushkinskaya 1", Date( 2013, 1, 1 ) );
+
+	// Moved in as the first one moved out
+	Passport p2( "CD123456", Date( 2010, 1, 1 ), "Elena Ivanova" );
+	p2.trackRegistration( "Sumskaya 1", Date( 2013, 1, 1 ) );
+
+	Passport p3( "EF123456", Date( 2010, 1, 1 ), "Piotr Petrov" );
+	p3.trackRegistration( "Sumskaya 1", Date( 2012, 12, 31 ) );
+	p3.trackUnregistration( Date( 2014, 1, 1 ) );
+	p3.trackRegistration( "Pushkinskaya 1", Date( 2015, 6, 1 ) );
+
+	PassportRegistry registry;
+	registry.addPassport( p1 );
+	registry.addPassport( p2 );
+	registry.addPassport( p3 );
+
+	assert( registry.findCohabitants( 0, Date( 2010, 1, 1 ), Date() ) == std::vector< int >( { 2 } ) );
+	assert( registry.findCohabitants( 0, Date( 2010, 1, 1 ), Date( 2012, 12, 30 ) ).empty() );
+	assert( registry.findCohabitants( 1, Date( 2010, 1, 1 ), Date() ) == std::vector< int >( { 2 } ) );
+	assert( registry.findCohabitants( 2, Date( 2010, 1, 1 ), Date() ) == std::vector< int >( { 0, 1 } ) );
+	assert( registry.findCohabitants( 2, Date( 2013, 1, 1 ), Date( 2015, 5, 31 ) ) == std::vector< int >( { 1 } ) );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_PassportRegistryFollowsUpdatedPassports )
+{
+	Passport p1( "AB123456", Date( 2010, 1, 1 ), "Ivan Ivanov" );
+	p1.trackRegistration( "Sumskaya 1", Date( 2011, 1, 1 ) );
+
+	Passport p2( "CD123456", Date( 2010, 1, 1 ), "Elena Ivanova" );
+	p2.trackRegistration( "Pushkinskaya 1", Date( 2011, 1, 1 ) );
+
+	PassportRegistry registry;
+	registry.addPassport( p1 );
+	registry.addPassport( p2 );
+	assert( registry.findCohabitants( 0, Date( 2010, 1, 1 ), Date() ).empty() );
+
+	// The registry holds a copy of the history until it is told about changes
+	p2.trackUnregistration( Date( 2013, 1, 1 ) );
+	p2.trackRegistration( "Sumskaya 1", Date( 2013, 1, 1 ) );
+	assert( registry.findCohabitants( 0, Date( 2010, 1, 1 ), Date() ).empty() );
+
+	registry.updatePassport( 1 );
+	assert( registry.findCohabitants( 0, Date( 2010, 1, 1 ), Date() ) == std::vector< int >( { 1 } ) );
+	assert( registry.findCohabitants( 1, Date( 2010, 1, 1 ), Date( 2012, 12, 31 ) ).empty() );
+
+	// Closing the open run ends the overlap
+	p1.trackUnregistration( Date( 2012, 6, 1 ) );
+	p1.trackRegistration( "Nauki 14", Date( 2012, 6, 1 ) );
+	registry.updatePassport( 0 );
+	assert( registry.findCohabitants( 0, Date( 2010, 1, 1 ), Date() ).empty() );
+	assert( registry.findCohabitants( 1, Date( 2010, 1, 1 ), Date() ).empty() );
+	assert( registry.getAddressesCount() == 3 );
+	assert( registry.findPassport( "CD123456" ) == 1 );
+
+	ASSERT_THROWS( registry.updatePassport( 2 ), Messages::BadPassportIndex )
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_PassportRegistryCohabitantsMatchPairwiseCheck )
+{
+	// Many residents at few addresses, so that runs span several index blocks
+	const int nPassports = 300;
+	const char * const addresses[] = { "Sumskaya 1", "Sumskaya 2", "Pushkinskaya 1", "Nauki 14" };
+
+	std::vector< Passport > passports;
+	passports.reserve( nPassports );
+
+	unsigned state = 2016;
+	for ( int i = 0; i < nPassports; ++i )
+	{
+		std::string id = "AB" + std::to_string( 100000 + i );
+		passports.push_back( Passport( id, Date( 1990, 1, 1 ), "Ivan Ivanov" ) );
+
+		int year = 1990;
+		while ( year < 2015 )
+		{
+			state = state * 1103515245u + 12345u;
+			int from = year + 1 + ( state >> 16 ) % 4;
+			int to = from + 1 + ( state >> 20 ) % 6;
+			if ( to > 2015 )
+				break;
+
+			passports.back().trackRegistration( addresses[ ( state >> 24 ) % 4 ], Date( from, 1 + ( state >> 8 ) % 12, 1 ) );
+			if ( ( state >> 12 ) % 8 )
+				passports.back().trackUnregistration( Date( to, 6, 1 ) );
+			else
+				break;
+
+			year = to;
+		}
+	}
+
+	PassportRegistry registry;
+	for ( Passport const & p : passports )
+		registry.addPassport( p );
+
+	// Histories changed after they were added are updated in the middle of the runs
+	for ( int i = 0; i < nPassports; i += 3 )
+	{
+		Passport & p = passports[ i ];
+		if ( p.isCurrentlyRegistered() )
+			p.trackUnregistration( Date( 2015, 12, 1 ) );
+
+		p.trackRegistration( addresses[ i % 4 ], Date( 2016, 1, 1 ) );
+		registry.updatePassport( i );
+	}
+
+	const Date from( 1998, 1, 1 ), to( 2016, 12, 31 );
+	for ( int i = 0; i < nPassports; i += 7 )
+	{
+		std::vector< int > expected;
+		for ( int j = 0; j < nPassports; ++j )
+		{
+			if ( j == i )
+				continue;
+
+			bool overlap = false;
+			passports[ i ].forEachRegistration(
+				[ & ] ( Date _registration1, Date _unregistration1, std::string const & _address1, bool _stillOpen1 )
+				{
+					passports[ j ].forEachRegistration(
+						[ & ] ( Date _registration2, Date _unregistration2, std::string const & _address2, bool _stillOpen2 )
+						{
+							Date start = std::max( std::max( _registration1, _registration2 ), from );
+							overlap |= _address1 == _address2
+								&& start <= to
+								&& ( _stillOpen1 || start < _unregistration1 )
+								&& ( _stillOpen2 || start < _unregistration2 );
+						}
+					);
+				}
+			);
+
+			if ( overlap )
+				expected.push_back( j );
+		}
+
+		assert( registry.findCohabitants( i, from, to ) == expected );
+	}
+}
+
+
+/*****************************************************************************/
@@ -3,10 +3,362 @@
 #include "install_registry.hpp"
 #include "messages.hpp"
 
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+
+/*****************************************************************************/
+
+
+const int InstallRegistry::DefaultChangeFeedCapacity;
+
+
+/*****************************************************************************/
+
+
+InstallRegistry::InstallRegistry ( std::string const & _machineName, std::shared_ptr< ProgramCatalog > _catalog )
+	:	m_machineName( _machineName ), m_catalog( std::move( _catalog ) ), m_fingerprint( 0 )
+	,	m_nextChangeSequence( 0 ), m_changeFeedCapacity( DefaultChangeFeedCapacity )
+{
+	if ( _machineName.empty() )
+		throw std::logic_error( Messages::MachineNameEmpty );
+}
+
+
+/*****************************************************************************/
+
+
+void InstallRegistry::updateMachineName ( std::string const & _machineName )
+{
+	if ( _machineName.empty() )
+		throw std::logic_error( Messages::MachineNameEmpty );
+
+	m_machineName = _machineName;
+}
+
+
+/*****************************************************************************/
+
+
+std::set< std::string > InstallRegistry::fetchAllInstalledProgramNames () const
+{
+	std::set< std::string > result;
+	for ( ProgramId id : m_programIds )
+		result.insert( m_catalog->getProgramName( id ) );
+
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+int InstallRegistry::findProgram ( std::string const & _programName ) const
+{
+	ProgramId id;
+	if ( ! m_catalog->findProgram( _programName, id ) )
+		return -1;
+
+	auto it = std::lower_bound( m_programIds.begin(), m_programIds.end(), id );
+	if ( it == m_programIds.end() || * it != id )
+		return -1;
+
+	return static_cast< int >( it - m_programIds.begin() );
+}
+
+
+/*****************************************************************************/
+
+
+int InstallRegistry::getInstalledProgramIndex ( std::string const & _programName ) const
+{
+	if ( _programName.empty() )
+		throw std::logic_error( Messages::ProgramNameEmpty );
+
+	const int index = findProgram( _programName );
+	if ( index == -1 )
+		throw std::logic_error( Messages::ProgramNotInstalled );
+
+	return index;
+}
+
+
+/*****************************************************************************/
+
+
+Date InstallRegistry::getProgramInstallationDate ( std::string const & _programName ) const
+{
+	return m_installationDates[ getInstalledProgramIndex( _programName ) ];
+}
+
+
+/*****************************************************************************/
+
+
+void InstallRegistry::getDateRange ( Date _from, Date _to, int & _begin, int & _end ) const
+{
+	if ( _from > _to )
+		throw std::logic_error( Messages::BadDateRange );
+
+	const auto fromEntry = std::make_pair( getDateKey( _from ), ProgramId( 0 ) );
+	const auto pastToEntry = std::make_pair( getDateKey( _to ) + 1, ProgramId( 0 ) );
+
+	_begin = static_cast< int >(
+		std::lower_bound( m_dateIndex.begin(), m_dateIndex.end(), fromEntry ) - m_dateIndex.begin()
+	);
+	_end = static_cast< int >(
+		std::lower_bound( m_dateIndex.begin() + _begin, m_dateIndex.end(), pastToEntry ) - m_dateIndex.begin()
+	);
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< InstallRegistry::ProgramId > InstallRegistry::getProgramIdsInstalledBetween ( Date _from, Date _to ) const
+{
+	int begin, end;
+	getDateRange( _from, _to, begin, end );
+
+	std::vector< ProgramId > result;
+	result.reserve( end - begin );
+	for ( int i = begin; i < end; ++i )
+		result.push_back( m_dateIndex[ i ].second );
+
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+std::set< std::string > InstallRegistry::fetchProgramsInstalledBetween ( Date _from, Date _to ) const
+{
+	int begin, end;
+	getDateRange( _from, _to, begin, end );
+
+	std::set< std::string > result;
+	for ( int i = begin; i < end; ++i )
+		result.insert( m_catalog->getProgramName( m_dateIndex[ i ].second ) );
+
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+void InstallRegistry::addDateEntry ( Date _date, ProgramId _id )
+{
+	const auto entry = std::make_pair( getDateKey( _date ), _id );
+	m_dateIndex.insert( std::lower_bound( m_dateIndex.begin(), m_dateIndex.end(), entry ), entry );
+}
+
+
+/*****************************************************************************/
+
+
+void InstallRegistry::removeDateEntry ( Date _date, ProgramId _id )
+{
+	const auto entry = std::make_pair( getDateKey( _date ), _id );
+	m_dateIndex.erase( std::lower_bound( m_dateIndex.begin(), m_dateIndex.end(), entry ) );
+}
+
+
+/*****************************************************************************/
+
+
+void InstallRegistry::recordChange ( ChangeKind _kind, ProgramId _id, Date _date )
+{
+	if ( static_cast< int >( m_changes.size() ) == m_changeFeedCapacity )
+		m_changes.pop_front();
+
+	m_changes.push_back( Change{ m_nextChangeSequence++, _kind, _id, _date } );
+}
+
+
+/*****************************************************************************/
+
+
+void InstallRegistry::installProgram ( std::string const & _programName, Date _date )
+{
+	if ( _programName.empty() )
+		throw std::logic_error( Messages::ProgramNameEmpty );
+
+	if ( _date > Date() )
+		throw std::logic_error( Messages::InstallationDateInFuture );
+
+	const ProgramId id = m_catalog->internProgram( _programName );
+	auto it = std::lower_bound( m_programIds.begin(), m_programIds.end(), id );
+	if ( it != m_programIds.end() && * it == id )
+		throw std::logic_error( Messages::ProgramAlreadyInstalled );
+
+	const auto position = it - m_programIds.begin();
+	m_programIds.insert( it, id );
+	m_installationDates.insert( m_installationDates.begin() + position, _date );
+	addDateEntry( _date, id );
+
+	m_fingerprint ^= ProgramCatalog::getFingerprint( id );
+	recordChange( Installed, id, _date );
+}
+
+
+/*****************************************************************************/
+
+
+void InstallRegistry::updateProgram ( std::string const & _programName, Date _date )
+{
+	const int index = getInstalledProgramIndex( _programName );
+
+	if ( _date > Date() )
+		throw std::logic_error( Messages::UpdateDateInFuture );
+
+	if ( _date < m_installationDates[ index ] )
+		throw std::logic_error( Messages::UpdateDateEarlierThanPreviousVersion );
+
+	const ProgramId id = m_programIds[ index ];
+	removeDateEntry( m_installationDates[ index ], id );
+	addDateEntry( _date, id );
+
+	m_installationDates[ index ] = _date;
+	recordChange( Updated, id, _date );
+}
+
+
 /*****************************************************************************/
 
 
-// TODO ...
+void InstallRegistry::uninstallProgram ( std::string const & _programName )
+{
+	const int index = getInstalledProgramIndex( _programName );
+
+	const ProgramId id = m_programIds[ index ];
+	const Date date = m_installationDates[ index ];
+
+	m_fingerprint ^= ProgramCatalog::getFingerprint( id );
+	removeDateEntry( date, id );
+
+	m_programIds.erase( m_programIds.begin() + index );
+	m_installationDates.erase( m_installationDates.begin() + index );
+
+	recordChange( Uninstalled, id, date );
+}
+
+
+/*****************************************************************************/
+
+
+void InstallRegistry::uninstallAll ()
+{
+	const int nPrograms = getNumInstalledPrograms();
+	for ( int i = 0; i < nPrograms; ++i )
+		recordChange( Uninstalled, m_programIds[ i ], m_installationDates[ i ] );
+
+	m_programIds.clear();
+	m_installationDates.clear();
+	m_dateIndex.clear();
+	m_fingerprint = 0;
+}
+
+
+/*****************************************************************************/
+
+
+void InstallRegistry::checkSameCatalog ( InstallRegistry const & _other ) const
+{
+	if ( m_catalog != _other.m_catalog )
+		throw std::logic_error( Messages::DifferentProgramCatalogs );
+}
+
+
+/*****************************************************************************/
+
+
+bool InstallRegistry::hasIdenticalPrograms ( InstallRegistry const & _other ) const
+{
+	checkSameCatalog( _other );
+
+	if ( m_fingerprint != _other.m_fingerprint || m_programIds.size() != _other.m_programIds.size() )
+		return false;
+
+	// Fingerprints may collide, so a match is confirmed on the arrays
+	return m_programIds == _other.m_programIds;
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< InstallRegistry::ProgramId >
+InstallRegistry::getUniqueProgramIdsComparedTo ( InstallRegistry const & _other ) const
+{
+	checkSameCatalog( _other );
+
+	std::vector< ProgramId > result;
+	std::set_difference(
+			m_programIds.begin(), m_programIds.end()
+		,	_other.m_programIds.begin(), _other.m_programIds.end()
+		,	std::back_inserter( result )
+	);
+
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+std::set< std::string > InstallRegistry::getUniqueProgramsComparedTo ( InstallRegistry const & _other ) const
+{
+	std::set< std::string > result;
+	for ( ProgramId id : getUniqueProgramIdsComparedTo( _other ) )
+		result.insert( m_catalog->getProgramName( id ) );
+
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< InstallRegistry::Change > InstallRegistry::fetchChanges ( long long & _cursor ) const
+{
+	// The first kept change is numbered by how many came before the feed start
+	const long long firstSequence = m_nextChangeSequence - static_cast< long long >( m_changes.size() );
+	if ( _cursor < firstSequence )
+		throw std::logic_error( Messages::ChangesDiscarded );
+
+	std::vector< Change > result;
+	if ( _cursor < m_nextChangeSequence )
+		result.assign( m_changes.begin() + ( _cursor - firstSequence ), m_changes.end() );
+
+	_cursor = std::max( _cursor, m_nextChangeSequence );
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+void InstallRegistry::discardChangesBefore ( long long _sequence )
+{
+	while ( ! m_changes.empty() && m_changes.front().m_sequence < _sequence )
+		m_changes.pop_front();
+}
+
+
+/*****************************************************************************/
+
+
+void InstallRegistry::setChangeFeedCapacity ( int _capacity )
+{
+	if ( _capacity <= 0 )
+		throw std::logic_error( Messages::BadChangeFeedCapacity );
+
+	m_changeFeedCapacity = _capacity;
+	while ( static_cast< int >( m_changes.size() ) > _capacity )
+		m_changes.pop_front();
+}
 
 
 /*****************************************************************************/
@@ -6,10 +6,40 @@
 /*****************************************************************************/
 
 #include "date.hpp"
+#include "program_catalog.hpp"
+
+#include <string>
+#include <vector>
+#include <set>
+#include <deque>
+#include <memory>
+#include <cstdint>
 
 /*****************************************************************************/
 
+/*
+	Programs of a machine are kept as numbers from a program catalog, in a
+	sorted array, with installation dates in a parallel array. Lookups by name
+	are one hash lookup in the catalog and a binary search; set operations
+	between two machines are merges of the sorted arrays.
+
+	The XOR of fingerprints of installed programs is updated on every change.
+	Machines with different programs are told apart by the count and that
+	fingerprint alone, without looking at the arrays; only matching machines
+	get their arrays compared.
+
+	Registries can only be compared when they share a catalog.
+
+	A second sorted array holds (date, program) pairs, so programs last
+	installed or updated within a period are found by two binary searches.
 
+	Every change is also appended to a change feed, numbered from the creation
+	of the registry. Consumers keep the number of the next change they expect
+	and pull whatever came after it; changes everyone has seen can be dropped.
+	The feed keeps at most a set number of the latest changes, so a consumer
+	that stopped pulling cannot make it grow without bound: older changes are
+	dropped, and a consumer left behind gets an error and has to resynchronize.
+*/
 
 class InstallRegistry
 {
@@ -20,7 +50,91 @@ public:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: public members
+	typedef ProgramCatalog::ProgramId ProgramId;
+
+	static const int DefaultChangeFeedCapacity = 4096;
+
+	enum ChangeKind { Installed, Updated, Uninstalled };
+
+	struct Change
+	{
+		long long m_sequence;
+		ChangeKind m_kind;
+		ProgramId m_program;
+
+		// The date the program has after the change; the last one for uninstallations
+		Date m_date;
+	};
+
+/*-----------------------------------------------------------------*/
+
+	InstallRegistry (
+			std::string const & _machineName
+		,	std::shared_ptr< ProgramCatalog > _catalog = ProgramCatalog::getDefault()
+	);
+
+	std::string const & getMachineName () const;
+
+	void updateMachineName ( std::string const & _machineName );
+
+	ProgramCatalog const & getCatalog () const;
+
+/*-----------------------------------------------------------------*/
+
+	bool isClean () const;
+
+	int getNumInstalledPrograms () const;
+
+	std::set< std::string > fetchAllInstalledProgramNames () const;
+
+	bool isProgramInstalled ( std::string const & _programName ) const;
+
+	Date getProgramInstallationDate ( std::string const & _programName ) const;
+
+	// Sorted
+	std::vector< ProgramId > const & getInstalledProgramIds () const;
+
+	// Programs installed or last updated between the two dates, inclusive
+	std::set< std::string > fetchProgramsInstalledBetween ( Date _from, Date _to ) const;
+
+	// Same as above, ordered by date
+	std::vector< ProgramId > getProgramIdsInstalledBetween ( Date _from, Date _to ) const;
+
+/*-----------------------------------------------------------------*/
+
+	void installProgram ( std::string const & _programName, Date _date );
+
+	void updateProgram ( std::string const & _programName, Date _date );
+
+	void uninstallProgram ( std::string const & _programName );
+
+	void uninstallAll ();
+
+/*-----------------------------------------------------------------*/
+
+	// Installation dates do not matter
+	bool hasIdenticalPrograms ( InstallRegistry const & _other ) const;
+
+	std::set< std::string > getUniqueProgramsComparedTo ( InstallRegistry const & _other ) const;
+
+	// Sorted; no program names are touched
+	std::vector< ProgramId > getUniqueProgramIdsComparedTo ( InstallRegistry const & _other ) const;
+
+/*-----------------------------------------------------------------*/
+
+	// The sequence number the next change will get
+	long long getNextChangeSequence () const;
+
+	// Changes from _cursor on, moving _cursor past them
+	std::vector< Change > fetchChanges ( long long & _cursor ) const;
+
+	// Forgets changes numbered below _sequence
+	void discardChangesBefore ( long long _sequence );
+
+	int getChangeFeedCapacity () const;
+
+	// Drops the oldest changes at once when more are kept
+	void setChangeFeedCapacity ( int _capacity );
 
 /*-----------------------------------------------------------------*/
 
@@ -28,7 +142,43 @@ private:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: private members
+	// -1 when not installed
+	int findProgram ( std::string const & _programName ) const;
+
+	int getInstalledProgramIndex ( std::string const & _programName ) const;
+
+	void checkSameCatalog ( InstallRegistry const & _other ) const;
+
+	static int getDateKey ( Date _date );
+
+	void getDateRange ( Date _from, Date _to, int & _begin, int & _end ) const;
+
+	void addDateEntry ( Date _date, ProgramId _id );
+
+	void removeDateEntry ( Date _date, ProgramId _id );
+
+	void recordChange ( ChangeKind _kind, ProgramId _id, Date _date );
+
+/*-----------------------------------------------------------------*/
+
+	std::string m_machineName;
+
+	std::shared_ptr< ProgramCatalog > m_catalog;
+
+	std::vector< ProgramId > m_programIds;
+
+	std::vector< Date > m_installationDates;
+
+	std::uint64_t m_fingerprint;
+
+	// ( date key, program ) pairs, sorted
+	std::vector< std::pair< int, ProgramId > > m_dateIndex;
+
+	std::deque< Change > m_changes;
+
+	long long m_nextChangeSequence;
+
+	int m_changeFeedCapacity;
 
 /*-----------------------------------------------------------------*/
 
@@ -38,7 +188,84 @@ private:
 /*****************************************************************************/
 
 
-// TODO: inline members
+inline std::string const & InstallRegistry::getMachineName () const
+{
+	return m_machineName;
+}
+
+
+/*****************************************************************************/
+
+
+inline ProgramCatalog const & InstallRegistry::getCatalog () const
+{
+	return * m_catalog;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool InstallRegistry::isClean () const
+{
+	return m_programIds.empty();
+}
+
+
+/*****************************************************************************/
+
+
+inline int InstallRegistry::getNumInstalledPrograms () const
+{
+	return static_cast< int >( m_programIds.size() );
+}
+
+
+/*****************************************************************************/
+
+
+inline std::vector< InstallRegistry::ProgramId > const & InstallRegistry::getInstalledProgramIds () const
+{
+	return m_programIds;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool InstallRegistry::isProgramInstalled ( std::string const & _programName ) const
+{
+	return findProgram( _programName ) != -1;
+}
+
+
+/*****************************************************************************/
+
+
+inline long long InstallRegistry::getNextChangeSequence () const
+{
+	return m_nextChangeSequence;
+}
+
+
+/*****************************************************************************/
+
+
+inline int InstallRegistry::getChangeFeedCapacity () const
+{
+	return m_changeFeedCapacity;
+}
+
+
+/*****************************************************************************/
+
+
+inline int InstallRegistry::getDateKey ( Date _date )
+{
+	// Year, then 4 bits of month and 5 bits of day. No date has day 0, so the key
+	// past a date is below every later one, which getDateRange uses as its end
+	return ( _date.getYear() * 16 + _date.getMonth() ) * 32 + _date.getDay();
+}
 
 
 /*****************************************************************************/
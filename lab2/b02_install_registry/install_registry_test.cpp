@@ -598,3 +598,259 @@ DECLARE_OOP_TEST ( test_InstallRegistry_ComparePrograms_OneCommon_OtherUnique )
 
 
 
+
+
+DECLARE_OOP_TEST ( test_InstallRegistry_ComparePrograms_InstallOrderDoesNotMatter )
+{
+	InstallRegistry r1( "node1" );
+	InstallRegistry r2( "node2" );
+
+	r1.installProgram( "Skype", Date( 2015, 1, 1 ) );
+	r1.installProgram( "Chrome", Date( 2015, 2, 1 ) );
+	r1.installProgram( "Firefox", Date() );
+
+	r2.installProgram( "Firefox", Date( 2014, 5, 5 ) );
+	r2.installProgram( "Skype", Date() );
+	r2.installProgram( "Chrome", Date() );
+
+	assert( r1.hasIdenticalPrograms( r2 ) );
+	assert( r1.getInstalledProgramIds() == r2.getInstalledProgramIds() );
+
+	r2.uninstallProgram( "Skype" );
+	assert( !r1.hasIdenticalPrograms( r2 ) );
+	assert( r1.getUniqueProgramsComparedTo( r2 ) == std::set< std::string >{ "Skype" } );
+
+	r2.installProgram( "Skype", Date() );
+	assert( r1.hasIdenticalPrograms( r2 ) );
+	assert( r1.getUniqueProgramIdsComparedTo( r2 ).empty() );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_InstallRegistry_ComparePrograms_DifferentCatalogs )
+{
+	auto catalog = std::make_shared< ProgramCatalog >();
+
+	InstallRegistry r1( "node1", catalog );
+	InstallRegistry r2( "node2" );
+
+	r1.installProgram( "Skype", Date() );
+	assert( catalog->getProgramsCount() == 1 );
+	assert( r1.getCatalog().getProgramName( r1.getInstalledProgramIds()[ 0 ] ) == "Skype" );
+
+	ASSERT_THROWS(
+			r1.hasIdenticalPrograms( r2 )
+		,	Messages::DifferentProgramCatalogs
+	);
+
+	ASSERT_THROWS(
+			r2.getUniqueProgramsComparedTo( r1 )
+		,	Messages::DifferentProgramCatalogs
+	);
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_InstallRegistry_ComparePrograms_ManyMachines )
+{
+	auto catalog = std::make_shared< ProgramCatalog >();
+
+	std::vector< InstallRegistry > fleet;
+	std::vector< std::set< std::string > > expected( 50 );
+	for ( int i = 0; i < 50; ++i )
+	{
+		fleet.emplace_back( "node" + std::to_string( i ), catalog );
+		for ( int p = 0; p < 40; ++p )
+			if ( ( i * 7 + p * 13 ) % 5 < 2 || ( i % 10 == 0 && p < 20 ) )
+			{
+				const std::string name = "program" + std::to_string( p );
+				fleet.back().installProgram( name, Date() );
+				expected[ i ].insert( name );
+			}
+	}
+
+	for ( int i = 0; i < 50; ++i )
+	{
+		assert( fleet[ i ].fetchAllInstalledProgramNames() == expected[ i ] );
+
+		for ( int j = 0; j < 50; ++j )
+		{
+			assert( fleet[ i ].hasIdenticalPrograms( fleet[ j ] ) == ( expected[ i ] == expected[ j ] ) );
+
+			std::set< std::string > unique;
+			std::set_difference(
+					expected[ i ].begin(), expected[ i ].end()
+				,	expected[ j ].begin(), expected[ j ].end()
+				,	std::inserter( unique, unique.end() )
+			);
+			assert( fleet[ i ].getUniqueProgramsComparedTo( fleet[ j ] ) == unique );
+		}
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_InstallRegistry_FleetCatalogFreedWithFleet )
+{
+	std::weak_ptr< ProgramCatalog > weakCatalog;
+	{
+		auto catalog = std::make_shared< ProgramCatalog >();
+		weakCatalog = catalog;
+
+		// Numbers of a fleet's own catalog start from zero whatever other fleets hold
+		InstallRegistry other( "other" );
+		other.installProgram( "Word", Date() );
+
+		std::vector< InstallRegistry > fleet;
+		fleet.emplace_back( "node1", catalog );
+		fleet.emplace_back( "node2", catalog );
+		catalog.reset();
+
+		fleet[ 0 ].installProgram( "Skype", Date() );
+		fleet[ 1 ].installProgram( "Chrome", Date() );
+		fleet[ 1 ].installProgram( "Skype", Date() );
+
+		ProgramCatalog const & fleetCatalog = fleet[ 0 ].getCatalog();
+		assert( & fleetCatalog == & fleet[ 1 ].getCatalog() );
+		assert( fleetCatalog.getProgramsCount() == 2 );
+		assert( fleetCatalog.getProgramName( 0 ) == "Skype" );
+		assert( fleetCatalog.getProgramName( 1 ) == "Chrome" );
+
+		ProgramCatalog::ProgramId id;
+		assert( !fleetCatalog.findProgram( "Word", id ) );
+
+		// Registries copied from the fleet keep the catalog alive
+		InstallRegistry copy = fleet[ 1 ];
+		fleet.clear();
+		assert( !weakCatalog.expired() );
+		assert( copy.fetchAllInstalledProgramNames() == ( std::set< std::string >{ "Chrome", "Skype" } ) );
+	}
+
+	assert( weakCatalog.expired() );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_InstallRegistry_InstalledBetween )
+{
+	InstallRegistry r( "node" );
+
+	r.installProgram( "Skype", Date( 2015, 1, 10 ) );
+	r.installProgram( "Chrome", Date( 2015, 3, 1 ) );
+	r.installProgram( "Firefox", Date( 2015, 3, 1 ) );
+	r.installProgram( "Word", Date( 2016, 1, 1 ) );
+
+	assert( r.fetchProgramsInstalledBetween( Date( 2015, 1, 10 ), Date( 2015, 3, 1 ) )
+		== ( std::set< std::string >{ "Skype", "Chrome", "Firefox" } ) );
+	assert( r.fetchProgramsInstalledBetween( Date( 2015, 1, 11 ), Date( 2015, 12, 31 ) )
+		== ( std::set< std::string >{ "Chrome", "Firefox" } ) );
+	assert( r.fetchProgramsInstalledBetween( Date( 2014, 1, 1 ), Date( 2014, 12, 31 ) ).empty() );
+
+	r.updateProgram( "Skype", Date( 2016, 2, 1 ) );
+	r.uninstallProgram( "Firefox" );
+
+	assert( r.fetchProgramsInstalledBetween( Date( 2015, 1, 1 ), Date( 2015, 12, 31 ) )
+		== std::set< std::string >{ "Chrome" } );
+
+	std::vector< InstallRegistry::ProgramId > ids = r.getProgramIdsInstalledBetween( Date( 2016, 1, 1 ), Date() );
+	assert( ids.size() == 2 );
+	assert( r.getCatalog().getProgramName( ids[ 0 ] ) == "Word" );
+	assert( r.getCatalog().getProgramName( ids[ 1 ] ) == "Skype" );
+
+	r.uninstallAll();
+	assert( r.fetchProgramsInstalledBetween( Date( 2000, 1, 1 ), Date() ).empty() );
+
+	ASSERT_THROWS(
+			r.fetchProgramsInstalledBetween( Date( 2015, 2, 1 ), Date( 2015, 1, 1 ) )
+		,	Messages::BadDateRange
+	);
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_InstallRegistry_ChangeFeed )
+{
+	InstallRegistry r( "node" );
+	long long cursor = r.getNextChangeSequence();
+	assert( cursor == 0 );
+	assert( r.fetchChanges( cursor ).empty() );
+
+	r.installProgram( "Skype", Date( 2015, 1, 10 ) );
+	r.installProgram( "Chrome", Date( 2015, 3, 1 ) );
+	r.updateProgram( "Skype", Date( 2015, 5, 1 ) );
+
+	std::vector< InstallRegistry::Change > changes = r.fetchChanges( cursor );
+	assert( cursor == 3 );
+	assert( changes.size() == 3 );
+	assert( changes[ 0 ].m_sequence == 0 && changes[ 0 ].m_kind == InstallRegistry::Installed );
+	assert( changes[ 2 ].m_kind == InstallRegistry::Updated && changes[ 2 ].m_date == Date( 2015, 5, 1 ) );
+	assert( r.getCatalog().getProgramName( changes[ 1 ].m_program ) == "Chrome" );
+
+	assert( r.fetchChanges( cursor ).empty() );
+
+	r.uninstallAll();
+	changes = r.fetchChanges( cursor );
+	assert( changes.size() == 2 );
+	assert( changes[ 0 ].m_kind == InstallRegistry::Uninstalled && changes[ 1 ].m_kind == InstallRegistry::Uninstalled );
+	assert( cursor == 5 );
+
+	r.discardChangesBefore( 4 );
+
+	long long lateCursor = 4;
+	assert( r.fetchChanges( lateCursor ).size() == 1 );
+
+	long long staleCursor = 0;
+	ASSERT_THROWS(
+			r.fetchChanges( staleCursor )
+		,	Messages::ChangesDiscarded
+	);
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_InstallRegistry_ChangeFeedCapacity )
+{
+	InstallRegistry r( "node" );
+	assert( r.getChangeFeedCapacity() == InstallRegistry::DefaultChangeFeedCapacity );
+
+	// Nobody pulls, yet the feed keeps only the latest changes
+	for ( int i = 0; i < 3 * InstallRegistry::DefaultChangeFeedCapacity; ++i )
+		r.installProgram( "program" + std::to_string( i ), Date( 2015, 1, 1 ) );
+
+	long long cursor = r.getNextChangeSequence() - InstallRegistry::DefaultChangeFeedCapacity;
+	assert( r.fetchChanges( cursor ).size() == InstallRegistry::DefaultChangeFeedCapacity );
+
+	r.setChangeFeedCapacity( 2 );
+	r.uninstallProgram( "program0" );
+
+	cursor = r.getNextChangeSequence() - 2;
+	std::vector< InstallRegistry::Change > changes = r.fetchChanges( cursor );
+	assert( changes.size() == 2 );
+	assert( changes[ 1 ].m_kind == InstallRegistry::Uninstalled );
+
+	long long staleCursor = r.getNextChangeSequence() - 3;
+	ASSERT_THROWS(
+			r.fetchChanges( staleCursor )
+		,	Messages::ChangesDiscarded
+	);
+
+	ASSERT_THROWS(
+			r.setChangeFeedCapacity( 0 )
+		,	Messages::BadChangeFeedCapacity
+	);
+}
+
+
+/*****************************************************************************/
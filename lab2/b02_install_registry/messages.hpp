@@ -14,6 +14,10 @@ namespace Messages
 	const char * const InstallationDateInFuture = "Installation date is in future";
 	const char * const UpdateDateInFuture = "Update date is in future";
 	const char * const UpdateDateEarlierThanPreviousVersion = "Update date cannot be earlier than the previous installation date";
+	const char * const DifferentProgramCatalogs = "Registries use different program catalogs";
+	const char * const BadDateRange = "Date range is incorrect";
+	const char * const ChangesDiscarded = "Changes were already discarded";
+	const char * const BadChangeFeedCapacity = "Change feed capacity must be positive";
 }
 
 /*****************************************************************************/
@@ -0,0 +1,35 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "program_catalog.hpp"
+
+/*****************************************************************************/
+
+
+ProgramCatalog::ProgramCatalog () = default;
+
+
+/*****************************************************************************/
+
+
+std::shared_ptr< ProgramCatalog > const & ProgramCatalog::getDefault ()
+{
+	static const std::shared_ptr< ProgramCatalog > s_default = std::make_shared< ProgramCatalog >();
+	return s_default;
+}
+
+
+/*****************************************************************************/
+
+
+bool ProgramCatalog::findProgram ( std::string const & _name, ProgramId & _id ) const
+{
+	const int id = m_names.find( _name );
+	if ( id == -1 )
+		return false;
+
+	_id = static_cast< ProgramId >( id );
+	return true;
+}
+
+
+/*****************************************************************************/
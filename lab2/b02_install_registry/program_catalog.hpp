@@ -0,0 +1,123 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _PROGRAM_CATALOG_HPP_
+#define _PROGRAM_CATALOG_HPP_
+
+/*****************************************************************************/
+
+#include "name_table.hpp"
+
+#include <string>
+#include <memory>
+#include <cstdint>
+
+/*****************************************************************************/
+
+/*
+	Interns program names for a fleet of install registries.
+
+	Each distinct name is stored once and numbered in order of appearance;
+	registries keep only the numbers, so comparing the programs of two machines
+	is comparing integers. Numbers are never reused, and stay valid for as long
+	as the catalog lives.
+
+	Every program number also maps to a pseudo-random 64-bit fingerprint.
+	Fingerprints of a set of programs combined with XOR identify the set
+	regardless of the order programs were installed in.
+
+	Names are kept in a NameTable, so the catalog may be shared by registries
+	used from different threads. Registries share the default catalog unless
+	given another one.
+*/
+
+class ProgramCatalog
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*-----------------------------------------------------------------*/
+
+	typedef std::uint32_t ProgramId;
+
+/*-----------------------------------------------------------------*/
+
+	ProgramCatalog ();
+
+	ProgramCatalog ( ProgramCatalog const & ) = delete;
+
+	ProgramCatalog & operator = ( ProgramCatalog const & ) = delete;
+
+	static std::shared_ptr< ProgramCatalog > const & getDefault ();
+
+/*-----------------------------------------------------------------*/
+
+	// Adds the name when it is seen for the first time
+	ProgramId internProgram ( std::string const & _name );
+
+	// False when the name was never interned
+	bool findProgram ( std::string const & _name, ProgramId & _id ) const;
+
+	std::string const & getProgramName ( ProgramId _id ) const;
+
+	int getProgramsCount () const;
+
+	static std::uint64_t getFingerprint ( ProgramId _id );
+
+/*-----------------------------------------------------------------*/
+
+private:
+
+/*-----------------------------------------------------------------*/
+
+	NameTable m_names;
+
+/*-----------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline ProgramCatalog::ProgramId ProgramCatalog::internProgram ( std::string const & _name )
+{
+	return static_cast< ProgramId >( m_names.intern( _name ) );
+}
+
+
+/*****************************************************************************/
+
+
+inline std::string const & ProgramCatalog::getProgramName ( ProgramId _id ) const
+{
+	return m_names.getName( static_cast< int >( _id ) );
+}
+
+
+/*****************************************************************************/
+
+
+inline int ProgramCatalog::getProgramsCount () const
+{
+	return m_names.getNamesCount();
+}
+
+
+/*****************************************************************************/
+
+
+inline std::uint64_t ProgramCatalog::getFingerprint ( ProgramId _id )
+{
+	// SplitMix64 finalizer: consecutive numbers get unrelated fingerprints
+	std::uint64_t x = ( _id + 1ULL ) * 0x9E3779B97F4A7C15ULL;
+	x = ( x ^ ( x >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+	x = ( x ^ ( x >> 27 ) ) * 0x94D049BB133111EBULL;
+	return x ^ ( x >> 31 );
+}
+
+
+/*****************************************************************************/
+
+#endif // _PROGRAM_CATALOG_HPP_
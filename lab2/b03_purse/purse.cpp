@@ -3,10 +3,234 @@
 #include "purse.hpp"
 #include "messages.hpp"
 
+#include <stdexcept>
+
+/*****************************************************************************/
+
+
+Purse::Purse (
+		std::string const & _brand
+	,	int _maxItemsCount
+	,	std::shared_ptr< NameTable > _itemNameTable
+)
+	:	m_brand( _brand )
+	,	m_maxItemsCount( _maxItemsCount )
+	,	m_itemNameTable( std::move( _itemNameTable ) )
+	,	m_totalItemsCount( 0 )
+	,	m_hashShift( 32 )
+	,	m_uniqueItemsCount( 0 )
+	,	m_itemNamesValid( true )
+{
+	if ( _brand.empty() )
+		throw std::logic_error( Messages::EmptyBrandName );
+
+	if ( _maxItemsCount <= 0 )
+		throw std::logic_error( Messages::NonPositiveItemsCount );
+}
+
+
+/*****************************************************************************/
+
+
+int Purse::findSlot ( std::string const & _itemName ) const
+{
+	if ( m_slots.empty() )
+		return -1;
+
+	const int nameId = m_itemNameTable->find( _itemName );
+	if ( nameId == -1 )
+		return -1;
+
+	const int mask = static_cast< int >( m_slots.size() ) - 1;
+	for ( int i = getHomeSlot( nameId ); m_slots[ i ].m_count; i = ( i + 1 ) & mask )
+		if ( m_slots[ i ].m_nameId == nameId )
+			return i;
+
+	return -1;
+}
+
+
 /*****************************************************************************/
 
 
-// TODO
+int Purse::findValidSlot ( std::string const & _itemName ) const
+{
+	if ( _itemName.empty() )
+		throw std::logic_error( Messages::EmptyItemName );
+
+	return findSlot( _itemName );
+}
+
+
+/*****************************************************************************/
+
+
+int Purse::getItemInstancesCount ( std::string const & _itemName ) const
+{
+	const int slot = findValidSlot( _itemName );
+	return ( slot == -1 ) ? 0 : m_slots[ slot ].m_count;
+}
+
+
+/*****************************************************************************/
+
+
+std::set< std::string > const & Purse::getUniqueItemNames () const
+{
+	if ( ! m_itemNamesValid )
+	{
+		m_itemNames.clear();
+		for ( Slot const & slot : m_slots )
+			if ( slot.m_count )
+				m_itemNames.insert( m_itemNameTable->getName( slot.m_nameId ) );
+
+		m_itemNamesValid = true;
+	}
+
+	return m_itemNames;
+}
+
+
+/*****************************************************************************/
+
+
+void Purse::grow ()
+{
+	std::vector< Slot > oldSlots;
+	oldSlots.swap( m_slots );
+
+	m_slots.assign( oldSlots.empty() ? 8 : 2 * oldSlots.size(), Slot{ 0, 0 } );
+	m_hashShift = oldSlots.empty() ? 32 - 3 : m_hashShift - 1;
+
+	const int mask = static_cast< int >( m_slots.size() ) - 1;
+	for ( Slot const & slot : oldSlots )
+		if ( slot.m_count )
+		{
+			int i = getHomeSlot( slot.m_nameId );
+			while ( m_slots[ i ].m_count )
+				i = ( i + 1 ) & mask;
+
+			m_slots[ i ] = slot;
+		}
+}
+
+
+/*****************************************************************************/
+
+
+void Purse::putItem ( std::string const & _itemName, int _count )
+{
+	if ( _itemName.empty() )
+		throw std::logic_error( Messages::EmptyItemName );
+
+	if ( _count <= 0 )
+		throw std::logic_error( Messages::NonPositiveItemsCount );
+
+	if ( _count > m_maxItemsCount - m_totalItemsCount )
+		throw std::logic_error( Messages::NoSpaceInPurse );
+
+	// Keeping the table at most half full makes probe runs short
+	if ( 2 * ( m_uniqueItemsCount + 1 ) > static_cast< int >( m_slots.size() ) )
+		grow();
+
+	const int nameId = m_itemNameTable->intern( _itemName );
+	const int mask = static_cast< int >( m_slots.size() ) - 1;
+
+	int i = getHomeSlot( nameId );
+	while ( m_slots[ i ].m_count && m_slots[ i ].m_nameId != nameId )
+		i = ( i + 1 ) & mask;
+
+	if ( ! m_slots[ i ].m_count )
+	{
+		m_slots[ i ].m_nameId = nameId;
+		++ m_uniqueItemsCount;
+		m_itemNamesValid = false;
+	}
+
+	m_slots[ i ].m_count += _count;
+	m_totalItemsCount += _count;
+}
+
+
+/*****************************************************************************/
+
+
+void Purse::eraseSlot ( int _slot )
+{
+	m_totalItemsCount -= m_slots[ _slot ].m_count;
+
+	// Later slots of the probe run move back into the hole, unless that
+	// would put them before their home slot
+	const int mask = static_cast< int >( m_slots.size() ) - 1;
+	int hole = _slot;
+	for ( int i = ( hole + 1 ) & mask; m_slots[ i ].m_count; i = ( i + 1 ) & mask )
+	{
+		const int home = getHomeSlot( m_slots[ i ].m_nameId );
+		if ( ( ( i - home ) & mask ) >= ( ( i - hole ) & mask ) )
+		{
+			m_slots[ hole ] = m_slots[ i ];
+			hole = i;
+		}
+	}
+
+	m_slots[ hole ].m_count = 0;
+
+	-- m_uniqueItemsCount;
+	m_itemNamesValid = false;
+}
+
+
+/*****************************************************************************/
+
+
+void Purse::removeItem ( std::string const & _itemName, int _count )
+{
+	const int slot = findValidSlot( _itemName );
+
+	if ( _count <= 0 )
+		throw std::logic_error( Messages::NonPositiveItemsCount );
+
+	if ( slot == -1 )
+		throw std::logic_error( Messages::NoSuchItemInPurse );
+
+	if ( _count > m_slots[ slot ].m_count )
+		throw std::logic_error( Messages::NotEnoughItemsInPurse );
+
+	if ( _count == m_slots[ slot ].m_count )
+		eraseSlot( slot );
+	else
+	{
+		m_slots[ slot ].m_count -= _count;
+		m_totalItemsCount -= _count;
+	}
+}
+
+
+/*****************************************************************************/
+
+
+void Purse::removeAllOf ( std::string const & _itemName )
+{
+	const int slot = findValidSlot( _itemName );
+	if ( slot == -1 )
+		throw std::logic_error( Messages::NoSuchItemInPurse );
+
+	eraseSlot( slot );
+}
+
+
+/*****************************************************************************/
+
+
+void Purse::removeAll ()
+{
+	for ( Slot & slot : m_slots )
+		slot.m_count = 0;
+
+	m_totalItemsCount = 0;
+	m_uniqueItemsCount = 0;
+	m_itemNamesValid = false;
+}
 
 
 /*****************************************************************************/
@@ -5,10 +5,30 @@
 
 /*****************************************************************************/
 
+#include "name_table.hpp"
+
 #include <string>
+#include <vector>
+#include <set>
+#include <memory>
 
 /*****************************************************************************/
 
+/*
+	Item names are interned once for all purses, and a purse counts items by
+	name number in an open-addressing table: a flat array of (name, count)
+	slots with linear probing, kept at most half full. A removed item's slot
+	is refilled by shifting later slots of the same probe run back, so there
+	are no tombstones and lookups stop at the first empty slot.
+
+	The total number of items is maintained on every change. The ordered set
+	of names is built on request and kept until an item appears or vanishes;
+	count changes of items already there leave it valid.
+
+	Names are interned in a NameTable given to the purse, the process-wide one
+	by default, so different purses may be used from different threads; one
+	purse is not synchronized. Copies of a purse share its table.
+*/
 
 class Purse
 {
@@ -19,7 +39,35 @@ public:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: public members
+	Purse (
+			std::string const & _brand
+		,	int _maxItemsCount
+		,	std::shared_ptr< NameTable > _itemNameTable = NameTable::getDefault()
+	);
+
+	std::string const & getBrand () const;
+
+	int getMaxItemsCount () const;
+
+	int getTotalItemsCount () const;
+
+/*-----------------------------------------------------------------*/
+
+	bool hasItem ( std::string const & _itemName ) const;
+
+	int getItemInstancesCount ( std::string const & _itemName ) const;
+
+	std::set< std::string > const & getUniqueItemNames () const;
+
+/*-----------------------------------------------------------------*/
+
+	void putItem ( std::string const & _itemName, int _count = 1 );
+
+	void removeItem ( std::string const & _itemName, int _count = 1 );
+
+	void removeAllOf ( std::string const & _itemName );
+
+	void removeAll ();
 
 /*-----------------------------------------------------------------*/
 
@@ -27,7 +75,46 @@ private:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: private members
+	struct Slot
+	{
+		int m_nameId;
+
+		// Empty slots have no items
+		int m_count;
+	};
+
+	int getHomeSlot ( int _nameId ) const;
+
+	// -1 when there are no such items
+	int findSlot ( std::string const & _itemName ) const;
+
+	int findValidSlot ( std::string const & _itemName ) const;
+
+	void eraseSlot ( int _slot );
+
+	void grow ();
+
+/*-----------------------------------------------------------------*/
+
+	const std::string m_brand;
+
+	const int m_maxItemsCount;
+
+	std::shared_ptr< NameTable > m_itemNameTable;
+
+	int m_totalItemsCount;
+
+	// Capacity is a power of 2, or zero before the first item
+	std::vector< Slot > m_slots;
+
+	// 32 minus log2 of the capacity
+	int m_hashShift;
+
+	int m_uniqueItemsCount;
+
+	mutable bool m_itemNamesValid;
+
+	mutable std::set< std::string > m_itemNames;
 
 /*-----------------------------------------------------------------*/
 
@@ -36,7 +123,49 @@ private:
 
 /*****************************************************************************/
 
-// TODO: inline members
+
+inline std::string const & Purse::getBrand () const
+{
+	return m_brand;
+}
+
+
+/*****************************************************************************/
+
+
+inline int Purse::getMaxItemsCount () const
+{
+	return m_maxItemsCount;
+}
+
+
+/*****************************************************************************/
+
+
+inline int Purse::getTotalItemsCount () const
+{
+	return m_totalItemsCount;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Purse::hasItem ( std::string const & _itemName ) const
+{
+	return findValidSlot( _itemName ) != -1;
+}
+
+
+/*****************************************************************************/
+
+
+inline int Purse::getHomeSlot ( int _nameId ) const
+{
+	// Fibonacci hashing: the top bits of the product spread consecutive name numbers
+	return static_cast< int >( ( static_cast< unsigned >( _nameId ) * 2654435769u ) >> m_hashShift );
+}
+
 
 /*****************************************************************************/
 
@@ -7,6 +7,8 @@
 #include "purse.hpp"
 #include "messages.hpp"
 
+#include <vector>
+
 /*****************************************************************************/
 
 
@@ -767,4 +769,105 @@ DECLARE_OOP_TEST ( test_Purse_RemoveAllNonEmptyPurse )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_Purse_ManyItems_GrowAndRemove )
+{
+	Purse p( "Gucci", 10000 );
+
+	for ( int i = 0; i < 200; ++i )
+		p.putItem( "Item" + std::to_string( i ), i % 7 + 1 );
+
+	int expectedTotal = 0;
+	for ( int i = 0; i < 200; ++i )
+		expectedTotal += i % 7 + 1;
+
+	assert( p.getTotalItemsCount() == expectedTotal );
+	assert( p.getUniqueItemNames().size() == 200 );
+
+	// Removing every other item shifts probe runs back into the holes
+	for ( int i = 0; i < 200; i += 2 )
+	{
+		p.removeAllOf( "Item" + std::to_string( i ) );
+		expectedTotal -= i % 7 + 1;
+	}
+
+	assert( p.getTotalItemsCount() == expectedTotal );
+	assert( p.getUniqueItemNames().size() == 100 );
+
+	for ( int i = 0; i < 200; ++i )
+	{
+		const std::string name = "Item" + std::to_string( i );
+		assert( p.hasItem( name ) == ( i % 2 == 1 ) );
+		assert( p.getItemInstancesCount( name ) == ( ( i % 2 ) ? i % 7 + 1 : 0 ) );
+	}
+
+	p.putItem( "Item0", 3 );
+	assert( p.getItemInstancesCount( "Item0" ) == 3 );
+	assert( p.getUniqueItemNames().count( "Item0" ) == 1 );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_Purse_UniqueItemNames_KeptBetweenCalls )
+{
+	Purse p( "Gucci", 10 );
+	p.putItem( "Lipstick", 2 );
+	p.putItem( "Brushes" );
+
+	std::set< std::string > const & names = p.getUniqueItemNames();
+	assert( & names == & p.getUniqueItemNames() );
+
+	p.putItem( "Lipstick" );
+	p.removeItem( "Brushes" );
+	assert( p.getUniqueItemNames() == std::set< std::string >{ "Lipstick" } );
+
+	p.removeAll();
+	assert( p.getUniqueItemNames().empty() );
+
+	p.putItem( "Mirror" );
+	assert( p.getUniqueItemNames() == std::set< std::string >{ "Mirror" } );
+	assert( p.getTotalItemsCount() == 1 );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_Purse_OwnItemNameTable )
+{
+	std::weak_ptr< NameTable > weakTable;
+	{
+		auto table = std::make_shared< NameTable >();
+		weakTable = table;
+
+		Purse p( "Gucci", 10, table );
+		table.reset();
+
+		p.putItem( "OwnTableLipstick", 2 );
+		p.putItem( "OwnTableMirror" );
+
+		// Names go to the purse's table only
+		assert( NameTable::getDefault()->find( "OwnTableLipstick" ) == -1 );
+
+		// A copy shares the table and counts items independently
+		Purse copy = p;
+		copy.putItem( "OwnTableComb" );
+		copy.removeAllOf( "OwnTableMirror" );
+
+		p.removeAll();
+		assert( !weakTable.expired() );
+		assert( !p.hasItem( "OwnTableComb" ) );
+		assert( copy.getItemInstancesCount( "OwnTableLipstick" ) == 2 );
+		assert( copy.getUniqueItemNames() == ( std::set< std::string >{ "OwnTableComb", "OwnTableLipstick" } ) );
+	}
+
+	// Names are freed with the last purse using the table
+	assert( weakTable.expired() );
+}
+
+
 /*****************************************************************************/
@@ -3,8 +3,377 @@
 #include "profiles_manager.hpp"
 #include "messages.hpp"
 
+#include <stdexcept>
+#include <algorithm>
+#include <random>
+
+/*****************************************************************************/
+
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+struct SipHashKey
+{
+	std::uint64_t m_k0, m_k1;
+};
+
+
+/*-----------------------------------------------------------------*/
+
+SipHashKey const & getPasswordKey ()
+{
+	static const SipHashKey s_key = []
+	{
+		std::random_device device;
+		SipHashKey key;
+		key.m_k0 = ( static_cast< std::uint64_t >( device() ) << 32 ) ^ device();
+		key.m_k1 = ( static_cast< std::uint64_t >( device() ) << 32 ) ^ device();
+		return key;
+	}();
+
+	return s_key;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+inline std::uint64_t rotateLeft ( std::uint64_t _x, int _bits )
+{
+	return ( _x << _bits ) | ( _x >> ( 64 - _bits ) );
+}
+
+
+/*-----------------------------------------------------------------*/
+
+inline void sipRound ( std::uint64_t & _v0, std::uint64_t & _v1, std::uint64_t & _v2, std::uint64_t & _v3 )
+{
+	_v0 += _v1; _v1 = rotateLeft( _v1, 13 ); _v1 ^= _v0; _v0 = rotateLeft( _v0, 32 );
+	_v2 += _v3; _v3 = rotateLeft( _v3, 16 ); _v3 ^= _v2;
+	_v0 += _v3; _v3 = rotateLeft( _v3, 21 ); _v3 ^= _v0;
+	_v2 += _v1; _v1 = rotateLeft( _v1, 17 ); _v1 ^= _v2; _v2 = rotateLeft( _v2, 32 );
+}
+
+
+/*-----------------------------------------------------------------*/
+
+// SipHash-2-4, reading the message as little-endian 64-bit words whatever the platform
+std::uint64_t sipHash24 ( SipHashKey const & _key, unsigned char const * _pData, std::size_t _size )
+{
+	std::uint64_t v0 = _key.m_k0 ^ 0x736F6D6570736575ULL;
+	std::uint64_t v1 = _key.m_k1 ^ 0x646F72616E646F6DULL;
+	std::uint64_t v2 = _key.m_k0 ^ 0x6C7967656E657261ULL;
+	std::uint64_t v3 = _key.m_k1 ^ 0x7465646279746573ULL;
+
+	const std::size_t wholeWordsSize = _size & ~static_cast< std::size_t >( 7 );
+	for ( std::size_t i = 0; i < wholeWordsSize; i += 8 )
+	{
+		std::uint64_t m = 0;
+		for ( int j = 7; j >= 0; --j )
+			m = ( m << 8 ) | _pData[ i + j ];
+
+		v3 ^= m;
+		sipRound( v0, v1, v2, v3 );
+		sipRound( v0, v1, v2, v3 );
+		v0 ^= m;
+	}
+
+	// The last word holds the remaining bytes and the length modulo 256 in the top byte
+	std::uint64_t last = static_cast< std::uint64_t >( _size ) << 56;
+	for ( std::size_t j = _size - wholeWordsSize; j > 0; --j )
+		last |= static_cast< std::uint64_t >( _pData[ wholeWordsSize + j - 1 ] ) << ( 8 * ( j - 1 ) );
+
+	v3 ^= last;
+	sipRound( v0, v1, v2, v3 );
+	sipRound( v0, v1, v2, v3 );
+	v0 ^= last;
+
+	v2 ^= 0xFF;
+	for ( int i = 0; i < 4; ++i )
+		sipRound( v0, v1, v2, v3 );
+
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+}
+
+/*****************************************************************************/
+
+
+ProfilesManager::ProfileData::ProfileData (
+		std::string const & _serviceName
+	,	std::string const & _login
+	,	std::string const & _password
+)
+	:	m_serviceName( _serviceName ), m_login( _login ), m_password( _password )
+{
+}
+
+
+/*****************************************************************************/
+
+
+bool ProfilesManager::ProfileData::operator == ( const ProfileData & _profile ) const
+{
+	return m_serviceName == _profile.m_serviceName
+		&& m_login == _profile.m_login
+		&& m_password == _profile.m_password;
+}
+
+
+/*****************************************************************************/
+
+
+bool ProfilesManager::ProfileData::operator != ( const ProfileData & _profile ) const
+{
+	return !( * this == _profile );
+}
+
+
+/*****************************************************************************/
+
+
+ProfilesManager::ProfilesManager ( std::string const & _userName )
+	:	m_userName( _userName )
+{
+	if ( _userName.empty() )
+		throw std::logic_error( Messages::EmptyUserName );
+}
+
+
+/*****************************************************************************/
+
+
+std::uint64_t ProfilesManager::getPasswordFingerprint ( std::string const & _password )
+{
+	return sipHash24(
+			getPasswordKey()
+		,	reinterpret_cast< unsigned char const * >( _password.data() )
+		,	_password.length()
+	);
+}
+
+
+/*****************************************************************************/
+
+
+void ProfilesManager::checkProfileFields (
+		std::string const & _serviceName
+	,	std::string const & _login
+	,	std::string const & _password
+)
+{
+	if ( _serviceName.empty() )
+		throw std::logic_error( Messages::EmptyServiceName );
+
+	if ( _login.empty() )
+		throw std::logic_error( Messages::EmptyLogin );
+
+	if ( _password.empty() )
+		throw std::logic_error( Messages::EmptyPassword );
+}
+
+
+/*****************************************************************************/
+
+
+bool ProfilesManager::hasProfileFor ( std::string const & _serviceName ) const
+{
+	if ( _serviceName.empty() )
+		throw std::logic_error( Messages::EmptyServiceName );
+
+	return m_profiles.find( _serviceName ) != m_profiles.end();
+}
+
+
+/*****************************************************************************/
+
+
+ProfilesManager::ProfileData const & ProfilesManager::getProfile ( std::string const & _serviceName ) const
+{
+	if ( _serviceName.empty() )
+		throw std::logic_error( Messages::EmptyServiceName );
+
+	auto it = m_profiles.find( _serviceName );
+	if ( it == m_profiles.end() )
+		throw std::logic_error( Messages::NoServiceProfile );
+
+	return it->second;
+}
+
+
+/*****************************************************************************/
+
+
+void ProfilesManager::indexProfile ( ProfileData const & _profile )
+{
+	m_servicesByLogin[ _profile.m_login ].insert( _profile.m_serviceName );
+
+	const std::uint64_t fingerprint = getPasswordFingerprint( _profile.m_password );
+	std::set< std::string > & services = m_servicesByPassword[ fingerprint ];
+	services.insert( _profile.m_serviceName );
+	if ( services.size() == 2 )
+		m_sharedPasswords.insert( fingerprint );
+}
+
+
+/*****************************************************************************/
+
+
+void ProfilesManager::unindexProfile ( ProfileData const & _profile )
+{
+	auto loginIt = m_servicesByLogin.find( _profile.m_login );
+	loginIt->second.erase( _profile.m_serviceName );
+	if ( loginIt->second.empty() )
+		m_servicesByLogin.erase( loginIt );
+
+	const std::uint64_t fingerprint = getPasswordFingerprint( _profile.m_password );
+	auto passwordIt = m_servicesByPassword.find( fingerprint );
+	passwordIt->second.erase( _profile.m_serviceName );
+	if ( passwordIt->second.size() == 1 )
+		m_sharedPasswords.erase( fingerprint );
+	else if ( passwordIt->second.empty() )
+		m_servicesByPassword.erase( passwordIt );
+}
+
+
+/*****************************************************************************/
+
+
+void ProfilesManager::addProfileData (
+		std::string const & _serviceName
+	,	std::string const & _login
+	,	std::string const & _password
+)
+{
+	checkProfileFields( _serviceName, _login, _password );
+
+	auto result = m_profiles.emplace( _serviceName, ProfileData( _serviceName, _login, _password ) );
+	if ( ! result.second )
+		throw std::logic_error( Messages::ServiceProfileExists );
+
+	indexProfile( result.first->second );
+}
+
+
+/*****************************************************************************/
+
+
+void ProfilesManager::updateProfileData (
+		std::string const & _serviceName
+	,	std::string const & _login
+	,	std::string const & _password
+)
+{
+	checkProfileFields( _serviceName, _login, _password );
+
+	auto it = m_profiles.find( _serviceName );
+	if ( it == m_profiles.end() )
+		throw std::logic_error( Messages::NoServiceProfile );
+
+	unindexProfile( it->second );
+	it->second.m_login = _login;
+	it->second.m_password = _password;
+	indexProfile( it->second );
+}
+
+
+/*****************************************************************************/
+
+
+void ProfilesManager::removeProfile ( std::string const & _serviceName )
+{
+	if ( _serviceName.empty() )
+		throw std::logic_error( Messages::EmptyServiceName );
+
+	auto it = m_profiles.find( _serviceName );
+	if ( it == m_profiles.end() )
+		throw std::logic_error( Messages::NoServiceProfile );
+
+	unindexProfile( it->second );
+	m_profiles.erase( it );
+}
+
+
+/*****************************************************************************/
+
+
+void ProfilesManager::removeAllProfiles ()
+{
+	m_profiles.clear();
+	m_servicesByLogin.clear();
+	m_servicesByPassword.clear();
+	m_sharedPasswords.clear();
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< std::string > ProfilesManager::getServicesWithLogin ( std::string const & _login ) const
+{
+	if ( _login.empty() )
+		throw std::logic_error( Messages::EmptyLogin );
+
+	auto it = m_servicesByLogin.find( _login );
+	if ( it == m_servicesByLogin.end() )
+		return std::vector< std::string >();
+
+	return std::vector< std::string >( it->second.begin(), it->second.end() );
+}
+
+
 /*****************************************************************************/
 
-// TODO ...
+
+std::vector< std::vector< std::string > > ProfilesManager::findServicesWithIdenticalPassword () const
+{
+	std::vector< std::vector< std::string > > result;
+
+	for ( std::uint64_t fingerprint : m_sharedPasswords )
+	{
+		// Almost always a single password; otherwise each service joins the
+		// group of the first earlier service with the same password
+		std::vector< std::vector< std::string > > groups;
+		std::vector< std::string const * > groupPasswords;
+
+		for ( std::string const & serviceName : m_servicesByPassword.find( fingerprint )->second )
+		{
+			std::string const & password = m_profiles.find( serviceName )->second.m_password;
+
+			int group = 0;
+			const int nGroups = static_cast< int >( groups.size() );
+			while ( group < nGroups && * groupPasswords[ group ] != password )
+				++ group;
+
+			if ( group == nGroups )
+			{
+				groups.emplace_back();
+				groupPasswords.push_back( & password );
+			}
+
+			groups[ group ].push_back( serviceName );
+		}
+
+		for ( auto & group : groups )
+			if ( group.size() > 1 )
+				result.push_back( std::move( group ) );
+	}
+
+	std::sort(
+			result.begin(), result.end()
+		,	[] ( std::vector< std::string > const & _group1, std::vector< std::string > const & _group2 )
+			{
+				return _group1.front() < _group2.front();
+			}
+	);
+
+	return result;
+}
+
 
 /*****************************************************************************/
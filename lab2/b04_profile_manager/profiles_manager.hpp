@@ -6,9 +6,28 @@
 /*****************************************************************************/
 
 #include <string>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
 
 /*****************************************************************************/
 
+/*
+	Profiles are kept by service name, and two indexes are maintained on every
+	change: services grouped by login, and services grouped by a 64-bit
+	fingerprint of the password. The password index never holds passwords,
+	only fingerprints; the fingerprints that more than one service shares are
+	tracked separately, so looking for reused passwords visits only them.
+
+	Fingerprints are SipHash-2-4 of the password under a key drawn from
+	std::random_device once per process, so they cannot be precomputed for
+	guessed passwords or reproduced outside the process, and nobody can pick
+	passwords that collide on purpose. Different passwords may still share a
+	fingerprint by chance, so the services of a shared fingerprint are split
+	by comparing the passwords of their profiles.
+*/
 
 class ProfilesManager
 {
@@ -36,7 +55,41 @@ public:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: public members
+	ProfilesManager ( std::string const & _userName );
+
+	std::string const & getUserName () const;
+
+	int getProfilesCount () const;
+
+	bool hasProfileFor ( std::string const & _serviceName ) const;
+
+	ProfileData const & getProfile ( std::string const & _serviceName ) const;
+
+/*-----------------------------------------------------------------*/
+
+	void addProfileData (
+			std::string const & _serviceName
+		,	std::string const & _login
+		,	std::string const & _password
+	);
+
+	void updateProfileData (
+			std::string const & _serviceName
+		,	std::string const & _login
+		,	std::string const & _password
+	);
+
+	void removeProfile ( std::string const & _serviceName );
+
+	void removeAllProfiles ();
+
+/*-----------------------------------------------------------------*/
+
+	// Sorted
+	std::vector< std::string > getServicesWithLogin ( std::string const & _login ) const;
+
+	// Groups of two or more services each, sorted, ordered by their first service
+	std::vector< std::vector< std::string > > findServicesWithIdenticalPassword () const;
 
 /*-----------------------------------------------------------------*/
 
@@ -44,7 +97,30 @@ private:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: private members
+	static std::uint64_t getPasswordFingerprint ( std::string const & _password );
+
+	static void checkProfileFields (
+			std::string const & _serviceName
+		,	std::string const & _login
+		,	std::string const & _password
+	);
+
+	void indexProfile ( ProfileData const & _profile );
+
+	void unindexProfile ( ProfileData const & _profile );
+
+/*-----------------------------------------------------------------*/
+
+	const std::string m_userName;
+
+	std::unordered_map< std::string, ProfileData > m_profiles;
+
+	std::unordered_map< std::string, std::set< std::string > > m_servicesByLogin;
+
+	std::unordered_map< std::uint64_t, std::set< std::string > > m_servicesByPassword;
+
+	// Fingerprints with two or more services
+	std::unordered_set< std::uint64_t > m_sharedPasswords;
 
 /*-----------------------------------------------------------------*/
 
@@ -54,7 +130,20 @@ private:
 /*****************************************************************************/
 
 
-// TODO: inline functions
+inline std::string const & ProfilesManager::getUserName () const
+{
+	return m_userName;
+}
+
+
+/*****************************************************************************/
+
+
+inline int ProfilesManager::getProfilesCount () const
+{
+	return static_cast< int >( m_profiles.size() );
+}
+
 
 /*****************************************************************************/
 
@@ -498,4 +498,89 @@ DECLARE_OOP_TEST ( test_ProfilesManager_FindSamePassword_ManyProfilesAllIdentica
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_ProfilesManager_Indexes_FollowUpdatesAndRemovals )
+{
+	ProfilesManager pm( "Ivan" );
+	pm.addProfileData( "Gmail", "ivan@gmail.com", "12345" );
+	pm.addProfileData( "Facebook", "ivan@gmail.com", "12345" );
+	pm.addProfileData( "Twitter", "ivan2@gmail.com", "23456" );
+
+	pm.updateProfileData( "Facebook", "ivan2@gmail.com", "23456" );
+
+	assert( pm.getServicesWithLogin( "ivan@gmail.com" ) == std::vector< std::string >{ "Gmail" } );
+	assert( pm.getServicesWithLogin( "ivan2@gmail.com" ) == ( std::vector< std::string >{ "Facebook", "Twitter" } ) );
+
+	std::vector< std::vector< std::string > > expectedServices{ { "Facebook", "Twitter" } };
+	assert( pm.findServicesWithIdenticalPassword() == expectedServices );
+
+	pm.removeProfile( "Twitter" );
+	assert( pm.getServicesWithLogin( "ivan2@gmail.com" ) == std::vector< std::string >{ "Facebook" } );
+	assert( pm.findServicesWithIdenticalPassword().empty() );
+
+	pm.removeAllProfiles();
+	assert( pm.getServicesWithLogin( "ivan@gmail.com" ).empty() );
+	assert( pm.findServicesWithIdenticalPassword().empty() );
+
+	pm.addProfileData( "Gmail", "ivan@gmail.com", "12345" );
+	pm.addProfileData( "Facebook", "ivan@gmail.com", "12345" );
+	assert( pm.findServicesWithIdenticalPassword().size() == 1 );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST ( test_ProfilesManager_Indexes_MatchFullScan )
+{
+	ProfilesManager pm( "Ivan" );
+
+	std::vector< std::string > services;
+	for ( int i = 0; i < 300; ++i )
+	{
+		services.push_back( "Service" + std::to_string( i ) );
+		pm.addProfileData(
+				services.back()
+			,	"login" + std::to_string( i % 17 )
+			,	"password" + std::to_string( i % 41 )
+		);
+	}
+
+	for ( int i = 0; i < 300; i += 3 )
+		pm.updateProfileData( services[ i ], "login" + std::to_string( i % 5 ), "password" + std::to_string( i % 7 ) );
+
+	for ( int i = 1; i < 300; i += 4 )
+		pm.removeProfile( services[ i ] );
+
+	for ( int l = 0; l < 17; ++l )
+	{
+		const std::string login = "login" + std::to_string( l );
+
+		std::vector< std::string > expected;
+		for ( std::string const & service : services )
+			if ( pm.hasProfileFor( service ) && pm.getProfile( service ).m_login == login )
+				expected.push_back( service );
+
+		std::sort( expected.begin(), expected.end() );
+		assert( pm.getServicesWithLogin( login ) == expected );
+	}
+
+	int nGroupedServices = 0;
+	for ( auto const & group : pm.findServicesWithIdenticalPassword() )
+	{
+		assert( group.size() > 1 );
+		assert( std::is_sorted( group.begin(), group.end() ) );
+
+		for ( std::string const & service : group )
+			assert( pm.getProfile( service ).m_password == pm.getProfile( group.front() ).m_password );
+
+		nGroupedServices += static_cast< int >( group.size() );
+	}
+
+	assert( nGroupedServices == pm.getProfilesCount() );
+}
+
+
 /*****************************************************************************/
@@ -16,6 +16,9 @@ namespace Messages
 	const char * const DuplicateIngredient = "Ingredient must be unique";
 	const char * const IngredientCannotBeFound = "Ingredient cannot be found";
 	const char * const IndexOutOfRange = "Index out of range";
+	const char * const ScaleFactorMustBePositive = "Scale factor must be positive";
+	const char * const ScaledIngredientOutOfRange = "Scaled ingredient value is out of range";
+	const char * const DifferentIngredientNameTables = "Recipe uses a different ingredient name table";
 }
 
 /*****************************************************************************/
@@ -3,8 +3,240 @@
 #include "recipe.hpp"
 #include "messages.hpp"
 
+#include <stdexcept>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+/*****************************************************************************/
+
+
+const int Recipe::InlineIngredients;
+
+
+/*****************************************************************************/
+
+
+Recipe::Recipe (
+		std::string const & _name
+	,	std::string const & _description
+	,	std::string const & _author
+	,	std::shared_ptr< NameTable > _ingredientNameTable
+)
+	:	m_name( _name ), m_description( _description ), m_author( _author )
+	,	m_ingredientNameTable( std::move( _ingredientNameTable ) ), m_ingredientsCount( 0 )
+{
+	if ( _name.empty() )
+		throw std::logic_error( Messages::EmptyRecipeName );
+
+	if ( _description.empty() )
+		throw std::logic_error( Messages::EmptyRecipeDescription );
+
+	if ( _author.empty() )
+		throw std::logic_error( Messages::EmptyRecipeAuthor );
+}
+
+
+/*****************************************************************************/
+
+
+int Recipe::findIngredientPosition ( int _nameId ) const
+{
+	Ingredient const * pIngredients = getIngredients();
+	return static_cast< int >(
+		std::lower_bound(
+				pIngredients, pIngredients + m_ingredientsCount, _nameId
+			,	[] ( Ingredient _ingredient, int _id ) { return _ingredient.m_nameId < _id; }
+		) - pIngredients
+	);
+}
+
+
+/*****************************************************************************/
+
+
+bool Recipe::hasIngredient ( std::string const & _name ) const
+{
+	const int nameId = m_ingredientNameTable->find( _name );
+	if ( nameId == -1 )
+		return false;
+
+	const int position = findIngredientPosition( nameId );
+	return position < m_ingredientsCount && getIngredients()[ position ].m_nameId == nameId;
+}
+
+
+/*****************************************************************************/
+
+
+int Recipe::getIngredientIndex ( std::string const & _name ) const
+{
+	if ( _name.empty() )
+		throw std::logic_error( Messages::EmptyIngredientName );
+
+	const int nameId = m_ingredientNameTable->find( _name );
+	const int position = ( nameId == -1 ) ? m_ingredientsCount : findIngredientPosition( nameId );
+	if ( position == m_ingredientsCount || getIngredients()[ position ].m_nameId != nameId )
+		throw std::logic_error( Messages::IngredientCannotBeFound );
+
+	return position;
+}
+
+
+/*****************************************************************************/
+
+
+int Recipe::getIngredientValue ( std::string const & _name ) const
+{
+	return getIngredients()[ getIngredientIndex( _name ) ].m_value;
+}
+
+
+/*****************************************************************************/
+
+
+void Recipe::addIngredient ( std::string const & _name, int _value )
+{
+	if ( _name.empty() )
+		throw std::logic_error( Messages::EmptyIngredientName );
+
+	if ( _value <= 0 )
+		throw std::logic_error( Messages::IngredientValueMustBePositive );
+
+	const int nameId = m_ingredientNameTable->intern( _name );
+	const int position = findIngredientPosition( nameId );
+	if ( position < m_ingredientsCount && getIngredients()[ position ].m_nameId == nameId )
+		throw std::logic_error( Messages::DuplicateIngredient );
+
+	const Ingredient ingredient{ nameId, _value };
+
+	if ( ! m_spilledIngredients.empty() )
+		m_spilledIngredients.insert( m_spilledIngredients.begin() + position, ingredient );
+
+	else if ( m_ingredientsCount < InlineIngredients )
+	{
+		std::copy_backward(
+				m_inlineIngredients + position
+			,	m_inlineIngredients + m_ingredientsCount
+			,	m_inlineIngredients + m_ingredientsCount + 1
+		);
+		m_inlineIngredients[ position ] = ingredient;
+	}
+
+	else
+	{
+		m_spilledIngredients.reserve( 2 * InlineIngredients );
+		m_spilledIngredients.assign( m_inlineIngredients, m_inlineIngredients + m_ingredientsCount );
+		m_spilledIngredients.insert( m_spilledIngredients.begin() + position, ingredient );
+	}
+
+	++ m_ingredientsCount;
+}
+
+
+/*****************************************************************************/
+
+
+void Recipe::modifyIngredient ( std::string const & _name, int _value )
+{
+	if ( _name.empty() )
+		throw std::logic_error( Messages::EmptyIngredientName );
+
+	if ( _value <= 0 )
+		throw std::logic_error( Messages::IngredientValueMustBePositive );
+
+	getIngredients()[ getIngredientIndex( _name ) ].m_value = _value;
+}
+
+
 /*****************************************************************************/
 
-// TODO ...
+
+void Recipe::scaleIngredients ( double _factor )
+{
+	if ( !( _factor > 0.0 ) )
+		throw std::logic_error( Messages::ScaleFactorMustBePositive );
+
+	Ingredient * pIngredients = getIngredients();
+
+	// Checked in a pass of its own, so that a failure leaves all values as they were
+	for ( int i = 0; i < m_ingredientsCount; ++i )
+	{
+		const double scaled = std::round( pIngredients[ i ].m_value * _factor );
+		if ( scaled < 1.0 || scaled > INT_MAX )
+			throw std::logic_error( Messages::ScaledIngredientOutOfRange );
+	}
+
+	for ( int i = 0; i < m_ingredientsCount; ++i )
+		pIngredients[ i ].m_value = static_cast< int >( std::round( pIngredients[ i ].m_value * _factor ) );
+}
+
+
+/*****************************************************************************/
+
+
+std::string const & Recipe::getCookStep ( int _index ) const
+{
+	if ( _index < 0 || _index >= getCookStepsCount() )
+		throw std::logic_error( Messages::IndexOutOfRange );
+
+	return m_cookSteps[ _index ];
+}
+
+
+/*****************************************************************************/
+
+
+void Recipe::addCookStep ( std::string const & _step )
+{
+	if ( _step.empty() )
+		throw std::logic_error( Messages::EmptyCookStep );
+
+	m_cookSteps.push_back( _step );
+}
+
+
+/*****************************************************************************/
+
+
+bool Recipe::hasSameIngredients ( Recipe const & _other ) const
+{
+	if ( m_ingredientsCount != _other.m_ingredientsCount )
+		return false;
+
+	// Names of one table share one numbering, so equal ingredient lists are equal arrays
+	Ingredient const * pIngredients = getIngredients();
+	if ( m_ingredientNameTable == _other.m_ingredientNameTable )
+		return std::equal( pIngredients, pIngredients + m_ingredientsCount, _other.getIngredients() );
+
+	// Otherwise each ingredient is looked up by name; names are unique and counts equal
+	for ( int i = 0; i < m_ingredientsCount; ++i )
+	{
+		const int nameId = _other.m_ingredientNameTable->find( m_ingredientNameTable->getName( pIngredients[ i ].m_nameId ) );
+		if ( nameId == -1 )
+			return false;
+
+		const int position = _other.findIngredientPosition( nameId );
+		if ( position == _other.m_ingredientsCount
+			|| !( _other.getIngredients()[ position ] == Ingredient{ nameId, pIngredients[ i ].m_value } ) )
+			return false;
+	}
+
+	return true;
+}
+
+
+/*****************************************************************************/
+
+
+bool Recipe::operator == ( Recipe const & _other ) const
+{
+	return m_name == _other.m_name
+		&& m_description == _other.m_description
+		&& m_author == _other.m_author
+		&& hasSameIngredients( _other )
+		&& m_cookSteps == _other.m_cookSteps;
+}
+
 
 /*****************************************************************************/
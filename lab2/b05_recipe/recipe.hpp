@@ -5,21 +5,127 @@
 
 /*****************************************************************************/
 
+#include "name_table.hpp"
+
 #include <string>
+#include <vector>
+#include <utility>
+#include <memory>
 
 /*****************************************************************************/
 
+/*
+	Ingredient names are interned in a NameTable; a recipe holds
+	(name number, value) pairs sorted by name number. Up to InlineIngredients
+	pairs live inside the recipe object itself, so typical recipes need no
+	allocation for ingredients; larger ones move all pairs to a vector.
+
+	Ingredients are visited in name number order. Recipes share the
+	process-wide table unless given another one, and copies share the table
+	of the original, so different recipes may be used from different threads;
+	one recipe is not synchronized.
+*/
 
 class Recipe
 {
 
+/*-----------------------------------------------------------------*/
+
+	struct Ingredient
+	{
+		int m_nameId;
+		int m_value;
+
+		bool operator == ( Ingredient _other ) const;
+	};
+
 /*-----------------------------------------------------------------*/
 
 public:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: public members
+	class IngredientIterator
+	{
+
+	public:
+
+		typedef std::pair< std::string const &, int > Value;
+
+		struct Arrow
+		{
+			Value m_value;
+
+			Value const * operator -> () const { return & m_value; }
+		};
+
+		IngredientIterator ( NameTable const & _names, Ingredient const * _pIngredient );
+
+		Value operator * () const;
+
+		Arrow operator -> () const;
+
+		IngredientIterator & operator ++ ();
+
+		bool operator == ( IngredientIterator _other ) const;
+
+		bool operator != ( IngredientIterator _other ) const;
+
+	private:
+
+		NameTable const * m_pNames;
+
+		Ingredient const * m_pIngredient;
+	};
+
+/*-----------------------------------------------------------------*/
+
+	Recipe (
+			std::string const & _name
+		,	std::string const & _description
+		,	std::string const & _author
+		,	std::shared_ptr< NameTable > _ingredientNameTable = NameTable::getDefault()
+	);
+
+	std::string const & getName () const;
+
+	std::string const & getDescription () const;
+
+	std::string const & getAuthor () const;
+
+/*-----------------------------------------------------------------*/
+
+	int getIngredientsCount () const;
+
+	bool hasIngredient ( std::string const & _name ) const;
+
+	int getIngredientValue ( std::string const & _name ) const;
+
+	void addIngredient ( std::string const & _name, int _value );
+
+	void modifyIngredient ( std::string const & _name, int _value );
+
+	// Multiplies every value by the factor, rounding to nearest;
+	// on error no value is changed
+	void scaleIngredients ( double _factor );
+
+	IngredientIterator beginIngredients () const;
+
+	IngredientIterator endIngredients () const;
+
+/*-----------------------------------------------------------------*/
+
+	int getCookStepsCount () const;
+
+	std::string const & getCookStep ( int _index ) const;
+
+	void addCookStep ( std::string const & _step );
+
+/*-----------------------------------------------------------------*/
+
+	bool operator == ( Recipe const & _other ) const;
+
+	bool operator != ( Recipe const & _other ) const;
 
 /*-----------------------------------------------------------------*/
 
@@ -27,15 +133,200 @@ private:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: private members
+	// The catalog indexes ingredient name numbers directly
+	friend class RecipeCatalog;
+
+	Ingredient const * getIngredients () const;
+
+	Ingredient * getIngredients ();
+
+	// Position of the first ingredient with the same or a greater name number
+	int findIngredientPosition ( int _nameId ) const;
+
+	// Index of the ingredient, throws when there is none
+	int getIngredientIndex ( std::string const & _name ) const;
+
+	bool hasSameIngredients ( Recipe const & _other ) const;
+
+/*-----------------------------------------------------------------*/
+
+	static const int InlineIngredients = 15;
+
+	const std::string m_name;
+
+	const std::string m_description;
+
+	const std::string m_author;
+
+	std::shared_ptr< NameTable > m_ingredientNameTable;
+
+	int m_ingredientsCount;
+
+	Ingredient m_inlineIngredients[ InlineIngredients ];
+
+	// All ingredients, once there are more than fit inline
+	std::vector< Ingredient > m_spilledIngredients;
+
+	std::vector< std::string > m_cookSteps;
 
 /*-----------------------------------------------------------------*/
 
 };
 
+
+/*****************************************************************************/
+
+
+inline bool Recipe::Ingredient::operator == ( Ingredient _other ) const
+{
+	return m_nameId == _other.m_nameId && m_value == _other.m_value;
+}
+
+
+/*****************************************************************************/
+
+
+inline Recipe::IngredientIterator::IngredientIterator ( NameTable const & _names, Ingredient const * _pIngredient )
+	:	m_pNames( & _names ), m_pIngredient( _pIngredient )
+{
+}
+
+
+/*****************************************************************************/
+
+
+inline Recipe::IngredientIterator::Value Recipe::IngredientIterator::operator * () const
+{
+	return Value( m_pNames->getName( m_pIngredient->m_nameId ), m_pIngredient->m_value );
+}
+
+
+/*****************************************************************************/
+
+
+inline Recipe::IngredientIterator::Arrow Recipe::IngredientIterator::operator -> () const
+{
+	return Arrow{ * * this };
+}
+
+
+/*****************************************************************************/
+
+
+inline Recipe::IngredientIterator & Recipe::IngredientIterator::operator ++ ()
+{
+	++ m_pIngredient;
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Recipe::IngredientIterator::operator == ( IngredientIterator _other ) const
+{
+	return m_pIngredient == _other.m_pIngredient;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Recipe::IngredientIterator::operator != ( IngredientIterator _other ) const
+{
+	return !( * this == _other );
+}
+
+
+/*****************************************************************************/
+
+
+inline std::string const & Recipe::getName () const
+{
+	return m_name;
+}
+
+
+/*****************************************************************************/
+
+
+inline std::string const & Recipe::getDescription () const
+{
+	return m_description;
+}
+
+
+/*****************************************************************************/
+
+
+inline std::string const & Recipe::getAuthor () const
+{
+	return m_author;
+}
+
+
+/*****************************************************************************/
+
+
+inline int Recipe::getIngredientsCount () const
+{
+	return m_ingredientsCount;
+}
+
+
+/*****************************************************************************/
+
+
+inline Recipe::Ingredient const * Recipe::getIngredients () const
+{
+	return m_spilledIngredients.empty() ? m_inlineIngredients : m_spilledIngredients.data();
+}
+
+
+/*****************************************************************************/
+
+
+inline Recipe::Ingredient * Recipe::getIngredients ()
+{
+	return m_spilledIngredients.empty() ? m_inlineIngredients : m_spilledIngredients.data();
+}
+
+
+/*****************************************************************************/
+
+
+inline Recipe::IngredientIterator Recipe::beginIngredients () const
+{
+	return IngredientIterator( * m_ingredientNameTable, getIngredients() );
+}
+
+
+/*****************************************************************************/
+
+
+inline Recipe::IngredientIterator Recipe::endIngredients () const
+{
+	return IngredientIterator( * m_ingredientNameTable, getIngredients() + m_ingredientsCount );
+}
+
+
+/*****************************************************************************/
+
+
+inline int Recipe::getCookStepsCount () const
+{
+	return static_cast< int >( m_cookSteps.size() );
+}
+
+
 /*****************************************************************************/
 
-// TODO: inline functions
+
+inline bool Recipe::operator != ( Recipe const & _other ) const
+{
+	return !( * this == _other );
+}
+
 
 /*****************************************************************************/
 
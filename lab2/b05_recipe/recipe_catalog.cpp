@@ -0,0 +1,90 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "recipe_catalog.hpp"
+#include "messages.hpp"
+
+#include <stdexcept>
+
+/*****************************************************************************/
+
+
+RecipeCatalog::RecipeCatalog ( std::shared_ptr< NameTable > _ingredientNameTable )
+	:	m_ingredientNameTable( std::move( _ingredientNameTable ) )
+{
+}
+
+
+/*****************************************************************************/
+
+
+int RecipeCatalog::addRecipe ( Recipe _recipe )
+{
+	if ( _recipe.m_ingredientNameTable != m_ingredientNameTable )
+		throw std::logic_error( Messages::DifferentIngredientNameTables );
+
+	const int index = getRecipesCount();
+
+	Recipe::Ingredient const * pIngredients = _recipe.getIngredients();
+	for ( int i = 0; i < _recipe.getIngredientsCount(); ++i )
+	{
+		const int nameId = pIngredients[ i ].m_nameId;
+		if ( nameId >= static_cast< int >( m_recipesByIngredient.size() ) )
+			m_recipesByIngredient.resize( nameId + 1 );
+
+		m_recipesByIngredient[ nameId ].push_back( index );
+	}
+
+	m_recipes.push_back( std::move( _recipe ) );
+	return index;
+}
+
+
+/*****************************************************************************/
+
+
+Recipe const & RecipeCatalog::getRecipe ( int _index ) const
+{
+	if ( _index < 0 || _index >= getRecipesCount() )
+		throw std::logic_error( Messages::IndexOutOfRange );
+
+	return m_recipes[ _index ];
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< int > const * RecipeCatalog::findIngredientRecipes ( std::string const & _ingredientName ) const
+{
+	if ( _ingredientName.empty() )
+		throw std::logic_error( Messages::EmptyIngredientName );
+
+	const int nameId = m_ingredientNameTable->find( _ingredientName );
+	if ( nameId == -1 || nameId >= static_cast< int >( m_recipesByIngredient.size() ) )
+		return nullptr;
+
+	return & m_recipesByIngredient[ nameId ];
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< int > RecipeCatalog::findRecipesUsing ( std::string const & _ingredientName ) const
+{
+	std::vector< int > const * pRecipes = findIngredientRecipes( _ingredientName );
+	return pRecipes ? * pRecipes : std::vector< int >();
+}
+
+
+/*****************************************************************************/
+
+
+int RecipeCatalog::countRecipesUsing ( std::string const & _ingredientName ) const
+{
+	std::vector< int > const * pRecipes = findIngredientRecipes( _ingredientName );
+	return pRecipes ? static_cast< int >( pRecipes->size() ) : 0;
+}
+
+
+/*****************************************************************************/
@@ -0,0 +1,91 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _RECIPE_CATALOG_HPP_
+#define _RECIPE_CATALOG_HPP_
+
+/*****************************************************************************/
+
+#include "recipe.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+/*****************************************************************************/
+
+/*
+	Owns a collection of recipes and indexes them by ingredient.
+
+	For every ingredient name number the catalog keeps the indices of recipes
+	using it. Recipes are only appended and cannot be changed once added, so
+	the lists stay sorted and never need rebuilding; a lookup is a single
+	name lookup followed by a copy of one list.
+
+	Name numbers are only meaningful within one name table, so the catalog
+	accepts only recipes sharing its table.
+*/
+
+class RecipeCatalog
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*-----------------------------------------------------------------*/
+
+	explicit RecipeCatalog ( std::shared_ptr< NameTable > _ingredientNameTable = NameTable::getDefault() );
+
+	RecipeCatalog ( RecipeCatalog const & ) = delete;
+
+	RecipeCatalog & operator = ( RecipeCatalog const & ) = delete;
+
+/*-----------------------------------------------------------------*/
+
+	// Returns the index of the recipe within the catalog
+	int addRecipe ( Recipe _recipe );
+
+	int getRecipesCount () const;
+
+	Recipe const & getRecipe ( int _index ) const;
+
+	// Indices of recipes with the ingredient, sorted
+	std::vector< int > findRecipesUsing ( std::string const & _ingredientName ) const;
+
+	int countRecipesUsing ( std::string const & _ingredientName ) const;
+
+/*-----------------------------------------------------------------*/
+
+private:
+
+/*-----------------------------------------------------------------*/
+
+	// Null when no recipe uses the ingredient
+	std::vector< int > const * findIngredientRecipes ( std::string const & _ingredientName ) const;
+
+/*-----------------------------------------------------------------*/
+
+	std::shared_ptr< NameTable > m_ingredientNameTable;
+
+	std::vector< Recipe > m_recipes;
+
+	// Recipe indices by ingredient name number
+	std::vector< std::vector< int > > m_recipesByIngredient;
+
+/*-----------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline int RecipeCatalog::getRecipesCount () const
+{
+	return static_cast< int >( m_recipes.size() );
+}
+
+
+/*****************************************************************************/
+
+#endif // _RECIPE_CATALOG_HPP_
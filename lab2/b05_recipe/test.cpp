@@ -3,6 +3,7 @@
 /*****************************************************************************/
 
 #include "recipe.hpp"
+#include "recipe_catalog.hpp"
 #include "messages.hpp"
 
 #include "testslib.hpp"
@@ -61,6 +62,15 @@
 	Done		5.9) Different cook steps
 	Done		5.10) Different order of cook steps
 	Done		5.11) Equal complex recipes
+	Done	6) Ingredients storage
+	Done		6.1) Many ingredients
+	Done		6.2) Scale ingredients
+	Done		6.3) Scale ingredients out of range
+	Done	7) Recipe catalog
+	Done		7.1) Find recipes using ingredient
+	Done	8) Ingredient name tables
+	Done		8.1) Recipe with its own name table
+	Done		8.2) Catalog with its own name table
 */
 
 /*****************************************************************************/
@@ -840,4 +850,212 @@ DECLARE_OOP_TEST( recipe_5_11_compare_recipes_equal_complex_recipes )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( recipe_6_1_ingredients_storage_many_ingredients )
+{
+	Recipe r1( "soup", "big soup", "kris" );
+	Recipe r2( "soup", "big soup", "kris" );
+
+	for ( int i = 0; i < 40; ++i )
+		r1.addIngredient( "ingredient" + std::to_string( i ), i + 1 );
+
+	for ( int i = 39; i >= 0; --i )
+		r2.addIngredient( "ingredient" + std::to_string( i ), i + 1 );
+
+	assert( r1.getIngredientsCount() == 40 );
+	for ( int i = 0; i < 40; ++i )
+		assert( r1.getIngredientValue( "ingredient" + std::to_string( i ) ) == i + 1 );
+
+	assert( r1 == r2 );
+
+	int nVisited = 0;
+	for ( auto it = r1.beginIngredients(); it != r1.endIngredients(); ++it, ++nVisited )
+		assert( r1.getIngredientValue( it->first ) == it->second );
+
+	assert( nVisited == 40 );
+
+	ASSERT_THROWS(
+			r1.addIngredient( "ingredient20", 5 );
+		,	Messages::DuplicateIngredient
+	);
+
+	r2.modifyIngredient( "ingredient0", 100 );
+	assert( r1 != r2 );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( recipe_6_2_ingredients_storage_scale_ingredients )
+{
+	Recipe r( "salad", "magic salad", "kris" );
+	r.addIngredient( "i1", 100 );
+	r.addIngredient( "i2", 3 );
+
+	r.scaleIngredients( 2.5 );
+	assert( r.getIngredientValue( "i1" ) == 250 );
+	assert( r.getIngredientValue( "i2" ) == 8 );
+
+	r.scaleIngredients( 0.5 );
+	assert( r.getIngredientValue( "i1" ) == 125 );
+	assert( r.getIngredientValue( "i2" ) == 4 );
+
+	ASSERT_THROWS(
+			r.scaleIngredients( 0.0 )
+		,	Messages::ScaleFactorMustBePositive
+	);
+	ASSERT_THROWS(
+			r.scaleIngredients( -2.0 )
+		,	Messages::ScaleFactorMustBePositive
+	);
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( recipe_6_3_ingredients_storage_scale_ingredients_out_of_range )
+{
+	Recipe r( "salad", "magic salad", "kris" );
+	r.addIngredient( "i1", 100 );
+	r.addIngredient( "i2", 1 );
+
+	ASSERT_THROWS(
+			r.scaleIngredients( 0.1 )
+		,	Messages::ScaledIngredientOutOfRange
+	);
+	ASSERT_THROWS(
+			r.scaleIngredients( 1e8 )
+		,	Messages::ScaledIngredientOutOfRange
+	);
+
+	assert( r.getIngredientValue( "i1" ) == 100 );
+	assert( r.getIngredientValue( "i2" ) == 1 );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( recipe_7_1_recipe_catalog_find_recipes_using_ingredient )
+{
+	RecipeCatalog catalog;
+
+	for ( int i = 0; i < 30; ++i )
+	{
+		Recipe r( "recipe" + std::to_string( i ), "description", "author" );
+		r.addIngredient( "salt", 1 );
+		if ( i % 3 == 0 )
+			r.addIngredient( "pepper", 2 );
+		if ( i % 10 == 7 )
+			r.addIngredient( "saffron", 1 );
+
+		assert( catalog.addRecipe( r ) == i );
+	}
+
+	assert( catalog.getRecipesCount() == 30 );
+	assert( catalog.countRecipesUsing( "salt" ) == 30 );
+	assert( catalog.countRecipesUsing( "pepper" ) == 10 );
+	assert( catalog.findRecipesUsing( "saffron" ) == ( std::vector< int >{ 7, 17, 27 } ) );
+	assert( catalog.findRecipesUsing( "unknown ingredient" ).empty() );
+
+	assert( catalog.getRecipe( 17 ).getName() == "recipe17" );
+	assert( catalog.getRecipe( 17 ).hasIngredient( "saffron" ) );
+
+	ASSERT_THROWS(
+			catalog.getRecipe( 30 )
+		,	Messages::IndexOutOfRange
+	);
+	ASSERT_THROWS(
+			catalog.findRecipesUsing( "" )
+		,	Messages::EmptyIngredientName
+	);
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( recipe_8_1_ingredient_name_tables_recipe_with_own_table )
+{
+	std::weak_ptr< NameTable > weakTable;
+	{
+		auto table = std::make_shared< NameTable >();
+		weakTable = table;
+
+		// Interned in the other order than in the default table
+		table->intern( "own table sugar" );
+		Recipe r( "salad", "magic salad", "kris", table );
+		table.reset();
+
+		r.addIngredient( "own table salt", 5 );
+		r.addIngredient( "own table sugar", 10 );
+		assert( NameTable::getDefault()->find( "own table salt" ) == -1 );
+
+		// Names come from the recipe's own table
+		auto it = r.beginIngredients();
+		assert( it->first == "own table sugar" && it->second == 10 );
+		++it;
+		assert( it->first == "own table salt" && it->second == 5 );
+		++it;
+		assert( it == r.endIngredients() );
+
+		Recipe same( "salad", "magic salad", "kris" );
+		same.addIngredient( "own table salt", 5 );
+		same.addIngredient( "own table sugar", 10 );
+		assert( r == same );
+		assert( same == r );
+
+		same.modifyIngredient( "own table salt", 6 );
+		assert( r != same );
+
+		// A copy shares the table and keeps it alive
+		Recipe copy = r;
+		copy.addIngredient( "own table pepper", 1 );
+		r.modifyIngredient( "own table salt", 7 );
+		assert( copy.getIngredientValue( "own table salt" ) == 5 );
+		assert( !r.hasIngredient( "own table pepper" ) );
+	}
+
+	// Names are freed with the last recipe using the table
+	assert( weakTable.expired() );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( recipe_8_2_ingredient_name_tables_catalog_with_own_table )
+{
+	auto table = std::make_shared< NameTable >();
+	RecipeCatalog catalog( table );
+
+	Recipe own( "soup", "description", "author", table );
+	own.addIngredient( "catalog table water", 1 );
+	assert( catalog.addRecipe( own ) == 0 );
+	assert( catalog.countRecipesUsing( "catalog table water" ) == 1 );
+
+	Recipe other( "soup", "description", "author" );
+	other.addIngredient( "catalog table water", 1 );
+	assert( other == own );
+
+	ASSERT_THROWS(
+			catalog.addRecipe( other )
+		,	Messages::DifferentIngredientNameTables
+	);
+	assert( catalog.getRecipesCount() == 1 );
+
+	RecipeCatalog defaultCatalog;
+	ASSERT_THROWS(
+			defaultCatalog.addRecipe( own )
+		,	Messages::DifferentIngredientNameTables
+	);
+	assert( defaultCatalog.addRecipe( other ) == 0 );
+	assert( defaultCatalog.findRecipesUsing( "catalog table water" ) == std::vector< int >{ 0 } );
+}
+
+
 /*****************************************************************************/
@@ -3,8 +3,247 @@
 #include "addressbook.hpp"
 #include "messages.hpp"
 
+#include <stdexcept>
+
+/*****************************************************************************/
+
+
+AddressBook::AddressBook ( AddressBook const & _book )
+	:	m_phoneTrie( _book.m_phoneTrie )
+{
+	m_phonesByName.reserve( _book.m_phonesByName.size() );
+	m_namesByPhone.reserve( _book.m_namesByPhone.size() );
+
+	// Names come in order, so each one goes to the end of the set
+	for ( std::string const * pName : _book.m_orderedNames )
+	{
+		auto nameIt = m_phonesByName.emplace( * pName, nullptr ).first;
+		auto phoneIt = m_namesByPhone.emplace( * _book.m_phonesByName.find( * pName )->second, & nameIt->first ).first;
+		nameIt->second = & phoneIt->first;
+
+		m_orderedNames.insert( m_orderedNames.end(), & nameIt->first );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+AddressBook & AddressBook::operator = ( AddressBook const & _book )
+{
+	if ( this == & _book )
+		return * this;
+
+	// Moving keeps the nodes of the copy, so its pointers stay valid here
+	* this = AddressBook( _book );
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+void AddressBook::addEntry ( std::string const & _name, std::string const & _phoneNumber )
+{
+	if ( _name.empty() )
+		throw std::logic_error( Messages::EmptyName );
+
+	if ( _phoneNumber.empty() )
+		throw std::logic_error( Messages::EmptyPhoneNumber );
+
+	auto nameIt = m_phonesByName.find( _name );
+	if ( nameIt != m_phonesByName.end() )
+	{
+		if ( * nameIt->second == _phoneNumber )
+			return;
+
+		eraseEntry( nameIt );
+	}
+
+	auto phoneIt = m_namesByPhone.find( _phoneNumber );
+	if ( phoneIt != m_namesByPhone.end() )
+		eraseEntry( m_phonesByName.find( * phoneIt->second ) );
+
+	nameIt = m_phonesByName.emplace( _name, nullptr ).first;
+	phoneIt = m_namesByPhone.emplace( _phoneNumber, & nameIt->first ).first;
+	nameIt->second = & phoneIt->first;
+
+	m_orderedNames.insert( & nameIt->first );
+	m_phoneTrie.insert( _phoneNumber );
+}
+
+
+/*****************************************************************************/
+
+
+void AddressBook::eraseEntry ( Index::const_iterator _nameIt )
+{
+	auto phoneIt = m_namesByPhone.find( * _nameIt->second );
+
+	m_orderedNames.erase( & _nameIt->first );
+	m_phoneTrie.remove( phoneIt->first );
+
+	m_namesByPhone.erase( phoneIt );
+	m_phonesByName.erase( _nameIt );
+}
+
+
+/*****************************************************************************/
+
+
+std::string const & AddressBook::getName ( std::string const & _phoneNumber ) const
+{
+	if ( _phoneNumber.empty() )
+		throw std::logic_error( Messages::EmptyPhoneNumber );
+
+	auto it = m_namesByPhone.find( _phoneNumber );
+	if ( it == m_namesByPhone.end() )
+		throw std::logic_error( Messages::EntryDoesNotExist );
+
+	return * it->second;
+}
+
+
+/*****************************************************************************/
+
+
+std::string const & AddressBook::getPhoneNumber ( std::string const & _name ) const
+{
+	if ( _name.empty() )
+		throw std::logic_error( Messages::EmptyName );
+
+	auto it = m_phonesByName.find( _name );
+	if ( it == m_phonesByName.end() )
+		throw std::logic_error( Messages::EntryDoesNotExist );
+
+	return * it->second;
+}
+
+
+/*****************************************************************************/
+
+
+bool AddressBook::hasEntryByName ( std::string const & _name ) const
+{
+	return m_phonesByName.find( _name ) != m_phonesByName.end();
+}
+
+
+/*****************************************************************************/
+
+
+bool AddressBook::hasEntryByPhoneNumber ( std::string const & _phoneNumber ) const
+{
+	return m_namesByPhone.find( _phoneNumber ) != m_namesByPhone.end();
+}
+
+
 /*****************************************************************************/
 
-// TODO ...
+
+void AddressBook::removeEntry ( std::string const & _name, std::string const & _phoneNumber )
+{
+	if ( _name.empty() )
+		throw std::logic_error( Messages::EmptyName );
+
+	if ( _phoneNumber.empty() )
+		throw std::logic_error( Messages::EmptyPhoneNumber );
+
+	auto it = m_phonesByName.find( _name );
+	if ( it == m_phonesByName.end() || * it->second != _phoneNumber )
+		throw std::logic_error( Messages::EntryDoesNotExist );
+
+	eraseEntry( it );
+}
+
+
+/*****************************************************************************/
+
+
+void AddressBook::removeEntryByName ( std::string const & _name )
+{
+	if ( _name.empty() )
+		throw std::logic_error( Messages::EmptyName );
+
+	auto it = m_phonesByName.find( _name );
+	if ( it == m_phonesByName.end() )
+		throw std::logic_error( Messages::EntryDoesNotExist );
+
+	eraseEntry( it );
+}
+
+
+/*****************************************************************************/
+
+
+void AddressBook::removeEntryByPhoneNumber ( std::string const & _phoneNumber )
+{
+	if ( _phoneNumber.empty() )
+		throw std::logic_error( Messages::EmptyPhoneNumber );
+
+	auto it = m_namesByPhone.find( _phoneNumber );
+	if ( it == m_namesByPhone.end() )
+		throw std::logic_error( Messages::EntryDoesNotExist );
+
+	eraseEntry( m_phonesByName.find( * it->second ) );
+}
+
+
+/*****************************************************************************/
+
+
+int AddressBook::getEntriesCountByName ( std::string const & _prefix ) const
+{
+	// Names with the prefix form one run in the ordered set
+	auto it = m_orderedNames.lower_bound( _prefix );
+	int count = 0;
+	while ( it != m_orderedNames.end() && ( * it )->compare( 0, _prefix.length(), _prefix ) == 0 )
+	{
+		++ count;
+		++ it;
+	}
+
+	return count;
+}
+
+
+/*****************************************************************************/
+
+
+int AddressBook::getEntriesCountByPhoneNumber ( std::string const & _prefix ) const
+{
+	return m_phoneTrie.countWithPrefix( _prefix );
+}
+
+
+/*****************************************************************************/
+
+
+std::vector< std::string > AddressBook::createOrdered () const
+{
+	std::vector< std::string > result;
+	result.reserve( m_orderedNames.size() );
+	for ( std::string const * pName : m_orderedNames )
+		result.push_back( * pName );
+
+	return result;
+}
+
+
+/*****************************************************************************/
+
+
+std::ostream & operator << ( std::ostream & _o, const AddressBook & _book )
+{
+	_book.forEachEntryOrdered(
+		[ & ] ( std::string const & _name, std::string const & _phoneNumber )
+		{
+			_o << _name << " - " << _phoneNumber << '\n';
+		}
+	);
+
+	return _o;
+}
+
 
 /*****************************************************************************/
@@ -5,11 +5,31 @@
 
 /*****************************************************************************/
 
+#include "phone_trie.hpp"
+
 #include <string>
+#include <vector>
+#include <set>
+#include <unordered_map>
 #include <iostream>
 
 /*****************************************************************************/
 
+/*
+	Every name has at most one phone number and vice versa.
+
+	Entries are kept in two hash maps, by name and by phone number. Each string
+	is stored once, as a key of one of the maps, and the value in each map points
+	to the key of the other one; keys of node-based maps stay in place as the
+	maps grow. Names are also kept in order, as pointers in a set, and phone
+	numbers in a compressed trie, both updated with every change. Ordered
+	output walks the set, and counting by prefix walks the set or the trie
+	instead of visiting every entry.
+
+	Since the indexes refer to the book's own strings, a copy builds its maps
+	and its set anew rather than copying the pointers; moving a book keeps the
+	nodes, and so the pointers, as they are.
+*/
 
 class AddressBook
 {
@@ -20,7 +40,51 @@ public:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: public members
+	AddressBook () = default;
+
+	AddressBook ( AddressBook const & _book );
+
+	AddressBook & operator = ( AddressBook const & _book );
+
+	AddressBook ( AddressBook && ) = default;
+
+	AddressBook & operator = ( AddressBook && ) = default;
+
+/*-----------------------------------------------------------------*/
+
+	int getEntriesCount () const;
+
+	// Replaces entries with the same name or the same phone number
+	void addEntry ( std::string const & _name, std::string const & _phoneNumber );
+
+	std::string const & getName ( std::string const & _phoneNumber ) const;
+
+	std::string const & getPhoneNumber ( std::string const & _name ) const;
+
+	bool hasEntryByName ( std::string const & _name ) const;
+
+	bool hasEntryByPhoneNumber ( std::string const & _phoneNumber ) const;
+
+/*-----------------------------------------------------------------*/
+
+	void removeEntry ( std::string const & _name, std::string const & _phoneNumber );
+
+	void removeEntryByName ( std::string const & _name );
+
+	void removeEntryByPhoneNumber ( std::string const & _phoneNumber );
+
+/*-----------------------------------------------------------------*/
+
+	// Entries whose name or phone number starts with the prefix
+	int getEntriesCountByName ( std::string const & _prefix ) const;
+
+	int getEntriesCountByPhoneNumber ( std::string const & _prefix ) const;
+
+	// Names in alphabetical order
+	std::vector< std::string > createOrdered () const;
+
+	template< typename _Callback >
+	void forEachEntryOrdered ( _Callback _callback ) const;
 
 /*-----------------------------------------------------------------*/
 
@@ -28,12 +92,85 @@ private:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: private members
+	struct NameLess
+	{
+		typedef void is_transparent;
+
+		bool operator () ( std::string const * _pName1, std::string const * _pName2 ) const;
+
+		bool operator () ( std::string const * _pName, std::string const & _name ) const;
+
+		bool operator () ( std::string const & _name, std::string const * _pName ) const;
+	};
+
+	typedef std::unordered_map< std::string, std::string const * > Index;
+
+	void eraseEntry ( Index::const_iterator _nameIt );
+
+/*-----------------------------------------------------------------*/
+
+	// Name -> phone number key in m_namesByPhone
+	Index m_phonesByName;
+
+	// Phone number -> name key in m_phonesByName
+	Index m_namesByPhone;
+
+	std::set< std::string const *, NameLess > m_orderedNames;
+
+	PhoneTrie m_phoneTrie;
 
 /*-----------------------------------------------------------------*/
 
 };
 
+
+/*****************************************************************************/
+
+
+inline int AddressBook::getEntriesCount () const
+{
+	return static_cast< int >( m_phonesByName.size() );
+}
+
+
+/*****************************************************************************/
+
+
+inline bool AddressBook::NameLess::operator () ( std::string const * _pName1, std::string const * _pName2 ) const
+{
+	return * _pName1 < * _pName2;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool AddressBook::NameLess::operator () ( std::string const * _pName, std::string const & _name ) const
+{
+	return * _pName < _name;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool AddressBook::NameLess::operator () ( std::string const & _name, std::string const * _pName ) const
+{
+	return _name < * _pName;
+}
+
+
+/*****************************************************************************/
+
+
+template< typename _Callback >
+void AddressBook::forEachEntryOrdered ( _Callback _callback ) const
+{
+	for ( std::string const * pName : m_orderedNames )
+		_callback( * pName, * m_phonesByName.find( * pName )->second );
+}
+
+
 /*****************************************************************************/
 
 std::ostream & operator << ( std::ostream & _o, const AddressBook & _book );
@@ -0,0 +1,209 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "phone_trie.hpp"
+
+#include <algorithm>
+
+/*****************************************************************************/
+
+
+PhoneTrie::PhoneTrie ()
+{
+	clear();
+}
+
+
+/*****************************************************************************/
+
+
+void PhoneTrie::clear ()
+{
+	m_nodes.clear();
+	m_freeNodes.clear();
+	m_nodes.push_back( Node{ std::string(), 0, false, std::vector< int >() } );
+}
+
+
+/*****************************************************************************/
+
+
+int PhoneTrie::allocateNode ( std::string const & _label, int _count, bool _isTerminal )
+{
+	if ( m_freeNodes.empty() )
+	{
+		m_nodes.push_back( Node{ _label, _count, _isTerminal, std::vector< int >() } );
+		return static_cast< int >( m_nodes.size() ) - 1;
+	}
+
+	const int node = m_freeNodes.back();
+	m_freeNodes.pop_back();
+
+	m_nodes[ node ].m_label = _label;
+	m_nodes[ node ].m_count = _count;
+	m_nodes[ node ].m_isTerminal = _isTerminal;
+	return node;
+}
+
+
+/*****************************************************************************/
+
+
+void PhoneTrie::freeNode ( int _node )
+{
+	m_nodes[ _node ].m_label.clear();
+	m_nodes[ _node ].m_children.clear();
+	m_freeNodes.push_back( _node );
+}
+
+
+/*****************************************************************************/
+
+
+int PhoneTrie::findChildPosition ( int _node, char _c ) const
+{
+	std::vector< int > const & children = m_nodes[ _node ].m_children;
+	return static_cast< int >(
+		std::lower_bound(
+				children.begin(), children.end(), _c
+			,	[ this ] ( int _child, char _c ) { return m_nodes[ _child ].m_label[ 0 ] < _c; }
+		) - children.begin()
+	);
+}
+
+
+/*****************************************************************************/
+
+
+void PhoneTrie::insert ( std::string const & _phoneNumber )
+{
+	const int length = static_cast< int >( _phoneNumber.length() );
+
+	int node = 0;
+	int position = 0;
+	++ m_nodes[ node ].m_count;
+
+	while ( position < length )
+	{
+		const int childPosition = findChildPosition( node, _phoneNumber[ position ] );
+		const int nChildren = static_cast< int >( m_nodes[ node ].m_children.size() );
+
+		if ( childPosition == nChildren
+			|| m_nodes[ m_nodes[ node ].m_children[ childPosition ] ].m_label[ 0 ] != _phoneNumber[ position ] )
+		{
+			const int leaf = allocateNode( _phoneNumber.substr( position ), 1, true );
+			m_nodes[ node ].m_children.insert( m_nodes[ node ].m_children.begin() + childPosition, leaf );
+			return;
+		}
+
+		int child = m_nodes[ node ].m_children[ childPosition ];
+
+		const std::string & label = m_nodes[ child ].m_label;
+		const int labelLength = static_cast< int >( label.length() );
+		int common = 1;
+		while ( common < labelLength && position + common < length && label[ common ] == _phoneNumber[ position + common ] )
+			++ common;
+
+		// The number leaves the edge midway, so the edge is split there
+		if ( common < labelLength )
+		{
+			const int middle = allocateNode( label.substr( 0, common ), m_nodes[ child ].m_count, false );
+			m_nodes[ child ].m_label.erase( 0, common );
+			m_nodes[ middle ].m_children.push_back( child );
+			m_nodes[ node ].m_children[ childPosition ] = middle;
+			child = middle;
+		}
+
+		++ m_nodes[ child ].m_count;
+		node = child;
+		position += common;
+	}
+
+	m_nodes[ node ].m_isTerminal = true;
+}
+
+
+/*****************************************************************************/
+
+
+void PhoneTrie::mergeWithChild ( int _node )
+{
+	const int child = m_nodes[ _node ].m_children.front();
+
+	m_nodes[ _node ].m_label += m_nodes[ child ].m_label;
+	m_nodes[ _node ].m_isTerminal = m_nodes[ child ].m_isTerminal;
+	m_nodes[ _node ].m_children.swap( m_nodes[ child ].m_children );
+
+	freeNode( child );
+}
+
+
+/*****************************************************************************/
+
+
+void PhoneTrie::remove ( std::string const & _phoneNumber )
+{
+	const int length = static_cast< int >( _phoneNumber.length() );
+
+	int parent = -1;
+	int node = 0;
+	int position = 0;
+	-- m_nodes[ node ].m_count;
+
+	while ( position < length )
+	{
+		parent = node;
+		node = m_nodes[ node ].m_children[ findChildPosition( node, _phoneNumber[ position ] ) ];
+		-- m_nodes[ node ].m_count;
+		position += static_cast< int >( m_nodes[ node ].m_label.length() );
+	}
+
+	m_nodes[ node ].m_isTerminal = false;
+
+	if ( node == 0 )
+		return;
+
+	if ( m_nodes[ node ].m_count == 0 )
+	{
+		std::vector< int > & siblings = m_nodes[ parent ].m_children;
+		siblings.erase( std::find( siblings.begin(), siblings.end(), node ) );
+		freeNode( node );
+
+		if ( parent != 0 && ! m_nodes[ parent ].m_isTerminal && siblings.size() == 1 )
+			mergeWithChild( parent );
+	}
+
+	else if ( m_nodes[ node ].m_children.size() == 1 )
+		mergeWithChild( node );
+}
+
+
+/*****************************************************************************/
+
+
+int PhoneTrie::countWithPrefix ( std::string const & _prefix ) const
+{
+	const int length = static_cast< int >( _prefix.length() );
+
+	int node = 0;
+	int position = 0;
+	while ( position < length )
+	{
+		const int childPosition = findChildPosition( node, _prefix[ position ] );
+		if ( childPosition == static_cast< int >( m_nodes[ node ].m_children.size() ) )
+			return 0;
+
+		const int child = m_nodes[ node ].m_children[ childPosition ];
+		const std::string & label = m_nodes[ child ].m_label;
+		const int compared = std::min( static_cast< int >( label.length() ), length - position );
+		if ( label.compare( 0, compared, _prefix, position, compared ) != 0 )
+			return 0;
+
+		node = child;
+		position += compared;
+	}
+
+	return m_nodes[ node ].m_count;
+}
+
+
+/*****************************************************************************/
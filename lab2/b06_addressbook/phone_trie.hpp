@@ -0,0 +1,86 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _PHONE_TRIE_HPP_
+#define _PHONE_TRIE_HPP_
+
+/*****************************************************************************/
+
+#include <string>
+#include <vector>
+
+/*****************************************************************************/
+
+/*
+	A compressed trie of phone numbers: every edge carries a run of characters,
+	and no node other than the root has a single child without ending a number
+	itself. Each node knows how many numbers pass through it, so counting the
+	numbers with a given prefix is a walk along the prefix alone.
+
+	Nodes live in one array and refer to their children by index, children
+	ordered by their first character; freed nodes are reused.
+*/
+
+class PhoneTrie
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*-----------------------------------------------------------------*/
+
+	PhoneTrie ();
+
+	// The number must not be stored yet
+	void insert ( std::string const & _phoneNumber );
+
+	// The number must be stored
+	void remove ( std::string const & _phoneNumber );
+
+	int countWithPrefix ( std::string const & _prefix ) const;
+
+	void clear ();
+
+/*-----------------------------------------------------------------*/
+
+private:
+
+/*-----------------------------------------------------------------*/
+
+	struct Node
+	{
+		std::string m_label;
+
+		// Numbers ending at this node or below
+		int m_count;
+
+		bool m_isTerminal;
+
+		std::vector< int > m_children;
+	};
+
+	int allocateNode ( std::string const & _label, int _count, bool _isTerminal );
+
+	void freeNode ( int _node );
+
+	// Position within the children of the child starting with the character,
+	// or where it would be inserted
+	int findChildPosition ( int _node, char _c ) const;
+
+	// Appends the only child of the node to it
+	void mergeWithChild ( int _node );
+
+/*-----------------------------------------------------------------*/
+
+	std::vector< Node > m_nodes;
+
+	std::vector< int > m_freeNodes;
+
+/*-----------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+#endif // _PHONE_TRIE_HPP_
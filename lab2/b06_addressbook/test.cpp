@@ -79,6 +79,9 @@
 	Done		14.1) Add entry with the same name but different phone numbers
 	Done		14.2) Add entry with the same phone number but different names
 	Done		14.3) Add entry with name and phone number from other entries
+	Done		14.4) Prefix counts and order after many changes
+	Done	15) Copies
+	Done		15.1) Copy construction and assignment
 */
 
 /*****************************************************************************/
@@ -855,4 +858,108 @@ DECLARE_OOP_TEST( addressbook_14_3_complex_cases_add_entry_with_name_and_phone_n
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( addressbook_14_4_complex_cases_prefix_counts_and_order_after_many_changes )
+{
+	AddressBook b;
+
+	std::vector< std::pair< std::string, std::string > > entries;
+	for ( int i = 0; i < 500; ++i )
+	{
+		const std::string name = "name" + std::to_string( i * 7919 % 500 );
+		const std::string phone = "0" + std::to_string( i * 37 % 97 ) + std::to_string( i );
+		b.addEntry( name, phone );
+		entries.emplace_back( name, phone );
+	}
+
+	for ( int i = 0; i < 500; i += 3 )
+		if ( b.hasEntryByName( entries[ i ].first ) )
+			b.removeEntryByName( entries[ i ].first );
+
+	for ( int i = 1; i < 500; i += 5 )
+		if ( b.hasEntryByPhoneNumber( entries[ i ].second ) )
+			b.removeEntryByPhoneNumber( entries[ i ].second );
+
+	std::vector< std::string > names;
+	std::vector< std::string > phones;
+	for ( auto const & entry : entries )
+		if ( b.hasEntryByName( entry.first ) && b.getPhoneNumber( entry.first ) == entry.second )
+		{
+			names.push_back( entry.first );
+			phones.push_back( entry.second );
+		}
+
+	assert( b.getEntriesCount() == static_cast< int >( names.size() ) );
+
+	std::sort( names.begin(), names.end() );
+	assert( b.createOrdered() == names );
+
+	const char * prefixes[] = { "", "0", "01", "012", "0123", "05", "0551", "09", "1" };
+	for ( const char * prefix : prefixes )
+	{
+		const std::string p = prefix;
+		const auto expected = std::count_if(
+				phones.begin(), phones.end()
+			,	[ & ] ( std::string const & _phone ) { return _phone.compare( 0, p.length(), p ) == 0; }
+		);
+		assert( b.getEntriesCountByPhoneNumber( p ) == expected );
+	}
+
+	assert( b.getEntriesCountByName( "name1" ) == std::count_if(
+			names.begin(), names.end()
+		,	[] ( std::string const & _name ) { return _name.compare( 0, 5, "name1" ) == 0; }
+	) );
+
+	for ( auto const & phone : phones )
+		b.removeEntryByPhoneNumber( phone );
+
+	assert( b.getEntriesCount() == 0 );
+	assert( b.getEntriesCountByPhoneNumber( "" ) == 0 );
+	assert( b.getEntriesCountByPhoneNumber( "0" ) == 0 );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( addressbook_15_1_copies_copy_construction_and_assignment )
+{
+	AddressBook b;
+	b.addEntry( "name2", "0672" );
+	b.addEntry( "name1", "0671" );
+	b.addEntry( "name3", "0503" );
+
+	AddressBook copy( b );
+	b.removeEntryByName( "name1" );
+	b.addEntry( "name2", "0999" );
+
+	assert( copy.getEntriesCount() == 3 );
+	assert( copy.getPhoneNumber( "name2" ) == "0672" );
+	assert( copy.getName( "0671" ) == "name1" );
+	assert( copy.createOrdered() == std::vector< std::string >( { "name1", "name2", "name3" } ) );
+	assert( copy.getEntriesCountByPhoneNumber( "067" ) == 2 );
+	assert( b.getEntriesCountByPhoneNumber( "067" ) == 0 );
+
+	// The copy has indexes of its own
+	copy.addEntry( "name4", "0671" );
+	assert( ! copy.hasEntryByName( "name1" ) );
+	assert( copy.getEntriesCountByName( "name" ) == 3 );
+	assert( b.getEntriesCount() == 2 );
+
+	b = copy;
+	b = b;
+	copy.removeEntryByName( "name4" );
+	assert( b.getEntriesCount() == 3 );
+	assert( b.getName( "0671" ) == "name4" );
+	assert( b.createOrdered() == std::vector< std::string >( { "name2", "name3", "name4" } ) );
+	assert( b.getEntriesCountByPhoneNumber( "0" ) == 3 );
+
+	AddressBook moved( std::move( b ) );
+	moved.removeEntry( "name3", "0503" );
+	assert( moved.createOrdered() == std::vector< std::string >( { "name2", "name4" } ) );
+}
+
+
 /*****************************************************************************/
@@ -3,8 +3,298 @@
 #include "diary.hpp"
 #include "messages.hpp"
 
+#include <stdexcept>
+#include <algorithm>
+
+/*****************************************************************************/
+
+
+const int Diary::TimeKeyBits;
+
+
+/*****************************************************************************/
+
+
+Diary::Diary ( std::string const & _ownerName )
+	:	m_ownerName( _ownerName )
+{
+	if ( _ownerName.empty() )
+		throw std::logic_error( Messages::EmptyOwnerName );
+}
+
+
+/*****************************************************************************/
+
+
+int Diary::findDay ( Date _date ) const
+{
+	const int dateKey = packDate( _date );
+	auto it = std::lower_bound( m_dayKeys.begin(), m_dayKeys.end(), dateKey );
+	if ( it == m_dayKeys.end() || * it != dateKey )
+		return -1;
+
+	return static_cast< int >( it - m_dayKeys.begin() );
+}
+
+
+/*****************************************************************************/
+
+
+int Diary::findEntry ( Date _date, Time _time ) const
+{
+	const std::int64_t entryKey = packEntryKey( packDate( _date ), packTime( _time ) );
+	auto it = std::lower_bound( m_entryKeys.begin(), m_entryKeys.end(), entryKey );
+	if ( it == m_entryKeys.end() || * it != entryKey )
+		return -1;
+
+	return static_cast< int >( it - m_entryKeys.begin() );
+}
+
+
+/*****************************************************************************/
+
+
+int Diary::getEntriesCount ( Date _date ) const
+{
+	const int day = findDay( _date );
+	return ( day == -1 ) ? 0 : m_dayEnds[ day ] - getDayBegin( day );
+}
+
+
+/*****************************************************************************/
+
+
+bool Diary::hasEntries ( Date _date ) const
+{
+	return getEntriesCount( _date ) > 0;
+}
+
+
 /*****************************************************************************/
 
-// TODO ...
+
+bool Diary::hasEntries ( Time _time ) const
+{
+	const int timeKey = packTime( _time );
+	return std::any_of(
+			m_entryKeys.begin(), m_entryKeys.end()
+		,	[ timeKey ] ( std::int64_t _entryKey ) { return getTimeKey( _entryKey ) == timeKey; }
+	);
+}
+
+
+/*****************************************************************************/
+
+
+bool Diary::hasEntry ( Date _date, Time _time ) const
+{
+	return findEntry( _date, _time ) != -1;
+}
+
+
+/*****************************************************************************/
+
+
+void Diary::addEntry ( Date _date, Time _time, std::string const & _text )
+{
+	if ( _text.empty() )
+		throw std::logic_error( Messages::EmptyEntryText );
+
+	const int dateKey = packDate( _date );
+	const int timeKey = packTime( _time );
+
+	auto dayIt = std::lower_bound( m_dayKeys.begin(), m_dayKeys.end(), dateKey );
+	const int day = static_cast< int >( dayIt - m_dayKeys.begin() );
+
+	if ( dayIt == m_dayKeys.end() || * dayIt != dateKey )
+	{
+		m_dayEnds.insert( m_dayEnds.begin() + day, getDayBegin( day ) );
+		m_dayKeys.insert( dayIt, dateKey );
+	}
+
+	else if ( m_dayEnds[ day ] != getDayBegin( day )
+		&& getTimeKey( m_entryKeys[ m_dayEnds[ day ] - 1 ] ) >= timeKey )
+		throw std::logic_error( Messages::InvalidEntryTime );
+
+	// Entries are mostly added in order, so this is usually the end of the columns
+	const int position = m_dayEnds[ day ];
+	m_entryKeys.insert( m_entryKeys.begin() + position, packEntryKey( dateKey, timeKey ) );
+	m_entryTexts.insert( m_entryTexts.begin() + position, _text );
+
+	const int daysCount = getDaysCount();
+	for ( int i = day; i < daysCount; ++i )
+		++ m_dayEnds[ i ];
+}
+
+
+/*****************************************************************************/
+
+
+std::string const & Diary::getEntry ( Date _date, Time _time ) const
+{
+	const int position = findEntry( _date, _time );
+	if ( position == -1 )
+		throw std::logic_error( Messages::EntryDoesNotExist );
+
+	return m_entryTexts[ position ];
+}
+
+
+/*****************************************************************************/
+
+
+void Diary::modifyEntry ( Date _date, Time _time, std::string const & _text )
+{
+	if ( _text.empty() )
+		throw std::logic_error( Messages::EmptyEntryText );
+
+	const int position = findEntry( _date, _time );
+	if ( position == -1 )
+		throw std::logic_error( Messages::EntryDoesNotExist );
+
+	m_entryTexts[ position ] = _text;
+}
+
+
+/*****************************************************************************/
+
+
+void Diary::eraseEntries ( int _day, int _begin, int _end )
+{
+	m_entryKeys.erase( m_entryKeys.begin() + _begin, m_entryKeys.begin() + _end );
+	m_entryTexts.erase( m_entryTexts.begin() + _begin, m_entryTexts.begin() + _end );
+
+	const int daysCount = getDaysCount();
+	for ( int i = _day; i < daysCount; ++i )
+		m_dayEnds[ i ] -= _end - _begin;
+}
+
+
+/*****************************************************************************/
+
+
+void Diary::removeEntries ( Date _date )
+{
+	const int day = findDay( _date );
+	if ( day == -1 )
+		throw std::logic_error( Messages::EntryDoesNotExist );
+
+	eraseEntries( day, getDayBegin( day ), m_dayEnds[ day ] );
+
+	m_dayKeys.erase( m_dayKeys.begin() + day );
+	m_dayEnds.erase( m_dayEnds.begin() + day );
+}
+
+
+/*****************************************************************************/
+
+
+void Diary::removeEntries ( Time _time )
+{
+	const int timeKey = packTime( _time );
+	const int daysCount = getDaysCount();
+
+	// Compacts the columns in one pass, moving day ends along
+	int kept = 0;
+	int position = 0;
+	for ( int day = 0; day < daysCount; ++day )
+	{
+		for ( ; position < m_dayEnds[ day ]; ++position )
+		{
+			if ( getTimeKey( m_entryKeys[ position ] ) == timeKey )
+				continue;
+
+			if ( kept != position )
+			{
+				m_entryKeys[ kept ] = m_entryKeys[ position ];
+				m_entryTexts[ kept ] = std::move( m_entryTexts[ position ] );
+			}
+
+			++ kept;
+		}
+
+		m_dayEnds[ day ] = kept;
+	}
+
+	m_entryKeys.resize( kept );
+	m_entryTexts.resize( kept );
+}
+
+
+/*****************************************************************************/
+
+
+void Diary::removeEntry ( Date _date, Time _time )
+{
+	const int position = findEntry( _date, _time );
+	if ( position == -1 )
+		throw std::logic_error( Messages::EntryDoesNotExist );
+
+	const int day = static_cast< int >(
+		std::upper_bound( m_dayEnds.begin(), m_dayEnds.end(), position ) - m_dayEnds.begin()
+	);
+
+	eraseEntries( day, position, position + 1 );
+}
+
+
+/*****************************************************************************/
+
+
+Diary::DayEntries Diary::getEntries ( Date _date ) const
+{
+	const int day = findDay( _date );
+	return ( day == -1 ) ? makeRange( 0, 0 ) : makeRange( getDayBegin( day ), m_dayEnds[ day ] );
+}
+
+
+/*****************************************************************************/
+
+
+Diary::EntryRange Diary::getEntries ( Date _from, Date _to ) const
+{
+	if ( _to < _from )
+		throw std::logic_error( Messages::BadDateRange );
+
+	auto first = std::lower_bound(
+			m_entryKeys.begin(), m_entryKeys.end()
+		,	packEntryKey( packDate( _from ), 0 )
+	);
+	auto last = std::lower_bound(
+			first, m_entryKeys.end()
+		,	packEntryKey( packDate( _to ) + 1, 0 )
+	);
+
+	return makeRange(
+			static_cast< int >( first - m_entryKeys.begin() )
+		,	static_cast< int >( last - m_entryKeys.begin() )
+	);
+}
+
+
+/*****************************************************************************/
+
+
+std::ostream & operator << ( std::ostream & _o, const Diary & _diary )
+{
+	_o << "Owner: " << _diary.getOwnerName() << '\n';
+
+	if ( _diary.getDaysCount() == 0 )
+	{
+		_o << "No entries\n";
+		return _o;
+	}
+
+	for ( Diary::Iterator::Value day : _diary )
+	{
+		_o << "Date: " << day.first << '\n';
+
+		for ( Diary::EntryIterator::Value entry : day.second )
+			_o << "    " << entry.first << ": " << entry.second << '\n';
+	}
+
+	return _o;
+}
+
 
 /*****************************************************************************/
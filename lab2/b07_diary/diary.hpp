@@ -9,10 +9,25 @@
 #include "time.hpp"
 
 #include <string>
-#include <map>
+#include <vector>
+#include <utility>
+#include <cstdint>
 
 /*****************************************************************************/
 
+/*
+	Entries of all days are kept in one sequence of two parallel columns:
+	entry keys, which pack the date and the time of an entry into one integer
+	ordered the same way, and entry texts. Days are a separate sorted column of
+	packed dates with the position past the last entry of each day, since a day
+	stays in the diary after its last entry is removed.
+
+	The entries of a day, or of a range of days, are one run of the columns, and
+	iterators are positions in them, so walking entries reads consecutive keys
+	and texts. Short texts are stored inside the string objects of the column
+	and need no separate allocation.
+*/
+
 class Diary
 {
 
@@ -22,11 +37,102 @@ public:
 
 /*-----------------------------------------------------------------*/
 
-	typedef std::map< Time, std::string > DayEntries;
+	class EntryIterator
+	{
+
+	public:
+
+		typedef std::pair< Time, std::string const & > Value;
+
+		struct Arrow
+		{
+			Value m_value;
+
+			Value const * operator -> () const { return & m_value; }
+		};
+
+		EntryIterator ( std::int64_t const * _pKey, std::string const * _pText );
+
+		Value operator * () const;
+
+		Arrow operator -> () const;
 
-	typedef std::map< Date, DayEntries > Entries;
+		Date getDate () const;
 
-	typedef Entries::const_iterator Iterator;
+		EntryIterator & operator ++ ();
+
+		bool operator == ( EntryIterator _other ) const;
+
+		bool operator != ( EntryIterator _other ) const;
+
+	private:
+
+		std::int64_t const * m_pKey;
+
+		std::string const * m_pText;
+	};
+
+/*-----------------------------------------------------------------*/
+
+	class EntryRange
+	{
+
+	public:
+
+		EntryRange ( EntryIterator _begin, EntryIterator _end, int _size );
+
+		EntryIterator begin () const;
+
+		EntryIterator end () const;
+
+		int size () const;
+
+		bool empty () const;
+
+	private:
+
+		EntryIterator m_begin, m_end;
+
+		int m_size;
+	};
+
+	typedef EntryRange DayEntries;
+
+/*-----------------------------------------------------------------*/
+
+	// Visits days in date order, including days without entries
+	class Iterator
+	{
+
+	public:
+
+		typedef std::pair< Date, DayEntries > Value;
+
+		struct Arrow
+		{
+			Value m_value;
+
+			Value const * operator -> () const { return & m_value; }
+		};
+
+		Iterator ( Diary const * _pDiary, int _day );
+
+		Value operator * () const;
+
+		Arrow operator -> () const;
+
+		Iterator & operator ++ ();
+
+		bool operator == ( Iterator _other ) const;
+
+		bool operator != ( Iterator _other ) const;
+
+	private:
+
+		Diary const * m_pDiary;
+
+		int m_day;
+	};
 
 /*-----------------------------------------------------------------*/
 
@@ -34,7 +140,47 @@ public:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: public members
+	Diary ( std::string const & _ownerName );
+
+	std::string const & getOwnerName () const;
+
+	int getDaysCount () const;
+
+	int getEntriesCount ( Date _date ) const;
+
+	bool hasEntries ( Date _date ) const;
+
+	bool hasEntries ( Time _time ) const;
+
+	bool hasEntry ( Date _date, Time _time ) const;
+
+/*-----------------------------------------------------------------*/
+
+	// Entries of a day are added in the order of their time
+	void addEntry ( Date _date, Time _time, std::string const & _text );
+
+	std::string const & getEntry ( Date _date, Time _time ) const;
+
+	void modifyEntry ( Date _date, Time _time, std::string const & _text );
+
+	// Removes the day with all its entries
+	void removeEntries ( Date _date );
+
+	// Removes entries with the time from every day, the days are kept
+	void removeEntries ( Time _time );
+
+	void removeEntry ( Date _date, Time _time );
+
+/*-----------------------------------------------------------------*/
+
+	Iterator begin () const;
+
+	Iterator end () const;
+
+	DayEntries getEntries ( Date _date ) const;
+
+	// Entries of the days from the first date to the second one inclusive
+	EntryRange getEntries ( Date _from, Date _to ) const;
 
 /*-----------------------------------------------------------------*/
 
@@ -42,12 +188,351 @@ private:
 
 /*-----------------------------------------------------------------*/
 
-	// TODO: private members
+	// Snapshots and delta logs store the columns and keys as they are
+	friend class DiaryFile;
+
+	friend class DiaryLog;
+
+	friend class DiaryLogIndex;
+
+	static int packDate ( Date _date );
+
+	static Date unpackDate ( int _dateKey );
+
+	static int packTime ( Time _time );
+
+	static Time unpackTime ( int _timeKey );
+
+	static std::int64_t packEntryKey ( int _dateKey, int _timeKey );
+
+	static int getDateKey ( std::int64_t _entryKey );
+
+	static int getTimeKey ( std::int64_t _entryKey );
+
+/*-----------------------------------------------------------------*/
+
+	// Index of the day, -1 when there is none
+	int findDay ( Date _date ) const;
+
+	// Position of the entry, -1 when there is none
+	int findEntry ( Date _date, Time _time ) const;
+
+	int getDayBegin ( int _day ) const;
+
+	EntryRange makeRange ( int _begin, int _end ) const;
+
+	// Entries in [_begin, _end) must belong to the day
+	void eraseEntries ( int _day, int _begin, int _end );
+
+/*-----------------------------------------------------------------*/
+
+	static const int TimeKeyBits = 17;
+
+	std::string m_ownerName;
+
+	std::vector< int > m_dayKeys;
+
+	// Position past the last entry of each day
+	std::vector< int > m_dayEnds;
+
+	std::vector< std::int64_t > m_entryKeys;
+
+	std::vector< std::string > m_entryTexts;
 
 /*-----------------------------------------------------------------*/
 
 };
 
+
+/*****************************************************************************/
+
+
+inline int Diary::packDate ( Date _date )
+{
+	return ( _date.getYear() * 16 + _date.getMonth() ) * 32 + _date.getDay();
+}
+
+
+/*****************************************************************************/
+
+
+inline Date Diary::unpackDate ( int _dateKey )
+{
+	return Date( _dateKey / 512, _dateKey / 32 % 16, _dateKey % 32 );
+}
+
+
+/*****************************************************************************/
+
+
+inline int Diary::packTime ( Time _time )
+{
+	return ( _time.getHours() * 64 + _time.getMinutes() ) * 64 + _time.getSeconds();
+}
+
+
+/*****************************************************************************/
+
+
+inline Time Diary::unpackTime ( int _timeKey )
+{
+	return Time( _timeKey / 4096, _timeKey / 64 % 64, _timeKey % 64 );
+}
+
+
+/*****************************************************************************/
+
+
+inline std::int64_t Diary::packEntryKey ( int _dateKey, int _timeKey )
+{
+	return ( static_cast< std::int64_t >( _dateKey ) << TimeKeyBits ) | _timeKey;
+}
+
+
+/*****************************************************************************/
+
+
+inline int Diary::getDateKey ( std::int64_t _entryKey )
+{
+	return static_cast< int >( _entryKey >> TimeKeyBits );
+}
+
+
+/*****************************************************************************/
+
+
+inline int Diary::getTimeKey ( std::int64_t _entryKey )
+{
+	return static_cast< int >( _entryKey & ( ( 1 << TimeKeyBits ) - 1 ) );
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::EntryIterator::EntryIterator ( std::int64_t const * _pKey, std::string const * _pText )
+	:	m_pKey( _pKey ), m_pText( _pText )
+{
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::EntryIterator::Value Diary::EntryIterator::operator * () const
+{
+	return Value( unpackTime( getTimeKey( * m_pKey ) ), * m_pText );
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::EntryIterator::Arrow Diary::EntryIterator::operator -> () const
+{
+	return Arrow{ * * this };
+}
+
+
+/*****************************************************************************/
+
+
+inline Date Diary::EntryIterator::getDate () const
+{
+	return unpackDate( getDateKey( * m_pKey ) );
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::EntryIterator & Diary::EntryIterator::operator ++ ()
+{
+	++ m_pKey;
+	++ m_pText;
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Diary::EntryIterator::operator == ( EntryIterator _other ) const
+{
+	return m_pKey == _other.m_pKey;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Diary::EntryIterator::operator != ( EntryIterator _other ) const
+{
+	return !( * this == _other );
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::EntryRange::EntryRange ( EntryIterator _begin, EntryIterator _end, int _size )
+	:	m_begin( _begin ), m_end( _end ), m_size( _size )
+{
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::EntryIterator Diary::EntryRange::begin () const
+{
+	return m_begin;
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::EntryIterator Diary::EntryRange::end () const
+{
+	return m_end;
+}
+
+
+/*****************************************************************************/
+
+
+inline int Diary::EntryRange::size () const
+{
+	return m_size;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Diary::EntryRange::empty () const
+{
+	return m_size == 0;
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::Iterator::Iterator ( Diary const * _pDiary, int _day )
+	:	m_pDiary( _pDiary ), m_day( _day )
+{
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::Iterator::Value Diary::Iterator::operator * () const
+{
+	return Value(
+			unpackDate( m_pDiary->m_dayKeys[ m_day ] )
+		,	m_pDiary->makeRange( m_pDiary->getDayBegin( m_day ), m_pDiary->m_dayEnds[ m_day ] )
+	);
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::Iterator::Arrow Diary::Iterator::operator -> () const
+{
+	return Arrow{ * * this };
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::Iterator & Diary::Iterator::operator ++ ()
+{
+	++ m_day;
+	return * this;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Diary::Iterator::operator == ( Iterator _other ) const
+{
+	return m_pDiary == _other.m_pDiary && m_day == _other.m_day;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool Diary::Iterator::operator != ( Iterator _other ) const
+{
+	return !( * this == _other );
+}
+
+
+/*****************************************************************************/
+
+
+inline std::string const & Diary::getOwnerName () const
+{
+	return m_ownerName;
+}
+
+
+/*****************************************************************************/
+
+
+inline int Diary::getDaysCount () const
+{
+	return static_cast< int >( m_dayKeys.size() );
+}
+
+
+/*****************************************************************************/
+
+
+inline int Diary::getDayBegin ( int _day ) const
+{
+	return ( _day == 0 ) ? 0 : m_dayEnds[ _day - 1 ];
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::EntryRange Diary::makeRange ( int _begin, int _end ) const
+{
+	return EntryRange(
+			EntryIterator( m_entryKeys.data() + _begin, m_entryTexts.data() + _begin )
+		,	EntryIterator( m_entryKeys.data() + _end, m_entryTexts.data() + _end )
+		,	_end - _begin
+	);
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::Iterator Diary::begin () const
+{
+	return Iterator( this, 0 );
+}
+
+
+/*****************************************************************************/
+
+
+inline Diary::Iterator Diary::end () const
+{
+	return Iterator( this, getDaysCount() );
+}
+
+
 /*****************************************************************************/
 
 std::ostream & operator << ( std::ostream & _o, const Diary & _diary );
@@ -0,0 +1,285 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "diary_file.hpp"
+#include "messages.hpp"
+
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+#include <vector>
+#include <cstring>
+#include <climits>
+
+/*****************************************************************************/
+
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+const char Signature[ 8 ] = { 'D', 'I', 'A', 'R', 'Y', 'D', 'A', 'T' };
+
+
+/*-----------------------------------------------------------------*/
+
+template< typename _Value >
+void writeColumn ( std::ostream & _file, std::vector< _Value > const & _column )
+{
+	if ( ! _column.empty() )
+		_file.write(
+				reinterpret_cast< char const * >( _column.data() )
+			,	_column.size() * sizeof( _Value )
+		);
+}
+
+
+/*-----------------------------------------------------------------*/
+
+}
+
+/*****************************************************************************/
+
+
+const std::uint32_t DiaryFile::Version;
+
+
+/*****************************************************************************/
+
+
+void DiaryFile::write ( Diary const & _diary, std::string const & _path, std::uint64_t _generation )
+{
+	Header header;
+	std::memcpy( header.m_signature, Signature, sizeof( Signature ) );
+	header.m_version = Version;
+	header.m_ownerNameLength = static_cast< std::uint32_t >( _diary.m_ownerName.length() );
+	header.m_generation = _generation;
+	header.m_daysCount = _diary.m_dayKeys.size();
+	header.m_entriesCount = _diary.m_entryKeys.size();
+
+	std::vector< std::uint64_t > textEnds;
+	textEnds.reserve( _diary.m_entryTexts.size() );
+
+	std::uint64_t textsSize = 0;
+	for ( std::string const & text : _diary.m_entryTexts )
+	{
+		textsSize += text.length();
+		textEnds.push_back( textsSize );
+	}
+	header.m_textsSize = textsSize;
+
+	const std::string temporaryPath = _path + ".tmp";
+	{
+		std::ofstream file( temporaryPath, std::ios::binary | std::ios::trunc );
+		if ( ! file )
+			throw std::logic_error( Messages::CannotWriteFile );
+
+		const char padding[ 8 ] = {};
+		file.write( reinterpret_cast< char const * >( & header ), sizeof( Header ) );
+		file.write( _diary.m_ownerName.data(), header.m_ownerNameLength );
+		file.write( padding, alignColumn( header.m_ownerNameLength ) - header.m_ownerNameLength );
+
+		writeColumn( file, _diary.m_entryKeys );
+		writeColumn( file, textEnds );
+		// Day columns hold 4-byte numbers, so an odd number of days needs padding
+		const std::uint64_t dayKeysSize = header.m_daysCount * sizeof( int );
+		writeColumn( file, _diary.m_dayKeys );
+		file.write( padding, alignColumn( dayKeysSize ) - dayKeysSize );
+		writeColumn( file, _diary.m_dayEnds );
+		file.write( padding, alignColumn( dayKeysSize ) - dayKeysSize );
+
+		for ( std::string const & text : _diary.m_entryTexts )
+			file.write( text.data(), text.length() );
+
+		file.close();
+		if ( ! file )
+			throw std::logic_error( Messages::CannotWriteFile );
+	}
+
+	replaceFile( temporaryPath, _path );
+}
+
+
+/*****************************************************************************/
+
+
+DiaryFile::DiaryFile ( std::string const & _path )
+	:	m_file( _path )
+{
+	const std::uint64_t size = m_file.getSize();
+	if ( size < sizeof( Header ) )
+		throw std::logic_error( Messages::DamagedDiaryFile );
+
+	std::memcpy( & m_header, m_file.getData(), sizeof( Header ) );
+	if ( std::memcmp( m_header.m_signature, Signature, sizeof( Signature ) ) != 0 || m_header.m_version != Version )
+		throw std::logic_error( Messages::DamagedDiaryFile );
+
+	// Counts are checked against the size before they are multiplied
+	if ( m_header.m_daysCount > INT_MAX || m_header.m_entriesCount > INT_MAX || m_header.m_textsSize > size )
+		throw std::logic_error( Messages::DamagedDiaryFile );
+
+	const std::uint64_t ownerNameSize = alignColumn( m_header.m_ownerNameLength );
+	const std::uint64_t entryKeysSize = m_header.m_entriesCount * sizeof( std::int64_t );
+	const std::uint64_t textEndsSize = m_header.m_entriesCount * sizeof( std::uint64_t );
+	const std::uint64_t dayKeysSize = alignColumn( m_header.m_daysCount * sizeof( int ) );
+
+	if ( sizeof( Header ) + ownerNameSize + entryKeysSize + textEndsSize + 2 * dayKeysSize + m_header.m_textsSize != size )
+		throw std::logic_error( Messages::DamagedDiaryFile );
+
+	char const * pData = m_file.getData() + sizeof( Header );
+
+	m_pOwnerName = pData;
+	pData += ownerNameSize;
+
+	m_pEntryKeys = reinterpret_cast< std::int64_t const * >( pData );
+	pData += entryKeysSize;
+
+	m_pTextEnds = reinterpret_cast< std::uint64_t const * >( pData );
+	pData += textEndsSize;
+
+	m_pDayKeys = reinterpret_cast< int const * >( pData );
+	pData += dayKeysSize;
+
+	m_pDayEnds = reinterpret_cast< int const * >( pData );
+	pData += dayKeysSize;
+
+	m_pTexts = pData;
+
+	const int daysCount = getDaysCount();
+	if ( daysCount > 0 && m_pDayEnds[ daysCount - 1 ] != getEntriesCount() )
+		throw std::logic_error( Messages::DamagedDiaryFile );
+}
+
+
+/*****************************************************************************/
+
+
+int DiaryFile::findEntry ( Date _date, Time _time ) const
+{
+	const std::int64_t entryKey = Diary::packEntryKey( Diary::packDate( _date ), Diary::packTime( _time ) );
+
+	std::int64_t const * pEntryKeysEnd = m_pEntryKeys + getEntriesCount();
+	std::int64_t const * pEntryKey = std::lower_bound( m_pEntryKeys, pEntryKeysEnd, entryKey );
+	if ( pEntryKey == pEntryKeysEnd || * pEntryKey != entryKey )
+		return -1;
+
+	return static_cast< int >( pEntryKey - m_pEntryKeys );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryFile::getTextBounds ( int _position, std::uint64_t & _begin, std::uint64_t & _end ) const
+{
+	_begin = ( _position == 0 ) ? 0 : m_pTextEnds[ _position - 1 ];
+	_end = m_pTextEnds[ _position ];
+
+	if ( _begin > _end || _end > m_header.m_textsSize )
+		throw std::logic_error( Messages::DamagedDiaryFile );
+}
+
+
+/*****************************************************************************/
+
+
+bool DiaryFile::findDayEntries ( int _dateKey, int & _begin, int & _end ) const
+{
+	int const * pDayKeysEnd = m_pDayKeys + getDaysCount();
+	int const * pDayKey = std::lower_bound( m_pDayKeys, pDayKeysEnd, _dateKey );
+	if ( pDayKey == pDayKeysEnd || * pDayKey != _dateKey )
+		return false;
+
+	const int day = static_cast< int >( pDayKey - m_pDayKeys );
+	_begin = ( day == 0 ) ? 0 : m_pDayEnds[ day - 1 ];
+	_end = m_pDayEnds[ day ];
+
+	if ( _begin < 0 || _begin > _end || _end > getEntriesCount() )
+		throw std::logic_error( Messages::DamagedDiaryFile );
+
+	return true;
+}
+
+
+/*****************************************************************************/
+
+
+int DiaryFile::getEntriesCount ( Date _date ) const
+{
+	int begin, end;
+	return findDayEntries( Diary::packDate( _date ), begin, end ) ? end - begin : 0;
+}
+
+
+/*****************************************************************************/
+
+
+bool DiaryFile::hasEntry ( Date _date, Time _time ) const
+{
+	return findEntry( _date, _time ) != -1;
+}
+
+
+/*****************************************************************************/
+
+
+std::string DiaryFile::getEntry ( Date _date, Time _time ) const
+{
+	const int position = findEntry( _date, _time );
+	if ( position == -1 )
+		throw std::logic_error( Messages::EntryDoesNotExist );
+
+	std::uint64_t begin, end;
+	getTextBounds( position, begin, end );
+
+	return std::string( m_pTexts + begin, m_pTexts + end );
+}
+
+
+/*****************************************************************************/
+
+
+Diary DiaryFile::load () const
+{
+	const int daysCount = getDaysCount();
+	const int entriesCount = getEntriesCount();
+
+	// Lookups and iterators of the diary rely on sorted keys and on day ends
+	// that agree with them, so damaged columns are not loaded. Mapped lookups
+	// do not check this, to keep opening a snapshot independent of its size
+	int dayBegin = 0;
+	for ( int day = 0; day < daysCount; ++day )
+	{
+		const int dayEnd = m_pDayEnds[ day ];
+		if ( dayEnd < dayBegin || dayEnd > entriesCount || ( day > 0 && m_pDayKeys[ day ] <= m_pDayKeys[ day - 1 ] ) )
+			throw std::logic_error( Messages::DamagedDiaryFile );
+
+		for ( int i = dayBegin; i < dayEnd; ++i )
+			if ( Diary::getDateKey( m_pEntryKeys[ i ] ) != m_pDayKeys[ day ]
+				|| ( i > dayBegin && m_pEntryKeys[ i ] <= m_pEntryKeys[ i - 1 ] ) )
+				throw std::logic_error( Messages::DamagedDiaryFile );
+
+		dayBegin = dayEnd;
+	}
+
+	if ( dayBegin != entriesCount )
+		throw std::logic_error( Messages::DamagedDiaryFile );
+
+	Diary diary( getOwnerName() );
+
+	diary.m_dayKeys.assign( m_pDayKeys, m_pDayKeys + daysCount );
+	diary.m_dayEnds.assign( m_pDayEnds, m_pDayEnds + daysCount );
+	diary.m_entryKeys.assign( m_pEntryKeys, m_pEntryKeys + entriesCount );
+
+	diary.m_entryTexts.reserve( entriesCount );
+	for ( int i = 0; i < entriesCount; ++i )
+	{
+		std::uint64_t begin, end;
+		getTextBounds( i, begin, end );
+		diary.m_entryTexts.emplace_back( m_pTexts + begin, m_pTexts + end );
+	}
+
+	return diary;
+}
+
+
+/*****************************************************************************/
@@ -0,0 +1,177 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _DIARY_FILE_HPP_
+#define _DIARY_FILE_HPP_
+
+/*****************************************************************************/
+
+#include "diary.hpp"
+#include "mapped_file.hpp"
+
+#include <string>
+#include <cstdint>
+
+/*****************************************************************************/
+
+/*
+	A snapshot of a diary on disk, in the same columns the diary keeps in
+	memory: after a header and the owner name come entry keys, the offsets past
+	every entry text, day keys, day ends, and finally all texts one after another.
+	Numbers are stored in the byte order of the machine, and every column
+	starts at a multiple of 8 bytes.
+
+	The file is mapped rather than read, so opening it takes the same short
+	time for any size, and lookups touch only the pages they need. Loading
+	copies the columns into a diary for changing it.
+
+	Every snapshot has a generation number, which tells the delta logs written
+	on top of it apart from older ones.
+*/
+
+class DiaryFile
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*-----------------------------------------------------------------*/
+
+	// Writes to a temporary file first, so the snapshot at the path is replaced whole
+	static void write ( Diary const & _diary, std::string const & _path, std::uint64_t _generation = 0 );
+
+	explicit DiaryFile ( std::string const & _path );
+
+	DiaryFile ( DiaryFile const & ) = delete;
+
+	DiaryFile & operator = ( DiaryFile const & ) = delete;
+
+/*-----------------------------------------------------------------*/
+
+	std::uint64_t getGeneration () const;
+
+	std::string getOwnerName () const;
+
+	int getDaysCount () const;
+
+	int getEntriesCount () const;
+
+	int getEntriesCount ( Date _date ) const;
+
+	bool hasEntry ( Date _date, Time _time ) const;
+
+	std::string getEntry ( Date _date, Time _time ) const;
+
+	Diary load () const;
+
+/*-----------------------------------------------------------------*/
+
+private:
+
+/*-----------------------------------------------------------------*/
+
+	// Looks entries of a snapshot up by their keys
+	friend class DiaryLogIndex;
+
+	struct Header
+	{
+		char m_signature[ 8 ];
+
+		std::uint32_t m_version;
+
+		std::uint32_t m_ownerNameLength;
+
+		std::uint64_t m_generation;
+
+		std::uint64_t m_daysCount;
+
+		std::uint64_t m_entriesCount;
+
+		std::uint64_t m_textsSize;
+	};
+
+	static const std::uint32_t Version = 1;
+
+	static std::uint64_t alignColumn ( std::uint64_t _size );
+
+	// Position of the entry, -1 when there is none
+	int findEntry ( Date _date, Time _time ) const;
+
+	// Positions of the entries of the day, false when there is no such day;
+	// throws when the day ends are damaged
+	bool findDayEntries ( int _dateKey, int & _begin, int & _end ) const;
+
+	// Range of the text in m_pTexts, throws when the offsets are damaged
+	void getTextBounds ( int _position, std::uint64_t & _begin, std::uint64_t & _end ) const;
+
+/*-----------------------------------------------------------------*/
+
+	MappedFile m_file;
+
+	Header m_header;
+
+	char const * m_pOwnerName;
+
+	std::int64_t const * m_pEntryKeys;
+
+	std::uint64_t const * m_pTextEnds;
+
+	int const * m_pDayKeys;
+
+	int const * m_pDayEnds;
+
+	char const * m_pTexts;
+
+/*-----------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline std::uint64_t DiaryFile::getGeneration () const
+{
+	return m_header.m_generation;
+}
+
+
+/*****************************************************************************/
+
+
+inline std::string DiaryFile::getOwnerName () const
+{
+	return std::string( m_pOwnerName, m_header.m_ownerNameLength );
+}
+
+
+/*****************************************************************************/
+
+
+inline int DiaryFile::getDaysCount () const
+{
+	return static_cast< int >( m_header.m_daysCount );
+}
+
+
+/*****************************************************************************/
+
+
+inline int DiaryFile::getEntriesCount () const
+{
+	return static_cast< int >( m_header.m_entriesCount );
+}
+
+
+/*****************************************************************************/
+
+
+inline std::uint64_t DiaryFile::alignColumn ( std::uint64_t _size )
+{
+	return ( _size + 7 ) & ~ static_cast< std::uint64_t >( 7 );
+}
+
+
+/*****************************************************************************/
+
+#endif // _DIARY_FILE_HPP_
@@ -0,0 +1,399 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "diary_log.hpp"
+#include "mapped_file.hpp"
+#include "messages.hpp"
+
+#include <stdexcept>
+#include <fstream>
+#include <cstring>
+
+/*****************************************************************************/
+
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+const char Signature[ 8 ] = { 'D', 'I', 'A', 'R', 'Y', 'L', 'O', 'G' };
+
+const std::size_t HeaderSize = sizeof( Signature ) + sizeof( std::uint64_t );
+
+// Kind, date key, time key and text length
+const std::size_t RecordHeaderSize = 1 + 3 * sizeof( std::int32_t );
+
+
+/*-----------------------------------------------------------------*/
+
+template< typename _Value >
+void appendValue ( std::string & _buffer, _Value _value )
+{
+	_buffer.append( reinterpret_cast< char const * >( & _value ), sizeof( _Value ) );
+}
+
+
+/*-----------------------------------------------------------------*/
+
+template< typename _Value >
+_Value readValue ( char const * _pData )
+{
+	_Value value;
+	std::memcpy( & value, _pData, sizeof( _Value ) );
+	return value;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+// Calls back with every whole record, returns the length of the log up to
+// the first record that was cut short
+template< typename _Callback >
+std::uint64_t forEachRecord ( MappedFile const & _file, _Callback _callback )
+{
+	char const * pData = _file.getData();
+	const std::size_t size = _file.getSize();
+	if ( size < HeaderSize || std::memcmp( pData, Signature, sizeof( Signature ) ) != 0 )
+		throw std::logic_error( Messages::DamagedDiaryFile );
+
+	std::size_t position = HeaderSize;
+	while ( size - position >= RecordHeaderSize )
+	{
+		char const * pRecord = pData + position;
+		const std::uint32_t textLength = readValue< std::uint32_t >( pRecord + 1 + 2 * sizeof( std::int32_t ) );
+		if ( textLength > size - position - RecordHeaderSize )
+			break;
+
+		_callback(
+				static_cast< unsigned char >( pRecord[ 0 ] )
+			,	readValue< std::int32_t >( pRecord + 1 )
+			,	readValue< std::int32_t >( pRecord + 1 + sizeof( std::int32_t ) )
+			,	pRecord + RecordHeaderSize
+			,	textLength
+		);
+
+		position += RecordHeaderSize + textLength;
+	}
+
+	return position;
+}
+
+
+/*-----------------------------------------------------------------*/
+
+}
+
+/*****************************************************************************/
+
+
+void DiaryLog::create ( std::string const & _path, std::uint64_t _generation )
+{
+	std::string header( Signature, sizeof( Signature ) );
+	appendValue( header, _generation );
+
+	const std::string temporaryPath = _path + ".tmp";
+	{
+		std::ofstream file( temporaryPath, std::ios::binary | std::ios::trunc );
+		file.write( header.data(), header.length() );
+		file.close();
+		if ( ! file )
+			throw std::logic_error( Messages::CannotWriteFile );
+	}
+
+	replaceFile( temporaryPath, _path );
+}
+
+
+/*****************************************************************************/
+
+
+bool DiaryLog::readGeneration ( std::string const & _path, std::uint64_t & _generation )
+{
+	std::ifstream file( _path, std::ios::binary );
+	if ( ! file )
+		return false;
+
+	char header[ HeaderSize ];
+	if ( ! file.read( header, HeaderSize ) || std::memcmp( header, Signature, sizeof( Signature ) ) != 0 )
+		throw std::logic_error( Messages::DamagedDiaryFile );
+
+	_generation = readValue< std::uint64_t >( header + sizeof( Signature ) );
+	return true;
+}
+
+
+/*****************************************************************************/
+
+
+std::uint64_t DiaryLog::replay ( std::string const & _path, Diary & _diary )
+{
+	MappedFile file( _path );
+
+	return forEachRecord(
+			file
+		,	[ & ] ( int _kind, int _dateKey, int _timeKey, char const * _pText, std::uint32_t _textLength )
+			{
+				apply( _diary, _kind, _dateKey, _timeKey, std::string( _pText, _textLength ) );
+			}
+	);
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryLog::truncate ( std::string const & _path, std::uint64_t _length )
+{
+	const std::string temporaryPath = _path + ".tmp";
+	{
+		MappedFile file( _path );
+		if ( file.getSize() <= _length )
+			return;
+
+		std::ofstream truncated( temporaryPath, std::ios::binary | std::ios::trunc );
+		truncated.write( file.getData(), _length );
+		truncated.close();
+		if ( ! truncated )
+			throw std::logic_error( Messages::CannotWriteFile );
+	}
+
+	replaceFile( temporaryPath, _path );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryLog::apply ( Diary & _diary, int _kind, int _dateKey, int _timeKey, std::string const & _text )
+{
+	switch ( _kind )
+	{
+		case AddEntry:
+			_diary.addEntry( Diary::unpackDate( _dateKey ), Diary::unpackTime( _timeKey ), _text );
+			break;
+
+		case ModifyEntry:
+			_diary.modifyEntry( Diary::unpackDate( _dateKey ), Diary::unpackTime( _timeKey ), _text );
+			break;
+
+		case RemoveDay:
+			_diary.removeEntries( Diary::unpackDate( _dateKey ) );
+			break;
+
+		case RemoveTime:
+			_diary.removeEntries( Diary::unpackTime( _timeKey ) );
+			break;
+
+		case RemoveEntry:
+			_diary.removeEntry( Diary::unpackDate( _dateKey ), Diary::unpackTime( _timeKey ) );
+			break;
+
+		default:
+			throw std::logic_error( Messages::DamagedDiaryFile );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+DiaryLog::DiaryLog ( std::string const & _path )
+	:	m_file( _path )
+{
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryLog::append ( RecordKind _kind, int _dateKey, int _timeKey, std::string const & _text )
+{
+	std::string record;
+	record.reserve( RecordHeaderSize + _text.length() );
+	record.push_back( static_cast< char >( _kind ) );
+	appendValue< std::int32_t >( record, _dateKey );
+	appendValue< std::int32_t >( record, _timeKey );
+	appendValue< std::uint32_t >( record, static_cast< std::uint32_t >( _text.length() ) );
+	record += _text;
+
+	m_file.append( record.data(), record.length() );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryLog::addEntry ( Date _date, Time _time, std::string const & _text )
+{
+	append( AddEntry, Diary::packDate( _date ), Diary::packTime( _time ), _text );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryLog::modifyEntry ( Date _date, Time _time, std::string const & _text )
+{
+	append( ModifyEntry, Diary::packDate( _date ), Diary::packTime( _time ), _text );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryLog::removeEntries ( Date _date )
+{
+	append( RemoveDay, Diary::packDate( _date ), 0 );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryLog::removeEntries ( Time _time )
+{
+	append( RemoveTime, 0, Diary::packTime( _time ) );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryLog::removeEntry ( Date _date, Time _time )
+{
+	append( RemoveEntry, Diary::packDate( _date ), Diary::packTime( _time ) );
+}
+
+
+/*****************************************************************************/
+
+
+DiaryLogIndex::DiaryLogIndex ( std::string const & _path )
+{
+	MappedFile file( _path );
+
+	m_length = forEachRecord(
+			file
+		,	[ & ] ( int _kind, int _dateKey, int _timeKey, char const * _pText, std::uint32_t _textLength )
+			{
+				apply( _kind, _dateKey, _timeKey, std::string( _pText, _textLength ) );
+			}
+	);
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryLogIndex::apply ( int _kind, int _dateKey, int _timeKey, std::string const & _text )
+{
+	switch ( _kind )
+	{
+		case DiaryLog::AddEntry:
+		case DiaryLog::ModifyEntry:
+			if ( _text.empty() )
+				throw std::logic_error( Messages::DamagedDiaryFile );
+
+			m_entries[ Diary::packEntryKey( _dateKey, _timeKey ) ] = _text;
+			break;
+
+		case DiaryLog::RemoveDay:
+			m_entries.erase(
+					m_entries.lower_bound( Diary::packEntryKey( _dateKey, 0 ) )
+				,	m_entries.lower_bound( Diary::packEntryKey( _dateKey + 1, 0 ) )
+			);
+			m_removedDays.insert( _dateKey );
+			break;
+
+		case DiaryLog::RemoveTime:
+			for ( auto it = m_entries.begin(); it != m_entries.end(); )
+				if ( Diary::getTimeKey( it->first ) == _timeKey )
+					it = m_entries.erase( it );
+				else
+					++ it;
+
+			m_removedTimes.insert( _timeKey );
+			break;
+
+		case DiaryLog::RemoveEntry:
+			m_entries[ Diary::packEntryKey( _dateKey, _timeKey ) ].clear();
+			break;
+
+		default:
+			throw std::logic_error( Messages::DamagedDiaryFile );
+	}
+}
+
+
+/*****************************************************************************/
+
+
+bool DiaryLogIndex::isHidden ( int _dateKey, int _timeKey ) const
+{
+	return m_removedDays.count( _dateKey ) || m_removedTimes.count( _timeKey );
+}
+
+
+/*****************************************************************************/
+
+
+bool DiaryLogIndex::hasEntry ( DiaryFile const & _snapshot, Date _date, Time _time ) const
+{
+	const int dateKey = Diary::packDate( _date );
+	const int timeKey = Diary::packTime( _time );
+
+	auto it = m_entries.find( Diary::packEntryKey( dateKey, timeKey ) );
+	if ( it != m_entries.end() )
+		return ! it->second.empty();
+
+	return ! isHidden( dateKey, timeKey ) && _snapshot.hasEntry( _date, _time );
+}
+
+
+/*****************************************************************************/
+
+
+std::string DiaryLogIndex::getEntry ( DiaryFile const & _snapshot, Date _date, Time _time ) const
+{
+	const int dateKey = Diary::packDate( _date );
+	const int timeKey = Diary::packTime( _time );
+
+	auto it = m_entries.find( Diary::packEntryKey( dateKey, timeKey ) );
+	if ( it != m_entries.end() ? it->second.empty() : isHidden( dateKey, timeKey ) )
+		throw std::logic_error( Messages::EntryDoesNotExist );
+
+	return ( it != m_entries.end() ) ? it->second : _snapshot.getEntry( _date, _time );
+}
+
+
+/*****************************************************************************/
+
+
+int DiaryLogIndex::getEntriesCount ( DiaryFile const & _snapshot, Date _date ) const
+{
+	const int dateKey = Diary::packDate( _date );
+	if ( isEmpty() )
+		return _snapshot.getEntriesCount( _date );
+
+	int entriesCount = 0;
+
+	// Entries of the snapshot the log neither hides nor has
+	int begin, end;
+	if ( ! m_removedDays.count( dateKey ) && _snapshot.findDayEntries( dateKey, begin, end ) )
+		for ( int i = begin; i < end; ++i )
+		{
+			const std::int64_t entryKey = _snapshot.m_pEntryKeys[ i ];
+			if ( ! m_removedTimes.count( Diary::getTimeKey( entryKey ) ) && ! m_entries.count( entryKey ) )
+				++ entriesCount;
+		}
+
+	auto it = m_entries.lower_bound( Diary::packEntryKey( dateKey, 0 ) );
+	auto itEnd = m_entries.lower_bound( Diary::packEntryKey( dateKey + 1, 0 ) );
+	for ( ; it != itEnd; ++it )
+		if ( ! it->second.empty() )
+			++ entriesCount;
+
+	return entriesCount;
+}
+
+
+/*****************************************************************************/
@@ -0,0 +1,183 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _DIARY_LOG_HPP_
+#define _DIARY_LOG_HPP_
+
+/*****************************************************************************/
+
+#include "diary.hpp"
+#include "diary_file.hpp"
+#include "mapped_file.hpp"
+
+#include <string>
+#include <map>
+#include <set>
+#include <cstdint>
+
+/*****************************************************************************/
+
+/*
+	An append-only log of changes made to a diary on top of a snapshot. The
+	log starts with the generation of that snapshot, followed by one record per
+	change: its kind, the packed date and time, and the text if any.
+
+	Every record is appended with one call and reaches the disk before the
+	change returns, so a crash can only cut the last record short; replaying
+	stops before such a record.
+*/
+
+class DiaryLog
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*-----------------------------------------------------------------*/
+
+	// Replaces the log at the path with an empty one
+	static void create ( std::string const & _path, std::uint64_t _generation );
+
+	// False when there is no log at the path
+	static bool readGeneration ( std::string const & _path, std::uint64_t & _generation );
+
+	// Applies the changes to the diary, returns the length of the log
+	// up to the first record that was cut short
+	static std::uint64_t replay ( std::string const & _path, Diary & _diary );
+
+	// Drops everything past the length, does nothing when the log is not longer
+	static void truncate ( std::string const & _path, std::uint64_t _length );
+
+/*-----------------------------------------------------------------*/
+
+	// Opens the log for appending
+	explicit DiaryLog ( std::string const & _path );
+
+	DiaryLog ( DiaryLog const & ) = delete;
+
+	DiaryLog & operator = ( DiaryLog const & ) = delete;
+
+/*-----------------------------------------------------------------*/
+
+	void addEntry ( Date _date, Time _time, std::string const & _text );
+
+	void modifyEntry ( Date _date, Time _time, std::string const & _text );
+
+	void removeEntries ( Date _date );
+
+	void removeEntries ( Time _time );
+
+	void removeEntry ( Date _date, Time _time );
+
+/*-----------------------------------------------------------------*/
+
+private:
+
+/*-----------------------------------------------------------------*/
+
+	friend class DiaryLogIndex;
+
+	enum RecordKind { AddEntry, ModifyEntry, RemoveDay, RemoveTime, RemoveEntry };
+
+	void append ( RecordKind _kind, int _dateKey, int _timeKey, std::string const & _text = std::string() );
+
+	static void apply ( Diary & _diary, int _kind, int _dateKey, int _timeKey, std::string const & _text );
+
+/*-----------------------------------------------------------------*/
+
+	AppendFile m_file;
+
+/*-----------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+/*
+	The changes of a delta log indexed by entry, for looking entries up on top
+	of the snapshot the log applies to without loading the diary.
+
+	Entries the log adds, changes or removes are kept by entry key. Removing a
+	day or a time hides the entries of the snapshot on that day or at that
+	time, and drops those the log has for it; entries added later are kept by
+	key again. An entry of the snapshot is there unless the log has its key or
+	hides it.
+*/
+
+class DiaryLogIndex
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*-----------------------------------------------------------------*/
+
+	// Indexes the whole records of the log at the path
+	explicit DiaryLogIndex ( std::string const & _path );
+
+	DiaryLogIndex ( DiaryLogIndex const & ) = delete;
+
+	DiaryLogIndex & operator = ( DiaryLogIndex const & ) = delete;
+
+/*-----------------------------------------------------------------*/
+
+	// Length of the log up to the first record that was cut short
+	std::uint64_t getLength () const;
+
+	bool isEmpty () const;
+
+	bool hasEntry ( DiaryFile const & _snapshot, Date _date, Time _time ) const;
+
+	std::string getEntry ( DiaryFile const & _snapshot, Date _date, Time _time ) const;
+
+	int getEntriesCount ( DiaryFile const & _snapshot, Date _date ) const;
+
+/*-----------------------------------------------------------------*/
+
+private:
+
+/*-----------------------------------------------------------------*/
+
+	void apply ( int _kind, int _dateKey, int _timeKey, std::string const & _text );
+
+	bool isHidden ( int _dateKey, int _timeKey ) const;
+
+/*-----------------------------------------------------------------*/
+
+	std::uint64_t m_length;
+
+	// Texts of entries are never empty, so an empty one marks a removed entry
+	std::map< std::int64_t, std::string > m_entries;
+
+	std::set< int > m_removedDays;
+
+	std::set< int > m_removedTimes;
+
+/*-----------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline std::uint64_t DiaryLogIndex::getLength () const
+{
+	return m_length;
+}
+
+
+/*****************************************************************************/
+
+
+inline bool DiaryLogIndex::isEmpty () const
+{
+	return m_entries.empty() && m_removedDays.empty() && m_removedTimes.empty();
+}
+
+
+/*****************************************************************************/
+
+#endif // _DIARY_LOG_HPP_
@@ -0,0 +1,349 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "diary_store.hpp"
+#include "mapped_file.hpp"
+#include "messages.hpp"
+
+#include <stdexcept>
+#include <chrono>
+#include <cstdio>
+
+/*****************************************************************************/
+
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+std::string getLogPath ( std::string const & _path )
+{
+	return _path + ".log";
+}
+
+
+/*-----------------------------------------------------------------*/
+
+// The log being folded into the next snapshot
+std::string getOldLogPath ( std::string const & _path )
+{
+	return _path + ".log.old";
+}
+
+
+/*-----------------------------------------------------------------*/
+
+}
+
+/*****************************************************************************/
+
+
+DiaryStore::DiaryStore ( std::string const & _path )
+	:	m_path( _path )
+	,	m_pSnapshot( new DiaryFile( _path ) )
+{
+	m_generation = m_pSnapshot->getGeneration();
+
+	const std::string logPath = getLogPath( m_path );
+	const std::string oldLogPath = getOldLogPath( m_path );
+
+	std::uint64_t logGeneration;
+	bool hasUnfoldedLog = false;
+
+	// The old log is left by an interrupted compaction, and is already folded
+	// if the snapshot was replaced
+	if ( DiaryLog::readGeneration( oldLogPath, logGeneration ) )
+	{
+		if ( logGeneration == m_generation )
+		{
+			hasUnfoldedLog = true;
+			++ m_generation;
+		}
+		else
+			std::remove( oldLogPath.c_str() );
+	}
+
+	if ( DiaryLog::readGeneration( logPath, logGeneration ) )
+	{
+		if ( logGeneration != m_generation )
+			throw std::logic_error( Messages::DamagedDiaryFile );
+	}
+	else
+		DiaryLog::create( logPath, m_generation );
+
+	// Appending after a record cut short would make the log unreadable
+	std::unique_ptr< DiaryLogIndex > pLogIndex( new DiaryLogIndex( logPath ) );
+	DiaryLog::truncate( logPath, pLogIndex->getLength() );
+
+	m_pLog.reset( new DiaryLog( logPath ) );
+
+	if ( hasUnfoldedLog )
+	{
+		m_pSnapshot.reset();
+		m_compaction = std::async( std::launch::async, & DiaryStore::compact, m_path, m_generation );
+	}
+	else
+		m_pLogIndex = std::move( pLogIndex );
+}
+
+
+/*****************************************************************************/
+
+
+DiaryStore::~DiaryStore ()
+{
+	if ( m_compaction.valid() )
+		m_compaction.wait();
+}
+
+
+/*****************************************************************************/
+
+
+Diary & DiaryStore::loadDiary () const
+{
+	if ( m_pDiary )
+		return * m_pDiary;
+
+	// A running compaction replaces the snapshot and then removes the old
+	// log, so the two are read after it ends
+	if ( m_compaction.valid() )
+		m_compaction.wait();
+
+	const DiaryFile snapshot( m_path );
+	std::unique_ptr< Diary > pDiary( new Diary( snapshot.load() ) );
+
+	// The old log is still there when its compaction failed
+	if ( snapshot.getGeneration() + 1 == m_generation )
+		DiaryLog::replay( getOldLogPath( m_path ), * pDiary );
+
+	else if ( snapshot.getGeneration() != m_generation )
+		throw std::logic_error( Messages::DamagedDiaryFile );
+
+	DiaryLog::replay( getLogPath( m_path ), * pDiary );
+
+	m_pSnapshot.reset();
+	m_pLogIndex.reset();
+	m_pDiary = std::move( pDiary );
+	return * m_pDiary;
+}
+
+
+/*****************************************************************************/
+
+
+bool DiaryStore::hasEntry ( Date _date, Time _time ) const
+{
+	return m_pSnapshot ? m_pLogIndex->hasEntry( * m_pSnapshot, _date, _time ) : loadDiary().hasEntry( _date, _time );
+}
+
+
+/*****************************************************************************/
+
+
+std::string DiaryStore::getEntry ( Date _date, Time _time ) const
+{
+	return m_pSnapshot ? m_pLogIndex->getEntry( * m_pSnapshot, _date, _time ) : loadDiary().getEntry( _date, _time );
+}
+
+
+/*****************************************************************************/
+
+
+int DiaryStore::getEntriesCount ( Date _date ) const
+{
+	return m_pSnapshot ? m_pLogIndex->getEntriesCount( * m_pSnapshot, _date ) : loadDiary().getEntriesCount( _date );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryStore::compact ( std::string const & _path, std::uint64_t _generation )
+{
+	Diary diary = DiaryFile( _path ).load();
+	DiaryLog::replay( getOldLogPath( _path ), diary );
+
+	DiaryFile::write( diary, _path, _generation );
+	std::remove( getOldLogPath( _path ).c_str() );
+}
+
+
+/*****************************************************************************/
+
+
+DiaryLog & DiaryStore::getLog ()
+{
+	// Only a failure to put the log back after a failed rotation leaves none
+	if ( ! m_pLog )
+		throw std::logic_error( Messages::CannotWriteFile );
+
+	return * m_pLog;
+}
+
+
+/*****************************************************************************/
+
+
+template< typename _Append >
+void DiaryStore::logChange ( _Append _append )
+{
+	try
+	{
+		_append();
+	}
+	catch ( ... )
+	{
+		// The log holds no part of the change, so loading again leaves it out
+		m_pDiary.reset();
+		throw;
+	}
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryStore::addEntry ( Date _date, Time _time, std::string const & _text )
+{
+	DiaryLog & log = getLog();
+
+	loadDiary().addEntry( _date, _time, _text );
+	logChange( [ & ] { log.addEntry( _date, _time, _text ); } );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryStore::modifyEntry ( Date _date, Time _time, std::string const & _text )
+{
+	DiaryLog & log = getLog();
+
+	loadDiary().modifyEntry( _date, _time, _text );
+	logChange( [ & ] { log.modifyEntry( _date, _time, _text ); } );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryStore::removeEntries ( Date _date )
+{
+	DiaryLog & log = getLog();
+
+	loadDiary().removeEntries( _date );
+	logChange( [ & ] { log.removeEntries( _date ); } );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryStore::removeEntries ( Time _time )
+{
+	DiaryLog & log = getLog();
+
+	loadDiary().removeEntries( _time );
+	logChange( [ & ] { log.removeEntries( _time ); } );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryStore::removeEntry ( Date _date, Time _time )
+{
+	DiaryLog & log = getLog();
+
+	loadDiary().removeEntry( _date, _time );
+	logChange( [ & ] { log.removeEntry( _date, _time ); } );
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryStore::startCompaction ()
+{
+	if ( isCompacting() )
+		return;
+
+	if ( m_compaction.valid() )
+		m_compaction.get();
+
+	if ( m_pSnapshot )
+	{
+		if ( m_pLogIndex->isEmpty() )
+			return;
+
+		// The compaction replaces the snapshot, which then cannot stay mapped
+		m_pSnapshot.reset();
+		m_pLogIndex.reset();
+	}
+
+	const std::string logPath = getLogPath( m_path );
+	const std::string oldLogPath = getOldLogPath( m_path );
+
+	// A failed compaction leaves its log unfolded, so it is retried rather
+	// than replaced by the current log
+	std::uint64_t oldLogGeneration;
+	if ( DiaryLog::readGeneration( oldLogPath, oldLogGeneration ) )
+	{
+		m_compaction = std::async( std::launch::async, & DiaryStore::compact, m_path, m_generation );
+		return;
+	}
+
+	// The log cannot be renamed while it is open on Windows
+	m_pLog.reset();
+	try
+	{
+		replaceFile( logPath, oldLogPath );
+	}
+	catch ( ... )
+	{
+		m_pLog.reset( new DiaryLog( logPath ) );
+		throw;
+	}
+
+	std::unique_ptr< DiaryLog > pLog;
+	try
+	{
+		DiaryLog::create( logPath, m_generation + 1 );
+		pLog.reset( new DiaryLog( logPath ) );
+	}
+	catch ( ... )
+	{
+		// The old log goes back in place and the store carries on with it
+		replaceFile( oldLogPath, logPath );
+		m_pLog.reset( new DiaryLog( logPath ) );
+		throw;
+	}
+
+	++ m_generation;
+	m_pLog = std::move( pLog );
+
+	m_compaction = std::async( std::launch::async, & DiaryStore::compact, m_path, m_generation );
+}
+
+
+/*****************************************************************************/
+
+
+bool DiaryStore::isCompacting () const
+{
+	return m_compaction.valid()
+		&& m_compaction.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready;
+}
+
+
+/*****************************************************************************/
+
+
+void DiaryStore::waitForCompaction ()
+{
+	if ( m_compaction.valid() )
+		m_compaction.get();
+}
+
+
+/*****************************************************************************/
@@ -0,0 +1,145 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _DIARY_STORE_HPP_
+#define _DIARY_STORE_HPP_
+
+/*****************************************************************************/
+
+#include "diary.hpp"
+#include "diary_file.hpp"
+#include "diary_log.hpp"
+
+#include <string>
+#include <memory>
+#include <future>
+#include <cstdint>
+
+/*****************************************************************************/
+
+/*
+	A diary kept on disk as a snapshot and a delta log of the changes made
+	since. Opening maps the snapshot and indexes the log, so it takes time in
+	proportion to the log rather than to the diary. The diary is loaded into
+	memory, and the log replayed onto it, on first use; until then, lookups of
+	single entries check the index of the log and then the mapped snapshot.
+	Every change is applied
+	to the diary in memory first and then appended to the log; when appending
+	fails, the diary is dropped and loaded again without the change.
+
+	Compaction folds the log into a new snapshot. The log is renamed aside and
+	a new one is started, so changes go on while a background thread loads the
+	old snapshot, replays the old log and writes the next snapshot, never
+	touching the diary in memory. Generations of snapshots and logs tell which
+	logs are already folded when a compaction was interrupted; opening finishes
+	such a compaction.
+*/
+
+class DiaryStore
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*-----------------------------------------------------------------*/
+
+	// The snapshot must exist; DiaryFile::write creates one for a new diary
+	explicit DiaryStore ( std::string const & _path );
+
+	// Waits for a running compaction
+	~DiaryStore ();
+
+	DiaryStore ( DiaryStore const & ) = delete;
+
+	DiaryStore & operator = ( DiaryStore const & ) = delete;
+
+/*-----------------------------------------------------------------*/
+
+	// Loads the diary on first use
+	Diary const & getDiary () const;
+
+	bool hasEntry ( Date _date, Time _time ) const;
+
+	std::string getEntry ( Date _date, Time _time ) const;
+
+	int getEntriesCount ( Date _date ) const;
+
+	void addEntry ( Date _date, Time _time, std::string const & _text );
+
+	void modifyEntry ( Date _date, Time _time, std::string const & _text );
+
+	void removeEntries ( Date _date );
+
+	void removeEntries ( Time _time );
+
+	void removeEntry ( Date _date, Time _time );
+
+/*-----------------------------------------------------------------*/
+
+	// Does nothing while a compaction is running or when the snapshot has no
+	// changes on top of it. When the log cannot be rotated, the store goes on
+	// with the current one
+	void startCompaction ();
+
+	bool isCompacting () const;
+
+	// Rethrows an error of the compaction
+	void waitForCompaction ();
+
+/*-----------------------------------------------------------------*/
+
+private:
+
+/*-----------------------------------------------------------------*/
+
+	// Loads the snapshot and replays the logs not folded into it yet, once
+	Diary & loadDiary () const;
+
+	// Writes the snapshot of the generation from the previous one and the old log
+	static void compact ( std::string const & _path, std::uint64_t _generation );
+
+	// Throws when there is no log to append to
+	DiaryLog & getLog ();
+
+	// Appends a change already made to the loaded diary, and drops the diary
+	// when that fails
+	template< typename _Append >
+	void logChange ( _Append _append );
+
+/*-----------------------------------------------------------------*/
+
+	const std::string m_path;
+
+	// Generation of the snapshot the current log applies to
+	std::uint64_t m_generation;
+
+	// Only while the diary is not loaded and no compaction was started, so
+	// the snapshot is never replaced while it is mapped
+	mutable std::unique_ptr< DiaryFile > m_pSnapshot;
+
+	// Changes of the log on top of the mapped snapshot
+	mutable std::unique_ptr< DiaryLogIndex > m_pLogIndex;
+
+	mutable std::unique_ptr< Diary > m_pDiary;
+
+	std::unique_ptr< DiaryLog > m_pLog;
+
+	std::future< void > m_compaction;
+
+/*-----------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline Diary const & DiaryStore::getDiary () const
+{
+	return loadDiary();
+}
+
+
+/*****************************************************************************/
+
+#endif // _DIARY_STORE_HPP_
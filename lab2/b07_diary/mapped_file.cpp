@@ -0,0 +1,345 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "mapped_file.hpp"
+#include "messages.hpp"
+
+#include <stdexcept>
+#include <algorithm>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <cstdio>
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+/*****************************************************************************/
+
+#ifdef _WIN32
+
+
+MappedFile::MappedFile ( std::string const & _path )
+	:	m_pData( nullptr ), m_size( 0 )
+{
+	// A log is read while it is still open for appending
+	HANDLE file = CreateFileA(
+			_path.c_str()
+		,	GENERIC_READ
+		,	FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE
+		,	nullptr
+		,	OPEN_EXISTING
+		,	FILE_ATTRIBUTE_NORMAL
+		,	nullptr
+	);
+	if ( file == INVALID_HANDLE_VALUE )
+		throw std::logic_error( Messages::CannotOpenFile );
+
+	LARGE_INTEGER size;
+	if ( ! GetFileSizeEx( file, & size ) )
+	{
+		CloseHandle( file );
+		throw std::logic_error( Messages::CannotOpenFile );
+	}
+
+	m_size = static_cast< std::size_t >( size.QuadPart );
+	if ( m_size == 0 )
+	{
+		CloseHandle( file );
+		return;
+	}
+
+	// The view keeps the mapping and the file open by itself
+	HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	CloseHandle( file );
+	if ( ! mapping )
+		throw std::logic_error( Messages::CannotOpenFile );
+
+	m_pData = static_cast< char const * >( MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) );
+	CloseHandle( mapping );
+	if ( ! m_pData )
+		throw std::logic_error( Messages::CannotOpenFile );
+}
+
+
+/*****************************************************************************/
+
+
+MappedFile::~MappedFile ()
+{
+	if ( m_pData )
+		UnmapViewOfFile( m_pData );
+}
+
+
+/*****************************************************************************/
+
+
+AppendFile::AppendFile ( std::string const & _path )
+	:	m_size( 0 ), m_broken( false )
+{
+	// Appending only would not allow cutting a failed append off
+	m_handle = CreateFileA(
+			_path.c_str()
+		,	GENERIC_WRITE
+		,	FILE_SHARE_READ | FILE_SHARE_DELETE
+		,	nullptr
+		,	OPEN_ALWAYS
+		,	FILE_ATTRIBUTE_NORMAL
+		,	nullptr
+	);
+	if ( m_handle == INVALID_HANDLE_VALUE )
+		throw std::logic_error( Messages::CannotOpenFile );
+
+	LARGE_INTEGER size;
+	const LARGE_INTEGER zero = {};
+	if ( ! SetFilePointerEx( m_handle, zero, & size, FILE_END ) )
+	{
+		CloseHandle( m_handle );
+		throw std::logic_error( Messages::CannotOpenFile );
+	}
+
+	m_size = static_cast< std::uint64_t >( size.QuadPart );
+}
+
+
+/*****************************************************************************/
+
+
+AppendFile::~AppendFile ()
+{
+	CloseHandle( m_handle );
+}
+
+
+/*****************************************************************************/
+
+
+void AppendFile::append ( char const * _pData, std::size_t _size )
+{
+	if ( m_broken )
+		throw std::logic_error( Messages::CannotWriteFile );
+
+	bool written = true;
+	for ( std::size_t left = _size; written && left > 0; )
+	{
+		DWORD chunkWritten = 0;
+		const DWORD chunk = static_cast< DWORD >( std::min< std::size_t >( left, MAXDWORD ) );
+		written = WriteFile( m_handle, _pData, chunk, & chunkWritten, nullptr ) != FALSE;
+
+		_pData += chunkWritten;
+		left -= chunkWritten;
+	}
+
+	if ( ! written || ! FlushFileBuffers( m_handle ) )
+	{
+		// Whatever part was written would be followed by the next append
+		LARGE_INTEGER size;
+		size.QuadPart = static_cast< LONGLONG >( m_size );
+		if ( ! SetFilePointerEx( m_handle, size, nullptr, FILE_BEGIN ) || ! SetEndOfFile( m_handle ) || ! FlushFileBuffers( m_handle ) )
+			m_broken = true;
+
+		throw std::logic_error( Messages::CannotWriteFile );
+	}
+
+	m_size += _size;
+}
+
+
+/*****************************************************************************/
+
+
+void replaceFile ( std::string const & _from, std::string const & _to )
+{
+	HANDLE file = CreateFileA(
+			_from.c_str()
+		,	GENERIC_WRITE
+		,	FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE
+		,	nullptr
+		,	OPEN_EXISTING
+		,	FILE_ATTRIBUTE_NORMAL
+		,	nullptr
+	);
+	if ( file == INVALID_HANDLE_VALUE )
+		throw std::logic_error( Messages::CannotWriteFile );
+
+	const BOOL flushed = FlushFileBuffers( file );
+	CloseHandle( file );
+
+	// Write-through also flushes the directory entries
+	if ( ! flushed || ! MoveFileExA( _from.c_str(), _to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) )
+		throw std::logic_error( Messages::CannotWriteFile );
+}
+
+
+/*****************************************************************************/
+
+#else
+
+
+MappedFile::MappedFile ( std::string const & _path )
+	:	m_pData( nullptr ), m_size( 0 )
+{
+	const int file = open( _path.c_str(), O_RDONLY );
+	if ( file == -1 )
+		throw std::logic_error( Messages::CannotOpenFile );
+
+	struct stat status;
+	if ( fstat( file, & status ) == -1 )
+	{
+		close( file );
+		throw std::logic_error( Messages::CannotOpenFile );
+	}
+
+	m_size = static_cast< std::size_t >( status.st_size );
+	if ( m_size == 0 )
+	{
+		close( file );
+		return;
+	}
+
+	// The mapping keeps the file open by itself
+	void * pData = mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0 );
+	close( file );
+	if ( pData == MAP_FAILED )
+		throw std::logic_error( Messages::CannotOpenFile );
+
+	m_pData = static_cast< char const * >( pData );
+}
+
+
+/*****************************************************************************/
+
+
+MappedFile::~MappedFile ()
+{
+	if ( m_pData )
+		munmap( const_cast< char * >( m_pData ), m_size );
+}
+
+
+/*****************************************************************************/
+
+
+namespace
+{
+
+/*-----------------------------------------------------------------*/
+
+// Flushes the file, or the directory entries when it is a directory
+void syncFile ( std::string const & _path )
+{
+	const int file = open( _path.c_str(), O_RDONLY );
+	if ( file == -1 )
+		throw std::logic_error( Messages::CannotWriteFile );
+
+	const int result = fsync( file );
+	close( file );
+	if ( result == -1 )
+		throw std::logic_error( Messages::CannotWriteFile );
+}
+
+
+/*-----------------------------------------------------------------*/
+
+std::string getDirectory ( std::string const & _path )
+{
+	const std::string::size_type slash = _path.rfind( '/' );
+	if ( slash == std::string::npos )
+		return ".";
+
+	return ( slash == 0 ) ? "/" : _path.substr( 0, slash );
+}
+
+
+/*-----------------------------------------------------------------*/
+
+}
+
+/*****************************************************************************/
+
+
+AppendFile::AppendFile ( std::string const & _path )
+	:	m_handle( open( _path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0666 ) )
+	,	m_size( 0 ), m_broken( false )
+{
+	if ( m_handle == -1 )
+		throw std::logic_error( Messages::CannotOpenFile );
+
+	const off_t size = lseek( m_handle, 0, SEEK_END );
+	if ( size == -1 )
+	{
+		close( m_handle );
+		throw std::logic_error( Messages::CannotOpenFile );
+	}
+
+	m_size = static_cast< std::uint64_t >( size );
+}
+
+
+/*****************************************************************************/
+
+
+AppendFile::~AppendFile ()
+{
+	close( m_handle );
+}
+
+
+/*****************************************************************************/
+
+
+void AppendFile::append ( char const * _pData, std::size_t _size )
+{
+	if ( m_broken )
+		throw std::logic_error( Messages::CannotWriteFile );
+
+	bool written = true;
+	for ( std::size_t left = _size; written && left > 0; )
+	{
+		const ssize_t chunkWritten = write( m_handle, _pData, left );
+		if ( chunkWritten == -1 )
+		{
+			written = ( errno == EINTR );
+			continue;
+		}
+
+		_pData += chunkWritten;
+		left -= static_cast< std::size_t >( chunkWritten );
+	}
+
+	if ( ! written || fsync( m_handle ) == -1 )
+	{
+		// Whatever part was written would be followed by the next append
+		if ( ftruncate( m_handle, static_cast< off_t >( m_size ) ) == -1 || fsync( m_handle ) == -1 )
+			m_broken = true;
+
+		throw std::logic_error( Messages::CannotWriteFile );
+	}
+
+	m_size += _size;
+}
+
+
+/*****************************************************************************/
+
+
+void replaceFile ( std::string const & _from, std::string const & _to )
+{
+	syncFile( _from );
+
+	if ( std::rename( _from.c_str(), _to.c_str() ) != 0 )
+		throw std::logic_error( Messages::CannotWriteFile );
+
+	syncFile( getDirectory( _to ) );
+}
+
+
+/*****************************************************************************/
+
+#endif
@@ -0,0 +1,142 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _MAPPED_FILE_HPP_
+#define _MAPPED_FILE_HPP_
+
+/*****************************************************************************/
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+/*****************************************************************************/
+
+/*
+	A whole file mapped into memory for reading. Pages are read by the system
+	on first access, so opening costs the same for files of any size. The
+	mapping is released with the object; the mapped part of the file must
+	not be changed while it is mapped, though the file may grow.
+*/
+
+class MappedFile
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*-----------------------------------------------------------------*/
+
+	explicit MappedFile ( std::string const & _path );
+
+	~MappedFile ();
+
+	MappedFile ( MappedFile const & ) = delete;
+
+	MappedFile & operator = ( MappedFile const & ) = delete;
+
+/*-----------------------------------------------------------------*/
+
+	// nullptr for an empty file
+	char const * getData () const;
+
+	std::size_t getSize () const;
+
+/*-----------------------------------------------------------------*/
+
+private:
+
+/*-----------------------------------------------------------------*/
+
+	char const * m_pData;
+
+	std::size_t m_size;
+
+/*-----------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline char const * MappedFile::getData () const
+{
+	return m_pData;
+}
+
+
+/*****************************************************************************/
+
+
+inline std::size_t MappedFile::getSize () const
+{
+	return m_size;
+}
+
+
+/*****************************************************************************/
+
+/*
+	A file open for appending, created if there is none. Every append is
+	written through to the disk before it returns, so it survives a crash of
+	the system as well as of the program.
+
+	An append that fails, for instance when the disk is full, is cut off the
+	file again, so the file only ever holds whole appends. When even that
+	fails, the file refuses any further appends.
+*/
+
+class AppendFile
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*-----------------------------------------------------------------*/
+
+	explicit AppendFile ( std::string const & _path );
+
+	~AppendFile ();
+
+	AppendFile ( AppendFile const & ) = delete;
+
+	AppendFile & operator = ( AppendFile const & ) = delete;
+
+/*-----------------------------------------------------------------*/
+
+	void append ( char const * _pData, std::size_t _size );
+
+/*-----------------------------------------------------------------*/
+
+private:
+
+/*-----------------------------------------------------------------*/
+
+#ifdef _WIN32
+	void * m_handle;
+#else
+	int m_handle;
+#endif
+
+	// Length of the file up to the end of the last whole append
+	std::uint64_t m_size;
+
+	bool m_broken;
+
+/*-----------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+// Renames the file, replacing the target if it exists. The contents of the
+// file reach the disk before the rename, and the rename before it returns,
+// so after a crash the target is either the old file or the whole new one
+void replaceFile ( std::string const & _from, std::string const & _to );
+
+/*****************************************************************************/
+
+#endif // _MAPPED_FILE_HPP_
@@ -11,6 +11,10 @@ namespace Messages
 	const char * const EmptyEntryText = "Entry cannot be empty";
 	const char * const InvalidEntryTime = "Invalid entry time";
 	const char * const EntryDoesNotExist = "Entry does not exist";
+	const char * const BadDateRange = "Date range is incorrect";
+	const char * const CannotOpenFile = "Cannot open file";
+	const char * const CannotWriteFile = "Cannot write file";
+	const char * const DamagedDiaryFile = "Diary file is damaged";
 }
 
 /*****************************************************************************/
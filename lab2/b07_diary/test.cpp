@@ -3,11 +3,20 @@
 /*****************************************************************************/
 
 #include "diary.hpp"
+#include "diary_file.hpp"
+#include "diary_store.hpp"
 #include "messages.hpp"
 
 #include "testslib.hpp"
 
 #include <sstream>
+#include <fstream>
+#include <cstdio>
+
+#ifndef _WIN32
+	#include <csignal>
+	#include <sys/resource.h>
+#endif
 
 /*****************************************************************************/
 
@@ -59,6 +68,21 @@
 	Done	11) Copy of Diary
 	Done		11.1) Stack
 	Done		11.2) Heap
+	Done	12) Scan entries
+	Done		12.1) Days and entries in order
+	Done		12.2) Entries of a range of days
+	Done		12.3) Many entries after removals
+	Done	13) Diary on disk
+	Done		13.1) Snapshot
+	Done		13.2) Damaged snapshot
+	Done		13.3) Reopen with delta log
+	Done		13.4) Changes during compaction
+	Done		13.5) Lookups before loading
+	Done		13.6) Interrupted compaction, snapshot not replaced
+	Done		13.7) Interrupted compaction, snapshot replaced
+	Done		13.8) Failed append
+	Done		13.9) Lookups through the delta log
+	Done		13.10) Snapshot with keys out of order
 */
 
 /*****************************************************************************/
@@ -1013,4 +1037,661 @@ DECLARE_OOP_TEST( diary_11_2_copy_of_diary_heap )
 }
 
 
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( diary_12_1_scan_entries_days_and_entries_in_order )
+{
+	Diary d( "kukushka" );
+	const Diary & rD = d;
+
+	Date date1( 2016, 07, 19 );
+	Date date2( 2016, 07, 20 );
+	Date date3( 2016, 12, 31 );
+	d.addEntry( date3, Time( 9, 00, 00 ), "third" );
+	d.addEntry( date1, Time( 10, 00, 00 ), "first" );
+	d.addEntry( date1, Time( 23, 59, 59 ), "second" );
+	d.addEntry( date2, Time( 8, 30, 00 ), "removed" );
+	d.removeEntry( date2, Time( 8, 30, 00 ) );
+
+	Diary::Iterator it = rD.begin();
+	assert( it->first == date1 );
+	assert( it->second.size() == 2 );
+
+	Diary::EntryIterator entryIt = it->second.begin();
+	assert( entryIt->first == Time( 10, 00, 00 ) );
+	assert( entryIt->second == "first" );
+	assert( entryIt.getDate() == date1 );
+	++ entryIt;
+	assert( entryIt->first == Time( 23, 59, 59 ) );
+	assert( entryIt->second == "second" );
+	++ entryIt;
+	assert( entryIt == it->second.end() );
+
+	++ it;
+	assert( it->first == date2 );
+	assert( it->second.empty() );
+
+	++ it;
+	assert( it->first == date3 );
+	assert( ( * it->second.begin() ).second == "third" );
+
+	++ it;
+	assert( it == rD.end() );
+
+	assert( rD.getEntries( date1 ).size() == 2 );
+	assert( rD.getEntries( date2 ).empty() );
+	assert( rD.getEntries( Date( 2000, 1, 1 ) ).empty() );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( diary_12_2_scan_entries_of_a_range_of_days )
+{
+	Diary d( "kukushka" );
+	const Diary & rD = d;
+
+	for ( int day = 1; day <= 31; ++day )
+		for ( int hour = 0; hour < 24; hour += 6 )
+			d.addEntry( Date( 2016, 1, day ), Time( hour, 0, 0 ), std::to_string( day * 100 + hour ) );
+
+	Diary::EntryRange range = rD.getEntries( Date( 2016, 1, 10 ), Date( 2016, 1, 12 ) );
+	assert( range.size() == 12 );
+
+	std::vector< std::string > texts;
+	for ( Diary::EntryIterator it = range.begin(); it != range.end(); ++it )
+	{
+		assert( it.getDate() >= Date( 2016, 1, 10 ) && it.getDate() <= Date( 2016, 1, 12 ) );
+		texts.push_back( it->second );
+	}
+
+	assert( texts.front() == "1000" );
+	assert( texts.back() == "1218" );
+
+	assert( rD.getEntries( Date( 2016, 1, 31 ), Date( 2016, 2, 29 ) ).size() == 4 );
+	assert( rD.getEntries( Date( 2015, 1, 1 ), Date( 2015, 12, 31 ) ).empty() );
+	assert( rD.getEntries( Date( 2015, 1, 1 ), Date( 2017, 1, 1 ) ).size() == 124 );
+
+	ASSERT_THROWS(
+			rD.getEntries( Date( 2016, 1, 12 ), Date( 2016, 1, 10 ) );
+		,	Messages::BadDateRange
+	);
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( diary_12_3_scan_entries_many_entries_after_removals )
+{
+	Diary d( "kukushka" );
+	const Diary & rD = d;
+
+	// Days are added in reverse order, entries of a day in order
+	for ( int day = 28; day >= 1; --day )
+		for ( int minute = 0; minute < 60; ++minute )
+			d.addEntry( Date( 2016, 2, day ), Time( 12, minute, 0 ), "a rather long entry text #" + std::to_string( minute ) );
+
+	d.removeEntries( Time( 12, 0, 0 ) );
+	d.removeEntries( Date( 2016, 2, 14 ) );
+	d.removeEntry( Date( 2016, 2, 1 ), Time( 12, 59, 0 ) );
+	d.modifyEntry( Date( 2016, 2, 28 ), Time( 12, 30, 0 ), "short" );
+
+	assert( rD.getDaysCount() == 27 );
+	assert( rD.getEntriesCount( Date( 2016, 2, 1 ) ) == 58 );
+	assert( rD.getEntriesCount( Date( 2016, 2, 2 ) ) == 59 );
+	assert( !rD.hasEntries( Time( 12, 0, 0 ) ) );
+	assert( rD.getEntry( Date( 2016, 2, 28 ), Time( 12, 30, 0 ) ) == "short" );
+	assert( rD.getEntry( Date( 2016, 2, 27 ), Time( 12, 30, 0 ) ) == "a rather long entry text #30" );
+
+	int entriesCount = 0;
+	Date previousDate( 2016, 1, 1 );
+	for ( Diary::Iterator::Value day : rD )
+	{
+		assert( previousDate < day.first );
+		previousDate = day.first;
+
+		for ( Diary::EntryIterator::Value entry : day.second )
+		{
+			assert( rD.getEntry( day.first, entry.first ) == entry.second );
+			++ entriesCount;
+		}
+	}
+
+	assert( entriesCount == 26 * 59 + 58 );
+	assert( rD.getEntries( Date( 2016, 2, 1 ), Date( 2016, 2, 28 ) ).size() == entriesCount );
+}
+
+
+/*****************************************************************************/
+
+
+namespace
+{
+
+std::string printDiary ( Diary const & _diary )
+{
+	std::stringstream stream;
+	stream << _diary;
+	return stream.str();
+}
+
+
+void removeDiaryFiles ( std::string const & _path )
+{
+	std::remove( _path.c_str() );
+	std::remove( ( _path + ".log" ).c_str() );
+	std::remove( ( _path + ".log.old" ).c_str() );
+}
+
+
+std::streamoff getFileSize ( std::string const & _path )
+{
+	std::ifstream file( _path, std::ios::binary | std::ios::ate );
+	return file.tellg();
+}
+
+
+void swapFileBytes ( std::string const & _path, std::streamoff _first, std::streamoff _second, int _size )
+{
+	std::fstream file( _path, std::ios::binary | std::ios::in | std::ios::out );
+
+	std::string first( _size, '\0' ), second( _size, '\0' );
+	file.seekg( _first ).read( & first[ 0 ], _size );
+	file.seekg( _second ).read( & second[ 0 ], _size );
+	file.seekp( _first ).write( second.data(), _size );
+	file.seekp( _second ).write( first.data(), _size );
+}
+
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( diary_13_1_diary_on_disk_snapshot )
+{
+	const std::string path = "diary_13_1.bin";
+
+	Diary d( "kukushka" );
+	d.addEntry( Date( 2016, 07, 19 ), Time( 11, 00, 00 ), "hello" );
+	d.addEntry( Date( 2016, 07, 19 ), Time( 11, 00, 01 ), std::string( 100, 'x' ) );
+	d.addEntry( Date( 2016, 07, 20 ), Time( 9, 00, 00 ), "removed" );
+	d.addEntry( Date( 2016, 12, 31 ), Time( 23, 59, 59 ), "world" );
+	d.removeEntry( Date( 2016, 07, 20 ), Time( 9, 00, 00 ) );
+
+	DiaryFile::write( d, path, 5 );
+
+	{
+		const DiaryFile file( path );
+
+		assert( file.getGeneration() == 5 );
+		assert( file.getOwnerName() == "kukushka" );
+		assert( file.getDaysCount() == 3 );
+		assert( file.getEntriesCount() == 3 );
+		assert( file.getEntriesCount( Date( 2016, 07, 19 ) ) == 2 );
+		assert( file.getEntriesCount( Date( 2016, 07, 20 ) ) == 0 );
+		assert( file.getEntriesCount( Date( 2016, 07, 21 ) ) == 0 );
+
+		assert( file.hasEntry( Date( 2016, 12, 31 ), Time( 23, 59, 59 ) ) );
+		assert( !file.hasEntry( Date( 2016, 12, 31 ), Time( 23, 59, 58 ) ) );
+		assert( file.getEntry( Date( 2016, 07, 19 ), Time( 11, 00, 01 ) ) == std::string( 100, 'x' ) );
+
+		ASSERT_THROWS(
+				file.getEntry( Date( 2016, 07, 20 ), Time( 9, 00, 00 ) );
+			,	Messages::EntryDoesNotExist
+		);
+
+		assert( printDiary( file.load() ) == printDiary( d ) );
+	}
+
+	DiaryFile::write( Diary( "empty" ), path );
+	assert( printDiary( DiaryFile( path ).load() ) == "Owner: empty\nNo entries\n" );
+
+	removeDiaryFiles( path );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( diary_13_2_diary_on_disk_damaged_snapshot )
+{
+	const std::string path = "diary_13_2.bin";
+
+	Diary d( "kukushka" );
+	d.addEntry( Date( 2016, 07, 19 ), Time( 11, 00, 00 ), "hello" );
+	DiaryFile::write( d, path );
+
+	{
+		std::ofstream file( path, std::ios::binary | std::ios::app );
+		file << "tail";
+	}
+
+	ASSERT_THROWS(
+			DiaryFile file( path );
+		,	Messages::DamagedDiaryFile
+	);
+
+	{
+		std::ofstream file( path, std::ios::binary | std::ios::trunc );
+		file << "not a diary";
+	}
+
+	ASSERT_THROWS(
+			DiaryFile file( path );
+		,	Messages::DamagedDiaryFile
+	);
+
+	removeDiaryFiles( path );
+
+	ASSERT_THROWS(
+			DiaryFile file( path );
+		,	Messages::CannotOpenFile
+	);
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( diary_13_3_diary_on_disk_reopen_with_delta_log )
+{
+	const std::string path = "diary_13_3.bin";
+	removeDiaryFiles( path );
+
+	DiaryFile::write( Diary( "kukushka" ), path );
+
+	std::string expected;
+	{
+		DiaryStore store( path );
+		for ( int day = 1; day <= 10; ++day )
+		{
+			store.addEntry( Date( 2016, 3, day ), Time( 8, 0, 0 ), "morning" );
+			store.addEntry( Date( 2016, 3, day ), Time( 20, 0, 0 ), "evening" );
+		}
+
+		store.modifyEntry( Date( 2016, 3, 2 ), Time( 8, 0, 0 ), "late morning" );
+		store.removeEntries( Date( 2016, 3, 3 ) );
+		store.removeEntries( Time( 20, 0, 0 ) );
+		store.removeEntry( Date( 2016, 3, 4 ), Time( 8, 0, 0 ) );
+
+		ASSERT_THROWS(
+				store.addEntry( Date( 2016, 3, 1 ), Time( 7, 0, 0 ), "too early" );
+			,	Messages::InvalidEntryTime
+		);
+
+		expected = printDiary( store.getDiary() );
+	}
+
+	// The last change is cut short, as if the program stopped while writing it
+	{
+		std::ofstream log( path + ".log", std::ios::binary | std::ios::app );
+		log.write( "\0\1", 2 );
+	}
+
+	{
+		DiaryStore store( path );
+		assert( printDiary( store.getDiary() ) == expected );
+		assert( store.getDiary().getDaysCount() == 9 );
+		assert( store.getDiary().getEntry( Date( 2016, 3, 2 ), Time( 8, 0, 0 ) ) == "late morning" );
+
+		store.addEntry( Date( 2016, 3, 11 ), Time( 8, 0, 0 ), "after reopening" );
+		expected = printDiary( store.getDiary() );
+	}
+
+	DiaryStore store( path );
+	assert( printDiary( store.getDiary() ) == expected );
+
+	removeDiaryFiles( path );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( diary_13_4_diary_on_disk_changes_during_compaction )
+{
+	const std::string path = "diary_13_4.bin";
+	removeDiaryFiles( path );
+
+	DiaryFile::write( Diary( "kukushka" ), path );
+
+	std::string expected;
+	{
+		DiaryStore store( path );
+		for ( int minute = 0; minute < 60; ++minute )
+			store.addEntry( Date( 2016, 4, 1 ), Time( 9, minute, 0 ), "entry #" + std::to_string( minute ) );
+
+		store.startCompaction();
+
+		store.addEntry( Date( 2016, 4, 2 ), Time( 9, 0, 0 ), "during compaction" );
+		store.removeEntry( Date( 2016, 4, 1 ), Time( 9, 30, 0 ) );
+
+		store.waitForCompaction();
+		assert( !store.isCompacting() );
+
+		const DiaryFile snapshot( path );
+		assert( snapshot.getGeneration() == 1 );
+		assert( snapshot.getEntriesCount() == 60 );
+		assert( !snapshot.hasEntry( Date( 2016, 4, 2 ), Time( 9, 0, 0 ) ) );
+
+		expected = printDiary( store.getDiary() );
+	}
+
+	{
+		DiaryStore store( path );
+		assert( printDiary( store.getDiary() ) == expected );
+
+		store.startCompaction();
+	}
+
+	const DiaryFile snapshot( path );
+	assert( snapshot.getGeneration() == 2 );
+	assert( printDiary( snapshot.load() ) == expected );
+
+	removeDiaryFiles( path );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( diary_13_5_diary_on_disk_lookups_before_loading )
+{
+	const std::string path = "diary_13_5.bin";
+	removeDiaryFiles( path );
+
+	Diary d( "kukushka" );
+	d.addEntry( Date( 2016, 5, 1 ), Time( 10, 0, 0 ), "first" );
+	d.addEntry( Date( 2016, 5, 1 ), Time( 11, 0, 0 ), "second" );
+	DiaryFile::write( d, path, 3 );
+
+	{
+		DiaryStore store( path );
+		assert( store.hasEntry( Date( 2016, 5, 1 ), Time( 11, 0, 0 ) ) );
+		assert( !store.hasEntry( Date( 2016, 5, 2 ), Time( 11, 0, 0 ) ) );
+		assert( store.getEntry( Date( 2016, 5, 1 ), Time( 10, 0, 0 ) ) == "first" );
+		assert( store.getEntriesCount( Date( 2016, 5, 1 ) ) == 2 );
+
+		ASSERT_THROWS(
+				store.getEntry( Date( 2016, 5, 1 ), Time( 12, 0, 0 ) );
+			,	Messages::EntryDoesNotExist
+		);
+
+		// Nothing to fold yet
+		store.startCompaction();
+		assert( !store.isCompacting() );
+		assert( DiaryFile( path ).getGeneration() == 3 );
+
+		store.modifyEntry( Date( 2016, 5, 1 ), Time( 10, 0, 0 ), "changed" );
+		assert( store.getEntry( Date( 2016, 5, 1 ), Time( 10, 0, 0 ) ) == "changed" );
+	}
+
+	{
+		DiaryStore store( path );
+		store.removeEntry( Date( 2016, 5, 1 ), Time( 11, 0, 0 ) );
+	}
+
+	DiaryStore store( path );
+	assert( store.getEntry( Date( 2016, 5, 1 ), Time( 10, 0, 0 ) ) == "changed" );
+	assert( !store.hasEntry( Date( 2016, 5, 1 ), Time( 11, 0, 0 ) ) );
+	assert( store.getEntriesCount( Date( 2016, 5, 1 ) ) == 1 );
+
+	removeDiaryFiles( path );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( diary_13_6_diary_on_disk_interrupted_compaction_snapshot_not_replaced )
+{
+	const std::string path = "diary_13_6.bin";
+	removeDiaryFiles( path );
+
+	DiaryFile::write( Diary( "kukushka" ), path );
+
+	{
+		DiaryStore store( path );
+		store.addEntry( Date( 2016, 6, 1 ), Time( 9, 0, 0 ), "before compaction" );
+		store.addEntry( Date( 2016, 6, 1 ), Time( 10, 0, 0 ), "also before" );
+	}
+
+	// The log was renamed aside and the next one started, but the snapshot
+	// of the next generation was never written
+	std::rename( ( path + ".log" ).c_str(), ( path + ".log.old" ).c_str() );
+	DiaryLog::create( path + ".log", 1 );
+	DiaryLog( path + ".log" ).addEntry( Date( 2016, 6, 2 ), Time( 9, 0, 0 ), "after compaction" );
+
+	std::string expected;
+	{
+		DiaryStore store( path );
+		assert( store.getEntriesCount( Date( 2016, 6, 1 ) ) == 2 );
+		assert( store.getEntry( Date( 2016, 6, 2 ), Time( 9, 0, 0 ) ) == "after compaction" );
+
+		store.waitForCompaction();
+		expected = printDiary( store.getDiary() );
+	}
+
+	std::uint64_t generation;
+	assert( !DiaryLog::readGeneration( path + ".log.old", generation ) );
+
+	const DiaryFile snapshot( path );
+	assert( snapshot.getGeneration() == 1 );
+	assert( snapshot.getEntriesCount() == 2 );
+	assert( !snapshot.hasEntry( Date( 2016, 6, 2 ), Time( 9, 0, 0 ) ) );
+
+	DiaryStore store( path );
+	assert( printDiary( store.getDiary() ) == expected );
+
+	removeDiaryFiles( path );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( diary_13_7_diary_on_disk_interrupted_compaction_snapshot_replaced )
+{
+	const std::string path = "diary_13_7.bin";
+	removeDiaryFiles( path );
+
+	Diary d( "kukushka" );
+	d.addEntry( Date( 2016, 7, 1 ), Time( 9, 0, 0 ), "folded" );
+
+	// The snapshot of the next generation was written, but the old log was
+	// not removed; replaying it again would add the entry twice
+	DiaryFile::write( d, path, 1 );
+
+	DiaryLog::create( path + ".log.old", 0 );
+	DiaryLog( path + ".log.old" ).addEntry( Date( 2016, 7, 1 ), Time( 9, 0, 0 ), "folded" );
+
+	DiaryLog::create( path + ".log", 1 );
+	DiaryLog( path + ".log" ).addEntry( Date( 2016, 7, 1 ), Time( 10, 0, 0 ), "not folded" );
+
+	{
+		DiaryStore store( path );
+		assert( !store.isCompacting() );
+
+		std::uint64_t generation;
+		assert( !DiaryLog::readGeneration( path + ".log.old", generation ) );
+
+		assert( store.getEntriesCount( Date( 2016, 7, 1 ) ) == 2 );
+		assert( store.getEntry( Date( 2016, 7, 1 ), Time( 9, 0, 0 ) ) == "folded" );
+		assert( store.getEntry( Date( 2016, 7, 1 ), Time( 10, 0, 0 ) ) == "not folded" );
+	}
+
+	assert( DiaryFile( path ).getGeneration() == 1 );
+
+	removeDiaryFiles( path );
+}
+
+
+/*****************************************************************************/
+
+
+#ifndef _WIN32
+
+DECLARE_OOP_TEST( diary_13_8_diary_on_disk_failed_append )
+{
+	const std::string path = "diary_13_8.bin";
+	removeDiaryFiles( path );
+
+	DiaryFile::write( Diary( "kukushka" ), path );
+
+	{
+		DiaryStore store( path );
+		store.addEntry( Date( 2016, 8, 1 ), Time( 9, 0, 0 ), "kept" );
+
+		// Files may only grow by a few bytes, so the next record is written in
+		// part, as when the disk fills up
+		const std::streamoff logSize = getFileSize( path + ".log" );
+
+		rlimit limit;
+		getrlimit( RLIMIT_FSIZE, & limit );
+		const rlimit oldLimit = limit;
+		limit.rlim_cur = static_cast< rlim_t >( logSize + 10 );
+
+		void ( * oldHandler )( int ) = std::signal( SIGXFSZ, SIG_IGN );
+		setrlimit( RLIMIT_FSIZE, & limit );
+
+		ASSERT_THROWS(
+				store.addEntry( Date( 2016, 8, 1 ), Time( 10, 0, 0 ), std::string( 100, 'x' ) );
+			,	Messages::CannotWriteFile
+		);
+
+		setrlimit( RLIMIT_FSIZE, & oldLimit );
+		std::signal( SIGXFSZ, oldHandler );
+
+		assert( getFileSize( path + ".log" ) == logSize );
+		assert( !store.hasEntry( Date( 2016, 8, 1 ), Time( 10, 0, 0 ) ) );
+		assert( store.getEntriesCount( Date( 2016, 8, 1 ) ) == 1 );
+
+		store.addEntry( Date( 2016, 8, 1 ), Time( 11, 0, 0 ), "after the failure" );
+	}
+
+	DiaryStore store( path );
+	assert( store.getEntriesCount( Date( 2016, 8, 1 ) ) == 2 );
+	assert( !store.hasEntry( Date( 2016, 8, 1 ), Time( 10, 0, 0 ) ) );
+	assert( store.getEntry( Date( 2016, 8, 1 ), Time( 11, 0, 0 ) ) == "after the failure" );
+
+	removeDiaryFiles( path );
+}
+
+#endif
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( diary_13_9_diary_on_disk_lookups_through_the_delta_log )
+{
+	const std::string path = "diary_13_9.bin";
+	removeDiaryFiles( path );
+
+	Diary expected( "kukushka" );
+	for ( int day = 1; day <= 5; ++day )
+		for ( int hour = 8; hour <= 12; ++hour )
+			expected.addEntry( Date( 2016, 9, day ), Time( hour, 0, 0 ), "snapshot" );
+
+	DiaryFile::write( expected, path );
+
+	{
+		DiaryStore store( path );
+		store.modifyEntry( Date( 2016, 9, 1 ), Time( 8, 0, 0 ), "changed" );
+		store.removeEntry( Date( 2016, 9, 1 ), Time( 9, 0, 0 ) );
+		store.addEntry( Date( 2016, 9, 1 ), Time( 13, 0, 0 ), "added" );
+		store.addEntry( Date( 2016, 9, 6 ), Time( 8, 0, 0 ), "new day" );
+		store.removeEntries( Date( 2016, 9, 2 ) );
+		store.addEntry( Date( 2016, 9, 2 ), Time( 10, 0, 0 ), "day added again" );
+		store.removeEntries( Time( 11, 0, 0 ) );
+		store.addEntry( Date( 2016, 9, 3 ), Time( 12, 30, 0 ), "later" );
+		store.removeEntry( Date( 2016, 9, 1 ), Time( 13, 0, 0 ) );
+		store.addEntry( Date( 2016, 9, 6 ), Time( 11, 0, 0 ), "time added again" );
+	}
+
+	expected.modifyEntry( Date( 2016, 9, 1 ), Time( 8, 0, 0 ), "changed" );
+	expected.removeEntry( Date( 2016, 9, 1 ), Time( 9, 0, 0 ) );
+	expected.addEntry( Date( 2016, 9, 1 ), Time( 13, 0, 0 ), "added" );
+	expected.addEntry( Date( 2016, 9, 6 ), Time( 8, 0, 0 ), "new day" );
+	expected.removeEntries( Date( 2016, 9, 2 ) );
+	expected.addEntry( Date( 2016, 9, 2 ), Time( 10, 0, 0 ), "day added again" );
+	expected.removeEntries( Time( 11, 0, 0 ) );
+	expected.addEntry( Date( 2016, 9, 3 ), Time( 12, 30, 0 ), "later" );
+	expected.removeEntry( Date( 2016, 9, 1 ), Time( 13, 0, 0 ) );
+	expected.addEntry( Date( 2016, 9, 6 ), Time( 11, 0, 0 ), "time added again" );
+
+	DiaryStore store( path );
+	for ( int day = 1; day <= 7; ++day )
+	{
+		const Date date( 2016, 9, day );
+		assert( store.getEntriesCount( date ) == expected.getEntriesCount( date ) );
+
+		for ( int minutes = 8 * 60; minutes <= 13 * 60; minutes += 30 )
+		{
+			const Time time( minutes / 60, minutes % 60, 0 );
+			assert( store.hasEntry( date, time ) == expected.hasEntry( date, time ) );
+
+			if ( expected.hasEntry( date, time ) )
+				assert( store.getEntry( date, time ) == expected.getEntry( date, time ) );
+			else
+				ASSERT_THROWS(
+						store.getEntry( date, time );
+					,	Messages::EntryDoesNotExist
+				);
+		}
+	}
+
+	assert( printDiary( store.getDiary() ) == printDiary( expected ) );
+
+	removeDiaryFiles( path );
+}
+
+
+/*****************************************************************************/
+
+
+DECLARE_OOP_TEST( diary_13_10_diary_on_disk_snapshot_with_keys_out_of_order )
+{
+	const std::string path = "diary_13_10.bin";
+
+	Diary d( "kukushka" );
+	d.addEntry( Date( 2016, 10, 1 ), Time( 9, 0, 0 ), "first" );
+	d.addEntry( Date( 2016, 10, 1 ), Time( 10, 0, 0 ), "second" );
+	d.addEntry( Date( 2016, 10, 2 ), Time( 9, 0, 0 ), "third" );
+
+	// After a header of 48 bytes and the owner name come 3 entry keys and
+	// 3 text ends of 8 bytes each, then 2 day keys of 4 bytes
+	const std::streamoff entryKeys = 48 + 8;
+	const std::streamoff dayKeys = entryKeys + 2 * 3 * 8;
+
+	// Days out of order, entries out of order within a day, and entries
+	// placed in another day
+	const std::streamoff swaps[][ 3 ] = {
+			{ dayKeys, dayKeys + 4, 4 }
+		,	{ entryKeys, entryKeys + 8, 8 }
+		,	{ entryKeys + 8, entryKeys + 16, 8 }
+	};
+
+	for ( auto const & swap : swaps )
+	{
+		DiaryFile::write( d, path );
+		assert( printDiary( DiaryFile( path ).load() ) == printDiary( d ) );
+
+		swapFileBytes( path, swap[ 0 ], swap[ 1 ], static_cast< int >( swap[ 2 ] ) );
+
+		const DiaryFile file( path );
+		ASSERT_THROWS(
+				file.load();
+			,	Messages::DamagedDiaryFile
+		);
+	}
+
+	removeDiaryFiles( path );
+}
+
+
 /*****************************************************************************/
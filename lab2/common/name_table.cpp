@@ -0,0 +1,92 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#include "name_table.hpp"
+
+#include <mutex>
+
+/*****************************************************************************/
+
+
+const int NameTable::FirstBlockSize;
+
+const int NameTable::MaxBlocks;
+
+
+/*****************************************************************************/
+
+
+NameTable::NameTable ()
+	:	m_namesCount( 0 )
+{
+	for ( auto & block : m_blocks )
+		block.store( nullptr, std::memory_order_relaxed );
+}
+
+
+/*****************************************************************************/
+
+
+NameTable::~NameTable ()
+{
+	for ( auto & block : m_blocks )
+		delete[] block.load( std::memory_order_relaxed );
+}
+
+
+/*****************************************************************************/
+
+
+std::shared_ptr< NameTable > const & NameTable::getDefault ()
+{
+	static const std::shared_ptr< NameTable > s_default = std::make_shared< NameTable >();
+	return s_default;
+}
+
+
+/*****************************************************************************/
+
+
+int NameTable::intern ( std::string const & _name )
+{
+	// Most names are interned already, and finding them needs no exclusive lock
+	const int id = find( _name );
+	if ( id != -1 )
+		return id;
+
+	std::lock_guard< std::shared_timed_mutex > lock( m_mutex );
+
+	const int nextId = m_namesCount.load( std::memory_order_relaxed );
+	auto result = m_ids.emplace( _name, nextId );
+	if ( ! result.second )
+		return result.first->second;
+
+	int offset;
+	const int block = getBlock( nextId, offset );
+
+	NameRef * pBlock = m_blocks[ block ].load( std::memory_order_relaxed );
+	if ( ! pBlock )
+	{
+		pBlock = new NameRef[ FirstBlockSize << block ];
+		m_blocks[ block ].store( pBlock, std::memory_order_release );
+	}
+
+	pBlock[ offset ] = & result.first->first;
+	m_namesCount.store( nextId + 1, std::memory_order_release );
+
+	return nextId;
+}
+
+
+/*****************************************************************************/
+
+
+int NameTable::find ( std::string const & _name ) const
+{
+	std::shared_lock< std::shared_timed_mutex > lock( m_mutex );
+
+	auto it = m_ids.find( _name );
+	return ( it == m_ids.end() ) ? -1 : it->second;
+}
+
+
+/*****************************************************************************/
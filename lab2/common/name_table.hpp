@@ -0,0 +1,136 @@
+// (C) 2016, Sergei Zaychenko, KNURE, Kharkiv, Ukraine
+
+#ifndef _NAME_TABLE_HPP_
+#define _NAME_TABLE_HPP_
+
+/*****************************************************************************/
+
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <shared_mutex>
+
+/*****************************************************************************/
+
+/*
+	Interns names: each distinct name is stored once and numbered in order of
+	appearance, so containers of names may keep plain integers. Numbers are
+	never reused, and numbers and names stay valid for as long as the table
+	lives.
+
+	A table may be shared by containers used from different threads. Adding a
+	new name takes the table's lock exclusively; looking up a number takes it
+	shared, so lookups never wait for each other. A name is found by its number
+	without any lock: names are referred to from blocks that never move, each
+	twice as large as the one before, and a number is handed out only after its
+	entry is filled in.
+
+	Containers take a table when constructed and share a process-wide one by
+	default. A group of containers given a table of its own does not contend
+	with other groups, and its names are freed with the last of them.
+*/
+
+class NameTable
+{
+
+/*-----------------------------------------------------------------*/
+
+public:
+
+/*-----------------------------------------------------------------*/
+
+	NameTable ();
+
+	~NameTable ();
+
+	NameTable ( NameTable const & ) = delete;
+
+	NameTable & operator = ( NameTable const & ) = delete;
+
+	static std::shared_ptr< NameTable > const & getDefault ();
+
+/*-----------------------------------------------------------------*/
+
+	// Adds the name when it is seen for the first time
+	int intern ( std::string const & _name );
+
+	// -1 when the name was never interned
+	int find ( std::string const & _name ) const;
+
+	std::string const & getName ( int _id ) const;
+
+	int getNamesCount () const;
+
+/*-----------------------------------------------------------------*/
+
+private:
+
+/*-----------------------------------------------------------------*/
+
+	typedef std::string const * NameRef;
+
+	static const int FirstBlockSize = 64;
+
+	// Enough blocks for every non-negative int
+	static const int MaxBlocks = 26;
+
+	static int getBlock ( int _id, int & _offset );
+
+/*-----------------------------------------------------------------*/
+
+	// Names live in the nodes of the map, which never move
+	std::unordered_map< std::string, int > m_ids;
+
+	// Block b refers to the names numbered from FirstBlockSize * ( 2^b - 1 )
+	std::atomic< NameRef * > m_blocks[ MaxBlocks ];
+
+	std::atomic< int > m_namesCount;
+
+	mutable std::shared_timed_mutex m_mutex;
+
+/*-----------------------------------------------------------------*/
+
+};
+
+
+/*****************************************************************************/
+
+
+inline int NameTable::getBlock ( int _id, int & _offset )
+{
+	const unsigned position = static_cast< unsigned >( _id ) + FirstBlockSize;
+
+	// The highest bit of the position over the first block size
+	int block = 0;
+	while ( ( position / FirstBlockSize ) >> ( block + 1 ) )
+		++ block;
+
+	_offset = static_cast< int >( position - ( static_cast< unsigned >( FirstBlockSize ) << block ) );
+	return block;
+}
+
+
+/*****************************************************************************/
+
+
+inline std::string const & NameTable::getName ( int _id ) const
+{
+	int offset;
+	const int block = getBlock( _id, offset );
+	return * m_blocks[ block ].load( std::memory_order_acquire )[ offset ];
+}
+
+
+/*****************************************************************************/
+
+
+inline int NameTable::getNamesCount () const
+{
+	return m_namesCount.load( std::memory_order_acquire );
+}
+
+
+/*****************************************************************************/
+
+#endif // _NAME_TABLE_HPP_